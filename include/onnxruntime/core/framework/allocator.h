@@ -30,6 +30,9 @@ struct OrtArenaCfg {
   int initial_chunk_size_bytes;         // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;         // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;  // use -1 to allow ORT to choose the default
+  size_t max_thread_cache_bytes = 0;    // per-thread cache size of freed chunks. use 0 to disable thread caching
+  int huge_pages = 0;                   // CPU arena regions: 0 = off, 1 = transparent huge pages, 2 = explicit 2 MB, 3 = explicit 1 GB
+  int lock_memory = 0;                  // CPU arena regions: 1 = mlock regions so they can't be paged out
 };
 
 namespace onnxruntime {
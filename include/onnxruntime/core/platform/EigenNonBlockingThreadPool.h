@@ -331,6 +331,8 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
                              unsigned n, std::ptrdiff_t block_size) = 0;
   virtual void StartProfiling() = 0;
   virtual std::string StopProfiling() = 0;
+  // Number of tasks waiting in the work queues.
+  virtual unsigned QueueDepth() const = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -1288,6 +1290,15 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return num_threads_;
   }
 
+  // Approximate when called while tasks are being pushed or popped.
+  unsigned QueueDepth() const final {
+    unsigned depth = 0;
+    for (size_t i = 0; i < worker_data_.size(); ++i) {
+      depth += worker_data_[i].queue.Size();
+    }
+    return depth;
+  }
+
   int CurrentThreadId() const final {
     const PerThread* pt = const_cast<ThreadPoolTempl*>(this)->GetPerThread();
     if (pt->pool == this) {
@@ -360,6 +360,10 @@ class ThreadPool {
   // working in combination with the thread initiating the loop.
   static int DegreeOfParallelism(const ThreadPool* tp);
 
+  // Returns the number of tasks waiting in the work queues of the pool, or 0 if tp is nullptr.
+  // Meant for monitoring; the value may be stale by the time it is returned.
+  static int QueueDepth(const ThreadPool* tp);
+
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
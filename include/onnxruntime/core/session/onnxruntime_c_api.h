@@ -2709,6 +2709,15 @@ struct OrtApi {
    *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "max_thread_cache_bytes": Maximum number of bytes of freed chunks each thread keeps in a cache in front of the
+   *  arena. Allocations served from the cache don't take the arena lock, which reduces contention when many
+   *  threads run concurrently. Only chunks up to 1 MB are cached. Use 0 to disable the thread caches. Default is 0.
+   * "huge_pages": Back the arena regions of a CPU arena with huge pages to reduce TLB misses on large tensors.
+   *  0 = off, 1 = transparent huge pages (madvise), 2 = explicit 2 MB pages, 3 = explicit 1 GB pages.
+   *  Explicit pages must be reserved by the OS; if none are available transparent huge pages are used instead.
+   *  Only supported on Linux and ignored elsewhere. Default is 0.
+   * "lock_memory": Set to 1 to lock the arena regions of a CPU arena in RAM (mlock) so they can't be paged out.
+   *  Only supported on Linux and ignored elsewhere. Default is 0.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -4150,6 +4159,23 @@ struct OrtApi {
    */
   ORT_API2_STATUS(GetOptionalContainedTypeInfo, _In_ const OrtOptionalTypeInfo* optional_type_info,
                   _Outptr_ OrtTypeInfo** out);
+
+  /** \brief Get a snapshot of the runtime metrics of a session
+   *
+   * The session must have been created with the "session.enable_metrics" config entry set to "1".
+   * The snapshot is in the Prometheus text exposition format and contains the run counters, the run latency
+   * histogram, the sampled per-op latency histograms, the allocator statistics and the thread pool queue depths.
+   *
+   * \param[in] session
+   * \param[in] allocator
+   * \param[out] out Null terminated string with the snapshot. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.15.
+   */
+  ORT_API2_STATUS(SessionGetMetricsSnapshot, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
 };
 
 /*
@@ -779,6 +779,13 @@ struct SessionImpl : ConstSessionImpl<T> {
    *  The OrtAllocator instances must be valid at the point of memory release.
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
+
+  /** \brief Returns a snapshot of the session metrics in the Prometheus text format.
+   *
+   * \param allocator to allocate memory for the string returned
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr GetMetricsSnapshotAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionGetMetricsSnapshot
 };
 
 }  // namespace detail
@@ -67,6 +67,13 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Specifies the largest ratio of non-zero elements in a constant float weight of a MatMul or Gemm node for the node
+// to be replaced by SparseWeightGemm, which packs the non-zero weights once and skips the zero elements of pruned
+// models. The value is a float in [0, 1]. "0" disables the optimization. The default is "0". A value of "0.1", which
+// converts weights with at least 90% zero elements, is where the sparse kernel measured faster than the dense one.
+static const char* const kOrtSessionOptionsSparseWeightDensityThreshold =
+    "optimization.sparse_weight_density_threshold";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
@@ -165,6 +172,65 @@ static const char* const kOrtSessionOptionsConfigForceSpinningStop = "session.fo
 // May be useful to expose bugs in models.
 static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "session.strict_shape_type_inference";
 
+// Maximum number of memory patterns cached per graph when memory pattern optimization is enabled.
+// A memory pattern is generated for each distinct set of input shapes. When the cache is full the least recently
+// used pattern is evicted. Default is "0", which keeps every pattern (unbounded cache).
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Shape buckets for memory pattern caching of models with dynamic input dimensions.
+// The value is a ","-delimited list of ascending dimension boundaries, e.g. "64,128,256,512".
+// Each input dimension is rounded up to the nearest boundary when looking up the memory pattern cache, so all input
+// shapes that fall in the same bucket share one pattern. A tensor is placed in its planned block if it fits,
+// otherwise it falls back to the allocator. Running once with the upper bound of each bucket after session creation
+// precomputes patterns that every shape in the bucket fits in. Dimensions larger than the last boundary are matched
+// exactly. Default is "" (no buckets; patterns are keyed by exact input shapes).
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBuckets = "session.memory_pattern_shape_buckets";
+
+// Enable always-on runtime metrics for the session: histograms of Run latency and per op type kernel latency,
+// plus arena usage and thread pool queue depth at the time of the snapshot. Unlike profiling, nothing is buffered;
+// the metrics are fixed size counters that can be read at any time with SessionGetMetricsSnapshot.
+// Default is "0" (disabled). Set to "1" to enable.
+static const char* const kOrtSessionOptionsConfigEnableMetrics = "session.enable_metrics";
+
+// When metrics are enabled, kernel latencies are recorded for one out of this many graph executions.
+// Run latencies are always recorded. "1" records every execution, "0" disables kernel latencies. Default is "100".
+static const char* const kOrtSessionOptionsConfigMetricsOpSamplingInterval = "session.metrics_op_sampling_interval";
+
+// Execute graphs with fixed input shapes as a flat list of kernel calls.
+// The first Run with a set of input shapes uses the regular executor and generates the memory pattern for them, every
+// later Run with the same shapes reuses the execution frame, the memory pattern block and the kernel contexts and only
+// rebinds the inputs and outputs. Only graphs with a single stream of CPU nodes and no control flow nodes qualify.
+// Runs with profiling enabled, concurrent Runs and Runs with other input shapes use the regular executor. If a
+// kernel fails in a compiled Run, e.g. because an intermediate shape depends on the input values, compiled execution
+// is turned off for the session and the Run is repeated with the regular executor.
+// Default is "0" (disabled). Set to "1" to enable.
+static const char* const kOrtSessionOptionsConfigEnableCompiledExecution = "session.enable_compiled_execution";
+
+// Capture and replay Runs on the CPU, similar to CUDA graphs. Implies session.enable_compiled_execution.
+// A compiled Run whose outputs are preallocated, e.g. bound with IOBinding, is captured: all the values of the graph
+// stay at the addresses they had. A later Run with the same input and output buffers replays the kernel calls
+// without binding or allocating anything. The inputs are updated in place between Runs. The captured Run keeps the
+// input and output buffers alive until a Run with other buffers or input shapes ends the capture.
+// Default is "0" (disabled). Set to "1" to enable.
+static const char* const kOrtSessionOptionsConfigEnableCpuRunCapture = "session.enable_cpu_run_capture";
+
+// Share constant weights with the other sessions in the process that enable this option.
+// Weights are matched by type, shape and content, so a second session for the same model, or for a model that shares
+// some of its weights (e.g. a fine-tuned head on the same backbone), reuses the weights loaded by the first one.
+// Pre-packed weights are shared as well, unless a PrepackedWeightsContainer is provided for the session.
+// Only numeric CPU initializers stored in the model are shared; external data is memory mapped instead.
+// Shared weights are released when the last session using them is released.
+// Default is "0" (disabled). Set to "1" to enable.
+static const char* const kOrtSessionOptionsConfigShareWeightsAcrossSessions = "session.share_weights_across_sessions";
+
+// Load the data of large initializers lazily, on first access, instead of at session initialization.
+// CPU initializers with external data are memory mapped with a random access hint, so only the pages that are read
+// are loaded, e.g. the rows of an embedding table touched by a Gather. An ORT format model loaded from a file is
+// memory mapped instead of read, and its initializers use the mapped bytes directly.
+// Initializers that are pre-packed or copied to another device are still read during initialization.
+// Default is "0" (disabled). Set to "1" to enable.
+static const char* const kOrtSessionOptionsConfigLazyLoadInitializers = "session.lazy_load_initializers";
+
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
@@ -5,12 +5,13 @@
 
 namespace onnxruntime {
 
-common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation) {
+common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation,
+                                      const std::string& attr_prefix) {
   // Convert the activation parameters from the node into a MLAS_ACTIVATION.
   activation.ActivationKind = MlasIdentityActivation;
 
   std::string activation_type;
-  if (info.GetAttr<std::string>("activation", &activation_type).IsOK()) {
+  if (info.GetAttr<std::string>(attr_prefix + "activation", &activation_type).IsOK()) {
     if (activation_type == "Relu") {
       activation.ActivationKind = MlasReluActivation;
     } else if (activation_type == "Tanh") {
@@ -34,7 +35,7 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       }
 
       std::vector<float> activation_params;
-      common::Status status = info.GetAttrs<float>("activation_params", activation_params);
+      common::Status status = info.GetAttrs<float>(attr_prefix + "activation_params", activation_params);
       if (!status.IsOK()) {
         return status;
       } else if (activation_params_count != activation_params.size()) {
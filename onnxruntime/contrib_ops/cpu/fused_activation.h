@@ -9,6 +9,9 @@
 
 namespace onnxruntime {
 
-common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation);
+// Reads the "activation" and "activation_params" attributes, optionally with the
+// given prefix applied to the attribute names.
+common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation,
+                                      const std::string& attr_prefix = {});
 
 }  // namespace onnxruntime
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/gemm_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gemm with a constant, highly sparse B. B is packed in compressed sparse column form at session
+// initialization so that the multiplication skips the zero elements. If B could not be prepacked
+// (e.g. it is not a constant initializer), the dense SGEMM is used instead.
+class SparseWeightGemm final : public OpKernel {
+ public:
+  explicit SparseWeightGemm(const OpKernelInfo& info) : OpKernel(info) {
+    trans_b_ = info.GetAttrOrDefault<int64_t>("transB", 0) != 0;
+    alpha_ = info.GetAttrOrDefault<float>("alpha", 1.0f);
+    beta_ = info.GetAttrOrDefault<float>("beta", 1.0f);
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  bool trans_b_;
+  float alpha_;
+  float beta_;
+
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    SparseWeightGemm,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    SparseWeightGemm);
+
+Status SparseWeightGemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                 /*out*/ bool& is_packed,
+                                 /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack Matrix B
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  const auto& b_shape = tensor.Shape();
+  const size_t K = trans_b_ ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b_ ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+  const float* b_data = tensor.Data<float>();
+  const size_t ldb = trans_b_ ? K : N;
+  const CBLAS_TRANSPOSE trans_b = trans_b_ ? CblasTrans : CblasNoTrans;
+
+  const size_t packed_b_size = MlasSparseGemmPackBSize(trans_b, N, K, b_data, ldb);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  memset(packed_b_data, 0, packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(std::move(alloc)));
+  MlasSparseGemmPackB(trans_b, N, K, b_data, ldb, packed_b_data);
+
+  b_shape_ = b_shape;
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  return Status::OK();
+}
+
+Status SparseWeightGemm::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                   int input_idx,
+                                                   /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status SparseWeightGemm::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const auto* A = context->Input<Tensor>(0);
+  const auto* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const auto* C = context->Input<Tensor>(2);
+
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B ? B->Shape() : b_shape_;
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1, "SparseWeightGemm: A must have rank 1 or higher");
+  ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2, "SparseWeightGemm: B must have rank 2");
+
+  // The leading dimensions of A are flattened into the rows of the multiplication.
+  const size_t a_rank = a_shape.NumDimensions();
+  const int64_t M = a_shape.SizeToDimension(a_rank - 1);
+  const int64_t K = a_shape[a_rank - 1];
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(TensorShape({M, K}), false, b_shape, trans_b_, C != nullptr ? C->Shape() : TensorShape({}));
+  ORT_RETURN_IF_ERROR(helper.State());
+
+  const int64_t N = helper.N();
+
+  TensorShapeVector y_dims(a_shape.GetDims().begin(), a_shape.GetDims().end());
+  y_dims.back() = N;
+  Tensor* Y = context->Output(0, TensorShape(y_dims));
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  float* y_data = Y->MutableData<float>();
+
+  const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
+  const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
+  const float beta = c_data != nullptr ? beta_ : 0.0f;
+
+  GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
+
+  if (packed_b_) {
+    MlasSparseGemm(CblasNoTrans,
+                   narrow<size_t>(M), narrow<size_t>(N), narrow<size_t>(K),
+                   alpha_,
+                   A->Data<float>(), narrow<size_t>(K),
+                   packed_b_.get(),
+                   beta,
+                   y_data, narrow<size_t>(N),
+                   thread_pool);
+  } else {
+    MlasGemm(CblasNoTrans, trans_b_ ? CblasTrans : CblasNoTrans,
+             narrow<size_t>(M), narrow<size_t>(N), narrow<size_t>(K),
+             alpha_,
+             A->Data<float>(), narrow<size_t>(K),
+             B->Data<float>(), narrow<size_t>(trans_b_ ? K : N),
+             beta,
+             y_data, narrow<size_t>(N),
+             thread_pool);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
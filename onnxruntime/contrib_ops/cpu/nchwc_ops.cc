@@ -221,6 +221,93 @@ Status NchwcConv::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status NchwcSeparableConv::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  const auto* W_pointwise = context->Input<Tensor>(3);
+  const auto* B_pointwise = context->Input<Tensor>(4);
+  const auto* Sum = context->Input<Tensor>(5);
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+
+  const auto& X_shape = X->Shape();
+  const auto& W_shape = W->Shape();
+  const auto& W_pointwise_shape = W_pointwise->Shape();
+  ORT_ENFORCE(X_shape.NumDimensions() == 4);
+
+  const size_t nchwc_block_size = MlasNchwcGetBlockSize();
+  ORT_ENFORCE((X_shape[1] % nchwc_block_size) == 0);
+
+  // The depthwise stage must produce one output channel per input channel and
+  // the pointwise stage must be a 1x1 convolution over those channels.
+  ORT_RETURN_IF_NOT(conv_attrs_.group == X_shape[1] && W_shape[0] == X_shape[1],
+                    "depthwise convolution expected");
+  ORT_RETURN_IF_NOT(W_pointwise_shape.NumDimensions() == 4 && W_pointwise_shape[1] == X_shape[1] &&
+                        W_pointwise_shape[2] == 1 && W_pointwise_shape[3] == 1,
+                    "pointwise filter shape mismatch");
+  ORT_ENFORCE((W_pointwise_shape[0] % nchwc_block_size) == 0);
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  if (kernel_shape.size() != 2) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Unsupported convolution size.");
+  }
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  // The spatial dimensions are those of the depthwise stage and the channel
+  // count is that of the pointwise stage.
+  TensorShapeVector Y_dims;
+  Y_dims.insert(Y_dims.begin(), {X_shape[0], W_pointwise_shape[0]});
+  TensorShape input_shape = X->Shape().Slice(2);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  auto* Y = context->Output(0, Y_dims);
+  auto* y_data = Y->MutableData<float>();
+
+  // Check for the optional SeparableConv/Sum fusion.
+  if (Sum != nullptr) {
+    const auto& sum_shape = Sum->Shape();
+    ORT_RETURN_IF_NOT(Y->Shape() == sum_shape, "output and sum shape must match");
+    // If the output was not allocated inplace with the sum tensor, then copy here.
+    const auto* sum_data = Sum->Data<float>();
+    if (y_data != sum_data) {
+      memcpy(y_data, sum_data, SafeInt<size_t>(sum_shape.Size()) * sizeof(float));
+    }
+  }
+
+  MlasNchwcConvDepthwisePointwise(
+      X_shape.GetDims().data(),
+      kernel_shape.data(),
+      dilations.data(),
+      pads.data(),
+      strides.data(),
+      Y_dims.data(),
+      X->Data<float>(),
+      W->Data<float>(),
+      B != nullptr ? B->Data<float>() : nullptr,
+      &activation_,
+      W_pointwise->Data<float>(),
+      B_pointwise != nullptr ? B_pointwise->Data<float>() : nullptr,
+      y_data,
+      &pointwise_activation_,
+      Sum == nullptr,
+      context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
 Status NchwcPoolBase::NchwcPool(OpKernelContext* context, MLAS_POOLING_KIND kind) const {
   const auto* X = context->Input<Tensor>(0);
   const auto& X_shape = X->Shape();
@@ -405,6 +492,15 @@ ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     NchwcConv);
 
+ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
+    SeparableConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .MayInplace(5, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NchwcSeparableConv);
+
 ONNX_CPU_OPERATOR_TYPED_NCHWC_KERNEL(
     MaxPool,
     1,
@@ -53,6 +53,22 @@ class NchwcConv final : public OpKernel {
   MLAS_ACTIVATION activation_;
 };
 
+class NchwcSeparableConv final : public OpKernel {
+ public:
+  NchwcSeparableConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+    ORT_ENFORCE(GetFusedActivationAttr(info, pointwise_activation_, "pointwise_").IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  ConvAttributes conv_attrs_;
+
+  MLAS_ACTIVATION activation_;
+  MLAS_ACTIVATION pointwise_activation_;
+};
+
 class NchwcPoolBase : public PoolBase {
  public:
   NchwcPoolBase(const OpKernelInfo& info) : PoolBase(info) {
@@ -36,6 +36,8 @@ class QAttention : public OpKernel, public AttentionCPUBase {
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  // packed_weights_ also holds the zero point corrections of the weights
+  bool weights_is_folded_{false};
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -83,8 +85,25 @@ Status QAttention<T>::PrePack(const Tensor& weights, int input_idx, AllocatorPtr
   const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
   weights_is_signed_ = weights.IsDataType<int8_t>();
 
-  packed_weights_size_ = MlasGemmPackBSize(head_size, input_hidden_size, false /*AIsSigned*/, weights_is_signed_);
+  // Fold a constant weight zero point, per tensor or per column, into the packed
+  // weights of each head so that the corrections are not recomputed on every run.
+  const auto& input_defs = Node().InputDefs();
+  const Tensor* w_zp_tensor = nullptr;
+  const Tensor* i_zp_tensor = nullptr;
+  const bool has_w_zp = input_defs.size() > 7 && input_defs[7]->Exists();
+  const bool has_i_zp = input_defs.size() > 6 && input_defs[6]->Exists();
+  weights_is_folded_ = (!has_w_zp || Info().TryGetConstantInput(7, &w_zp_tensor)) &&
+                       (w_zp_tensor == nullptr || w_zp_tensor->Shape().Size() == 1 ||
+                        w_zp_tensor->Shape().Size() == static_cast<int64_t>(hidden_size_x3));
+  if (has_i_zp && (!Info().TryGetConstantInput(6, &i_zp_tensor) || i_zp_tensor->Shape().Size() != 1)) {
+    i_zp_tensor = nullptr;
+  }
+
+  packed_weights_size_ =
+      weights_is_folded_ ? MlasGemmPackBFoldedSize(head_size, input_hidden_size, false /*AIsSigned*/, weights_is_signed_)
+                         : MlasGemmPackBSize(head_size, input_hidden_size, false /*AIsSigned*/, weights_is_signed_);
   if (packed_weights_size_ == 0) {
+    weights_is_folded_ = false;
     return Status::OK();
   }
 
@@ -99,8 +118,20 @@ Status QAttention<T>::PrePack(const Tensor& weights, int input_idx, AllocatorPtr
 
   packed_weights_ = BufferUniquePtr(packed_weights_data, BufferDeleter(std::move(alloc)));
 
+  const uint8_t weight_zp_default = 0;
+  const uint8_t* weight_zp_data = w_zp_tensor != nullptr ? static_cast<const uint8_t*>(w_zp_tensor->DataRaw())
+                                                         : &weight_zp_default;
+  const bool is_weight_zp_per_column = w_zp_tensor != nullptr && w_zp_tensor->Shape().Size() != 1;
+  const uint8_t* input_zp_data = i_zp_tensor != nullptr ? i_zp_tensor->Data<uint8_t>() : nullptr;
+
   for (size_t i = 0; i < loop_len; i++) {
-    MlasGemmPackB(head_size, input_hidden_size, weights_data, hidden_size_x3, false /*AIsSigned*/, weights_is_signed_, packed_weights_data);
+    if (weights_is_folded_) {
+      MlasGemmPackBFolded(head_size, input_hidden_size, weights_data, hidden_size_x3, false /*AIsSigned*/,
+                          weights_is_signed_, weight_zp_data + (is_weight_zp_per_column ? i * head_size : 0),
+                          is_weight_zp_per_column, input_zp_data, nullptr, packed_weights_data);
+    } else {
+      MlasGemmPackB(head_size, input_hidden_size, weights_data, hidden_size_x3, false /*AIsSigned*/, weights_is_signed_, packed_weights_data);
+    }
     packed_weights_data += packed_weights_size_;
     weights_data += head_size;
   }
@@ -273,6 +304,7 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
             static_cast<const uint8_t*>(packed_weights_.get()) + packed_weights_size_ * (weights_offset / head_size);
         gemm_params.B = packed_weight;
         gemm_params.BIsPacked = true;
+        gemm_params.BIsFolded = weights_is_folded_;
       } else {
         gemm_params.B = weights_data + weights_offset;
         gemm_params.ldb = static_cast<int64_t>(3) * hidden_size;
@@ -25,7 +25,7 @@ class DynamicQuantizeLSTM : public OpKernel, public LSTMBase {
   ~DynamicQuantizeLSTM() override = default;
 
  private:
-  Status TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed,
+  Status TryPackWeights(const Tensor& weights, int zero_point_idx, PackedWeights& packed_weights, bool& is_packed,
                         bool& is_weight_signed, AllocatorPtr& alloc);
 
   template <typename T>
@@ -37,7 +37,7 @@ class DynamicQuantizeLSTM : public OpKernel, public LSTMBase {
   bool is_R_signed_;
 };
 
-Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights,
+Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, int zero_point_idx, PackedWeights& packed_weights,
                                            bool& is_packed, bool& is_weight_signed, AllocatorPtr& alloc) {
   const auto& shape = weights.Shape();
   if (shape.NumDimensions() != 3) {
@@ -54,8 +54,20 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
   }
 
   is_weight_signed = weights.IsDataType<int8_t>();
-  const size_t packed_weights_size = MlasGemmPackBSize(N, K, false /*AIsSigned*/, is_weight_signed);
+
+  // Fold a constant zero point, per direction or per channel, into the packed
+  // weights so that the corrections are not recomputed for every time step.
+  const Tensor* zero_point = nullptr;
+  packed_weights.is_folded_ =
+      Info().TryGetConstantInput(zero_point_idx, &zero_point) &&
+      (zero_point->Shape().Size() == num_directions_ ||
+       zero_point->Shape().Size() == static_cast<int64_t>(num_directions_) * static_cast<int64_t>(N));
+
+  const size_t packed_weights_size =
+      packed_weights.is_folded_ ? MlasGemmPackBFoldedSize(N, K, false /*AIsSigned*/, is_weight_signed)
+                                : MlasGemmPackBSize(N, K, false /*AIsSigned*/, is_weight_signed);
   if (packed_weights_size == 0) {
+    packed_weights.is_folded_ = false;
     return Status::OK();
   }
 
@@ -73,8 +85,16 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
   packed_weights.shape_ = shape;
 
   const auto* weights_data = static_cast<const uint8_t*>(weights.DataRaw());
+  const bool is_zero_point_per_column = packed_weights.is_folded_ && zero_point->Shape().Size() != num_directions_;
   for (int i = 0; i < num_directions_; i++) {
-    MlasGemmPackB(N, K, weights_data, N, false /*AIsSigned*/, is_weight_signed, packed_weights_data);
+    if (packed_weights.is_folded_) {
+      const auto* zero_point_data = static_cast<const uint8_t*>(zero_point->DataRaw()) +
+                                    (is_zero_point_per_column ? N * i : static_cast<size_t>(i));
+      MlasGemmPackBFolded(N, K, weights_data, N, false /*AIsSigned*/, is_weight_signed,
+                          zero_point_data, is_zero_point_per_column, nullptr, nullptr, packed_weights_data);
+    } else {
+      MlasGemmPackB(N, K, weights_data, N, false /*AIsSigned*/, is_weight_signed, packed_weights_data);
+    }
     packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
     weights_data += N * K;
   }
@@ -94,7 +114,7 @@ Status DynamicQuantizeLSTM::PrePack(const Tensor& tensor, int input_idx, Allocat
   is_packed = false;
 
   if (input_idx == 1) {
-    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_W_, is_packed, is_W_signed_, alloc));
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 9, packed_W_, is_packed, is_W_signed_, alloc));
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
@@ -102,7 +122,7 @@ Status DynamicQuantizeLSTM::PrePack(const Tensor& tensor, int input_idx, Allocat
       prepacked_weights->buffer_sizes_.push_back(packed_W_.buffer_size_);
     }
   } else if (input_idx == 2) {
-    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_R_, is_packed, is_R_signed_, alloc));
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 11, packed_R_, is_packed, is_R_signed_, alloc));
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
@@ -139,26 +159,6 @@ Status DynamicQuantizeLSTM::UseSharedPrePackedBuffers(std::vector<BufferUniquePt
                            num_directions_, ", 4*", hidden_size_, "} for per-channel quantization. Actual:", weight_shape);                 \
   }
 
-#define ZeroPointCheck(w_zp, zp_shape, is_W_signed, weight_name)                                                                           \
-  if (zp_shape.NumDimensions() == 2) {                                                                                                     \
-    const int64_t zp_size = zp_shape.Size();                                                                                               \
-    const uint8_t* w_zp_data = static_cast<const uint8_t*>(w_zp->DataRaw());                                                               \
-    if (is_W_signed) {                                                                                                                     \
-      for (int64_t i = 0; i < zp_size; i++) {                                                                                              \
-        if (w_zp_data[i] != 0) {                                                                                                           \
-          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeLSTM : ", #weight_name, "Weight zero point must be zero"); \
-        }                                                                                                                                  \
-      }                                                                                                                                    \
-    } else {                                                                                                                               \
-      const uint8_t W_zero_point_value = w_zp_data[0];                                                                                     \
-      for (int64_t i = 1; i < zp_size; i++) {                                                                                              \
-        if (w_zp_data[i] != W_zero_point_value) {                                                                                          \
-          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "DynamicQuantizeLSTM : ", #weight_name, "Weight point must be constant");  \
-        }                                                                                                                                  \
-      }                                                                                                                                    \
-    }                                                                                                                                      \
-  }
-
 Status DynamicQuantizeLSTM::Compute(OpKernelContext* context) const {
   // weights. [num_directions, input_size, 4*hidden_size]
   const Tensor* W = packed_W_.buffer_ ? nullptr : context->Input<Tensor>(1);
@@ -174,32 +174,33 @@ Status DynamicQuantizeLSTM::Compute(OpKernelContext* context) const {
   const Tensor* r_zp = context->Input<Tensor>(11);
 
   const TensorShape& W_zp_shape = w_zp->Shape();
-  const TensorShape& R_zp_shape = w_zp->Shape();
+  const TensorShape& R_zp_shape = r_zp->Shape();
   const TensorShape& W_scale_shape = w_scale->Shape();
   const TensorShape& R_scale_shape = r_scale->Shape();
 
   WeightCheck(W_zp_shape, W_zero_point);
   WeightCheck(R_zp_shape, R_zero_point);
   WeightCheck(W_scale_shape, W_scale);
-  WeightCheck(W_scale_shape, R_scale);
+  WeightCheck(R_scale_shape, R_scale);
 
   const bool is_W_signed = (W != nullptr) ? W->IsDataType<int8_t>() : is_W_signed_;
   const bool is_R_signed = (R != nullptr) ? R->IsDataType<int8_t>() : is_R_signed_;
 
-  ZeroPointCheck(w_zp, W_zp_shape, is_W_signed, Input);
-  ZeroPointCheck(r_zp, R_zp_shape, is_R_signed, Recurrent);
-
   size_t W_scale_size = W_scale_shape.NumDimensions() == 2 ? narrow<size_t>(W_scale_shape[1]) : 1;
   size_t R_scale_size = R_scale_shape.NumDimensions() == 2 ? narrow<size_t>(R_scale_shape[1]) : 1;
+  size_t W_zp_size = W_zp_shape.NumDimensions() == 2 ? narrow<size_t>(W_zp_shape[1]) : 1;
+  size_t R_zp_size = R_zp_shape.NumDimensions() == 2 ? narrow<size_t>(R_zp_shape[1]) : 1;
 
   QuantizationParameter quant_para_W_1(w_scale->Data<float>(),
                                        static_cast<const uint8_t*>(w_zp->DataRaw()),
                                        is_W_signed,
-                                       W_scale_size);
+                                       W_scale_size,
+                                       W_zp_size > 1);
   QuantizationParameter quant_para_R_1(r_scale->Data<float>(),
                                        static_cast<const uint8_t*>(r_zp->DataRaw()),
                                        is_R_signed,
-                                       R_scale_size);
+                                       R_scale_size,
+                                       R_zp_size > 1);
 
   const uint8_t* W_data = W != nullptr ? static_cast<const uint8_t*>(W->DataRaw()) : nullptr;
   const uint8_t* R_data = R != nullptr ? static_cast<const uint8_t*>(R->DataRaw()) : nullptr;
@@ -221,8 +222,8 @@ Status DynamicQuantizeLSTM::Compute(OpKernelContext* context) const {
     quant_para_W_2.scale += W_scale_size;
     quant_para_R_2.scale += R_scale_size;
 
-    quant_para_W_2.zero_point += W_scale_size;  // zero_point and scale have same size
-    quant_para_R_2.zero_point += R_scale_size;  // zero_point and scale have same size
+    quant_para_W_2.zero_point += W_zp_size;
+    quant_para_R_2.zero_point += R_zp_size;
 
     W_2.Init(1, W_data, W_size_per_direction, packed_W_, &quant_para_W_2);
     R_2.Init(1, R_data, R_size_per_direction, packed_R_, &quant_para_R_2);
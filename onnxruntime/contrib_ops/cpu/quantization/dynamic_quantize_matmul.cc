@@ -142,6 +142,7 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
     params.BIsPacked = bool(packed_b_);
+    params.BIsFolded = b_is_folded_;
     params.B = b_tensor ? static_cast<const uint8_t*>(b_tensor->DataRaw()) + helper.RightOffsets()[gemm_idx] : packed_b_.get();
     params.ldb = gemm_shape.N;
     params.ZeroPointB = b_zp_ptr + helper.RightZeroPointOffsets()[gemm_idx];
@@ -171,6 +172,7 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+  int GetBZeroPointIdx() const override { return IN_B_ZERO_POINT; }
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -191,6 +193,8 @@ class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+  int GetAZeroPointIdx() const override { return IN_A_ZERO_POINT; }
+  int GetBZeroPointIdx() const override { return IN_B_ZERO_POINT; }
 
  private:
   // a scale and b scale may be switched in fusion stage because of lack of shape information.
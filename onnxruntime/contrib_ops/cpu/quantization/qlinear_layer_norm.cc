@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+/**
+ * @brief LayerNormalization of a quantized tensor with quantized output.
+ *
+ * Rows are dequantized, normalized and requantized inside MLAS one row at a
+ * time, so a DQ -> LayerNormalization -> Q group never materializes the full
+ * precision activations.
+ */
+template <typename T>
+class QLinearLayerNorm final : public OpKernel {
+ public:
+  QLinearLayerNorm(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttr("axis", &axis_).IsOK());
+    ORT_ENFORCE(info.GetAttr<float>("epsilon", &epsilon_).IsOK());
+    // the row statistics are computed in float by MLAS
+    const int64_t stash_type = info.GetAttrOrDefault<int64_t>("stash_type", ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    ORT_ENFORCE(stash_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT,
+                "QLinearLayerNormalization only supports a float stash_type. Got ", stash_type);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  float epsilon_;
+};
+
+template <typename T>
+Status QLinearLayerNorm<T>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* tensor_x_scale = context->Input<Tensor>(1);
+  const Tensor* tensor_x_zero_point = context->Input<Tensor>(2);
+  const Tensor* scale = context->Input<Tensor>(3);
+  const Tensor* bias = context->Input<Tensor>(4);
+  const Tensor* tensor_y_scale = context->Input<Tensor>(5);
+  const Tensor* tensor_y_zero_point = context->Input<Tensor>(6);
+
+  ORT_ENFORCE(IsScalarOr1ElementVector(tensor_x_scale),
+              "Input x_scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(tensor_x_zero_point == nullptr || IsScalarOr1ElementVector(tensor_x_zero_point),
+              "input x_zero_point must be a scalar or 1D tensor of size 1 if given");
+  ORT_ENFORCE(IsScalarOr1ElementVector(tensor_y_scale),
+              "input y_scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(tensor_y_zero_point == nullptr || IsScalarOr1ElementVector(tensor_y_zero_point),
+              "input y_zero_point must be a scalar or 1D tensor of size 1 if given");
+
+  const TensorShape& x_shape = X->Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
+  const int64_t norm_count = x_shape.SizeToDimension(narrow<size_t>(axis));
+  const int64_t norm_size = x_shape.SizeFromDimension(narrow<size_t>(axis));
+
+  const int64_t scale_size = scale->Shape().Size();
+  const int64_t bias_size = bias != nullptr ? bias->Shape().Size() : 0;
+  if (scale_size != norm_size || (bias != nullptr && bias_size != norm_size)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Size of X.shape()[axis:] == ", norm_size,
+                           ". Size of scale and bias (if provided) must match this. Got scale size of ",
+                           scale_size, " and bias size of ", bias_size);
+  }
+
+  Tensor* Y = context->Output(0, x_shape);
+
+  const T x_zero_point = tensor_x_zero_point != nullptr ? *(tensor_x_zero_point->Data<T>()) : T(0);
+  const T y_zero_point = tensor_y_zero_point != nullptr ? *(tensor_y_zero_point->Data<T>()) : T(0);
+
+  MLAS_LAYERNORM_PARAMS params;
+  params.Gamma = scale->Data<float>();
+  params.Beta = bias != nullptr ? bias->Data<float>() : nullptr;
+  params.Epsilon = epsilon_;
+
+  MlasQLinearLayerNormalization(X->Data<T>(), *(tensor_x_scale->Data<float>()), x_zero_point,
+                                Y->MutableData<T>(), narrow<size_t>(norm_count), narrow<size_t>(norm_size),
+                                params, *(tensor_y_scale->Data<float>()), y_zero_point,
+                                context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)                     \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                            \
+      QLinearLayerNormalization, 1, data_type,                                  \
+      KernelDefBuilder()                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),       \
+      QLinearLayerNorm<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -80,11 +80,13 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
       gemm_output_data = static_cast<int32_t*>(y->MutableDataRaw());
     }
 
-    if (c != nullptr) {
+    // A constant bias may have been folded into the packed weights.
+    const bool accumulate_bias = c != nullptr && !(packed_b_ && bias_is_folded_);
+    if (accumulate_bias) {
       GemmBroadcastBias(M, N, 1.f, c->Data<int32_t>(), &(c->Shape()), gemm_output_data);
     }
 
-    MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape{M, N, K, a_is_signed, b_is_signed, c != nullptr};
+    MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape{M, N, K, a_is_signed, b_is_signed, accumulate_bias};
     MLAS_GEMM_QUANT_DATA_PARAMS gemm_param;
 
     gemm_param.A = a_data;
@@ -94,6 +96,7 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
     gemm_param.B = b_data;
     gemm_param.ldb = gemm_shape.N;
     gemm_param.BIsPacked = bool(packed_b_);
+    gemm_param.BIsFolded = b_is_folded_;
     gemm_param.ZeroPointB = static_cast<const uint8_t*>(b_zp->DataRaw());
 
     gemm_param.C = gemm_output_data;
@@ -115,6 +118,18 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
     return IN_B;
   }
 
+  int GetAZeroPointIdx() const override {
+    return IN_A_ZERO_POINT;
+  }
+
+  int GetBZeroPointIdx() const override {
+    return IN_B_ZERO_POINT;
+  }
+
+  int GetBiasIdx() const override {
+    return IN_C;
+  }
+
   virtual bool IsBTransposed() const override {
     return trans_B_ == CblasTrans;
   }
@@ -0,0 +1,226 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gathers rows of an embedding table and reduces each bag of rows to a single row. The rows of a bag are passed
+// to MLAS by address, so the gathered rows are never materialized. Quantized rows are dequantized on the fly by
+// folding the row scale, zero point, per sample weight and mean divisor into a per row scale and bias.
+template <typename T>
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const auto mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean" || mode == "max", "EmbeddingBag: invalid mode ", mode);
+    mlas_mode_ = mode == "max" ? MlasEmbeddingBagMax : MlasEmbeddingBagSum;
+    compute_mean_ = mode == "mean";
+    use_lengths_ = info.GetAttrOrDefault<int64_t>("use_lengths", 0) != 0;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  MLAS_EMBEDDING_BAG_MODE mlas_mode_;
+  bool compute_mean_;
+  bool use_lengths_;
+};
+
+#define REGISTER_EMBEDDING_BAG_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                \
+      EmbeddingBag,                                                             \
+      kMSDomain,                                                                \
+      1,                                                                        \
+      T,                                                                        \
+      kCpuExecutionProvider,                                                    \
+      KernelDefBuilder()                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                \
+          .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),      \
+                                   DataTypeImpl::GetTensorType<int64_t>()}),    \
+      EmbeddingBag<T>);
+
+REGISTER_EMBEDDING_BAG_KERNEL_TYPED(float)
+REGISTER_EMBEDDING_BAG_KERNEL_TYPED(MLFloat16)
+REGISTER_EMBEDDING_BAG_KERNEL_TYPED(int8_t)
+REGISTER_EMBEDDING_BAG_KERNEL_TYPED(uint8_t)
+
+template <typename T>
+Status EmbeddingBag<T>::Compute(OpKernelContext* context) const {
+  const auto* indices = context->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename T>
+template <typename Tind>
+Status EmbeddingBag<T>::ComputeImpl(OpKernelContext* context) const {
+  const auto* table = context->Input<Tensor>(0);
+  const auto* indices = context->Input<Tensor>(1);
+  const auto* offsets = context->Input<Tensor>(2);
+  const auto* per_sample_weights = context->Input<Tensor>(3);
+  const auto* table_scale = context->Input<Tensor>(4);
+  const auto* table_zero_point = context->Input<Tensor>(5);
+
+  const auto& table_shape = table->Shape();
+  const auto& indices_shape = indices->Shape();
+  ORT_RETURN_IF_NOT(table_shape.NumDimensions() == 2, "EmbeddingBag: table must have rank 2");
+
+  const int64_t num_embeddings = table_shape[0];
+  const size_t embedding_dim = narrow<size_t>(table_shape[1]);
+  const size_t index_count = narrow<size_t>(indices_shape.Size());
+  const Tind* indices_data = indices->Data<Tind>();
+
+  // Compute the start of each bag in the indices, with the end of the last bag appended.
+  size_t num_bags;
+  InlinedVector<size_t> bag_starts;
+  if (offsets == nullptr) {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 2,
+                      "EmbeddingBag: indices must have rank 2 when offsets is not provided");
+    num_bags = narrow<size_t>(indices_shape[0]);
+    const size_t bag_size = narrow<size_t>(indices_shape[1]);
+    bag_starts.resize(num_bags + 1);
+    for (size_t b = 0; b <= num_bags; b++) {
+      bag_starts[b] = b * bag_size;
+    }
+  } else {
+    ORT_RETURN_IF_NOT(indices_shape.NumDimensions() == 1 && offsets->Shape().NumDimensions() == 1,
+                      "EmbeddingBag: indices and offsets must have rank 1");
+    num_bags = narrow<size_t>(offsets->Shape()[0]);
+    const Tind* offsets_data = offsets->Data<Tind>();
+    bag_starts.resize(num_bags + 1);
+    if (use_lengths_) {
+      size_t start = 0;
+      for (size_t b = 0; b < num_bags; b++) {
+        ORT_RETURN_IF_NOT(offsets_data[b] >= 0, "EmbeddingBag: lengths must be non-negative");
+        bag_starts[b] = start;
+        start += static_cast<size_t>(offsets_data[b]);
+        ORT_RETURN_IF_NOT(start <= index_count, "EmbeddingBag: lengths exceed the number of indices");
+      }
+      bag_starts[num_bags] = start;
+    } else {
+      for (size_t b = 0; b < num_bags; b++) {
+        ORT_RETURN_IF_NOT(offsets_data[b] >= 0 && static_cast<size_t>(offsets_data[b]) <= index_count &&
+                              (b == 0 || offsets_data[b] >= offsets_data[b - 1]),
+                          "EmbeddingBag: offsets must be non-decreasing and within the number of indices");
+        bag_starts[b] = static_cast<size_t>(offsets_data[b]);
+      }
+      bag_starts[num_bags] = index_count;
+    }
+  }
+
+  // Check the indices first in case there's a out of bound index.
+  for (size_t i = 0; i < index_count; i++) {
+    const Tind idx = indices_data[i];
+    if (idx < -num_embeddings || idx >= num_embeddings) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_embeddings, ",", num_embeddings - 1, "]");
+    }
+  }
+
+  const float* weights_data = nullptr;
+  if (per_sample_weights != nullptr) {
+    ORT_RETURN_IF_NOT(mlas_mode_ != MlasEmbeddingBagMax,
+                      "EmbeddingBag: per_sample_weights is not supported with mode 'max'");
+    ORT_RETURN_IF_NOT(per_sample_weights->Shape() == indices_shape,
+                      "EmbeddingBag: per_sample_weights must have the same shape as indices");
+    weights_data = per_sample_weights->Data<float>();
+  }
+
+  // A scalar scale or zero point applies to every row of the table.
+  const float* scale_data = nullptr;
+  const T* zero_point_data = nullptr;
+  bool per_row_quantization = false;
+  if (table_scale != nullptr) {
+    const int64_t scale_size = table_scale->Shape().Size();
+    ORT_RETURN_IF_NOT(scale_size == 1 || (table_scale->Shape().NumDimensions() == 1 && scale_size == num_embeddings),
+                      "EmbeddingBag: table_scale must be a scalar or have shape (num_embeddings)");
+    scale_data = table_scale->Data<float>();
+    per_row_quantization = scale_size != 1;
+    if (table_zero_point != nullptr) {
+      ORT_RETURN_IF_NOT(table_zero_point->Shape() == table_scale->Shape(),
+                        "EmbeddingBag: table_zero_point must have the same shape as table_scale");
+      zero_point_data = table_zero_point->Data<T>();
+    }
+  } else {
+    ORT_RETURN_IF_NOT(!std::is_integral<T>::value, "EmbeddingBag: table_scale is required for a quantized table");
+    ORT_RETURN_IF_NOT(table_zero_point == nullptr, "EmbeddingBag: table_zero_point requires table_scale");
+  }
+
+  Tensor* Y = context->Output(0, {static_cast<int64_t>(num_bags), static_cast<int64_t>(embedding_dim)});
+  if (num_bags == 0 || embedding_dim == 0) {
+    return Status::OK();
+  }
+
+  const T* table_data = table->Data<T>();
+  float* y_data = Y->MutableData<float>();
+
+  const bool use_scales = weights_data != nullptr || scale_data != nullptr || compute_mean_;
+
+  auto reduce_bags = [&](ptrdiff_t first, ptrdiff_t last) {
+    InlinedVector<const T*> rows;
+    InlinedVector<float> row_scales;
+    InlinedVector<float> row_biases;
+
+    for (size_t b = static_cast<size_t>(first); b < static_cast<size_t>(last); b++) {
+      const size_t start = bag_starts[b];
+      const size_t count = bag_starts[b + 1] - start;
+
+      rows.resize(count);
+      row_scales.resize(use_scales ? count : 0);
+      row_biases.resize(zero_point_data != nullptr ? count : 0);
+
+      const float mean_scale = compute_mean_ && count > 0 ? 1.0f / static_cast<float>(count) : 1.0f;
+
+      for (size_t i = 0; i < count; i++) {
+        int64_t idx = static_cast<int64_t>(indices_data[start + i]);
+        idx = idx < 0 ? idx + num_embeddings : idx;
+        rows[i] = table_data + static_cast<size_t>(idx) * embedding_dim;
+
+        if (use_scales) {
+          const size_t q = per_row_quantization ? static_cast<size_t>(idx) : 0;
+          float scale = mean_scale;
+          if (weights_data != nullptr) {
+            scale *= weights_data[start + i];
+          }
+          if (scale_data != nullptr) {
+            scale *= scale_data[q];
+          }
+          row_scales[i] = scale;
+          if (zero_point_data != nullptr) {
+            row_biases[i] = -scale * static_cast<float>(zero_point_data[q]);
+          }
+        }
+      }
+
+      MlasEmbeddingBag(mlas_mode_, rows.data(),
+                       use_scales ? row_scales.data() : nullptr,
+                       zero_point_data != nullptr ? row_biases.data() : nullptr,
+                       count, embedding_dim, y_data + b * embedding_dim);
+    }
+  };
+
+  const double average_bag_size = static_cast<double>(index_count) / static_cast<double>(num_bags);
+  const TensorOpCost cost{average_bag_size * static_cast<double>(embedding_dim * sizeof(T)),
+                          static_cast<double>(embedding_dim * sizeof(float)),
+                          average_bag_size * static_cast<double>(embedding_dim) * 2.0};
+
+  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), static_cast<ptrdiff_t>(num_bags), cost,
+                                          reduce_bags);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
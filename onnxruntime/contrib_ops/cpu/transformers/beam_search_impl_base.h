@@ -85,13 +85,26 @@ struct BeamSearchState : public IBeamSearchState<T> {
 struct BeamSearchCpuState : public IBeamSearchCpuState {
   Sequences sequences;
 
-  void Init(AllocatorPtr allocator, size_t batch_beam_size, int max_length, int sequence_length, bool is_cuda) {
+  PastStateReorderScratch past_state_reorder_scratch;
+
+  // past_state_bytes_per_beam is the size of the past state of one beam at max_length, or 0 when the past state is
+  // not reordered on CPU.
+  void Init(AllocatorPtr allocator, size_t batch_beam_size, int max_length, int sequence_length, bool is_cuda,
+            size_t past_state_bytes_per_beam) {
     this->sequence_lengths = AllocateBuffer<int32_t>(allocator, sequence_lengths_buffer_, batch_beam_size);
 
-    size_t sequences_bytes = SafeInt<size_t>(2) * batch_beam_size * max_length;
+    // One more sequence is needed as scratch space to reorder the sequences in place.
+    size_t sequences_bytes = (SafeInt<size_t>(batch_beam_size) + 1) * max_length;
     this->sequences_space = AllocateBuffer<int32_t>(allocator, sequences_space_buffer_, sequences_bytes);
     memset(this->sequences_space.data(), 0, this->sequences_space.size_bytes());
 
+    // Likewise the past state of one beam, to reorder the past state in place.
+    if (past_state_bytes_per_beam > 0) {
+      past_state_reorder_scratch.state = AllocateBuffer<uint8_t>(allocator, past_state_scratch_buffer_,
+                                                                 past_state_bytes_per_beam);
+      past_state_reorder_scratch.beam_reorder.Reserve(batch_beam_size);
+    }
+
     if (is_cuda) {
       // buffers used by CUDA operator but not by CPU operator.
       this->topk_scores = AllocateBuffer<float>(allocator, topk_scores_buffer_, 2 * batch_beam_size);
@@ -139,6 +152,7 @@ struct BeamSearchCpuState : public IBeamSearchCpuState {
   BufferUniquePtr topk_tokens_buffer_;
   BufferUniquePtr topk_indices_buffer_;
   BufferUniquePtr sequences_space_buffer_;
+  BufferUniquePtr past_state_scratch_buffer_;
 };
 
 // Base class of beam search implementation that is common for both GPT-2 and T5.
@@ -83,7 +83,8 @@ class BeamSearchGpt : public BeamSearchBase<T> {
       gsl::span<const int32_t> beam_indices_gpu,
       int past_sequence_length,
       int input_sequence_len,
-      bool need_cache_indir);
+      bool need_cache_indir,
+      PastStateReorderScratch& past_state_reorder_scratch);
 
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
@@ -155,7 +156,8 @@ Status BeamSearchGpt<T>::UpdateFeeds(
     gsl::span<const int32_t> beam_indices_gpu,
     int past_sequence_length,
     int input_sequence_len,
-    bool need_cache_indir) {
+    bool need_cache_indir,
+    PastStateReorderScratch& past_state_reorder_scratch) {
   return update_feeds_func_(this->temp_space_allocator_,
                             this->ort_stream_,
                             last_outputs,
@@ -172,7 +174,8 @@ Status BeamSearchGpt<T>::UpdateFeeds(
                             gpt_subgraph_.past_present_share_buffer_,
                             past_sequence_length,
                             input_sequence_len,
-                            need_cache_indir);
+                            need_cache_indir,
+                            &past_state_reorder_scratch);
 }
 
 template <typename T>
@@ -202,8 +205,6 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   std::vector<OrtValue> fetches;
 
   // Initialize resources
-  onnxruntime::OrtStlAllocator<HypothesisScore> hypothesis_score_allocator(this->cpu_allocator_);
-  onnxruntime::OrtStlAllocator<BeamHypotheses> beam_hyps_allocator(this->cpu_allocator_);
   this->beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters->batch_size),
                                                           static_cast<size_t>(parameters->num_beams),
                                                           static_cast<size_t>(parameters->max_length),
@@ -211,17 +212,21 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                                           parameters->early_stopping,
                                                           static_cast<size_t>(parameters->num_return_sequences),
                                                           parameters->pad_token_id,
-                                                          parameters->eos_token_id,
-                                                          hypothesis_score_allocator,
-                                                          beam_hyps_allocator);
+                                                          parameters->eos_token_id);
   this->beam_scorer_->Initialize(this->cpu_allocator_, parameters->sequence_length);
 
+  // The past state is reordered on CPU unless it is on CUDA or shares its buffer with the present state.
+  const bool reorder_past_state_on_cpu = !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_ &&
+                                         parameters->num_beams > 1;
   BeamSearchCpuState cpu_state;
   cpu_state.Init(this->cpu_allocator_,
                  static_cast<size_t>(parameters->BatchBeamSize()),
                  parameters->max_length,
                  parameters->sequence_length,
-                 this->IsCuda());
+                 this->IsCuda(),
+                 reorder_past_state_on_cpu ? SafeInt<size_t>(sizeof(T)) * parameters->num_heads *
+                                                 parameters->max_length * parameters->head_size
+                                           : 0);
 
   // buffer in GPU for input_ids, position_ids and attention_mask
   IAllocatorUniquePtr<char> buffer;
@@ -381,7 +386,8 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                           : place_holder,
                                       current_length - 1,
                                       parameters->sequence_length,
-                                      gpt_subgraph_.has_decoder_masked_attention_));
+                                      gpt_subgraph_.has_decoder_masked_attention_,
+                                      cpu_state.past_state_reorder_scratch));
     }
 
     if (gpt_subgraph_.past_present_share_buffer_) {
@@ -128,12 +128,17 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
 
   const OrtValue* encoder_attn_mask_value = this->context_.GetInputOrtValue(9);
 
+  // The self attention past state of the decoder is reordered on CPU unless it is on CUDA.
+  const bool reorder_past_state_on_cpu = !this->IsCuda() && parameters->num_beams > 1;
   BeamSearchCpuState cpu_state;
   cpu_state.Init(this->cpu_allocator_,
                  static_cast<size_t>(parameters->BatchBeamSize()),
                  parameters->max_length,
                  parameters->sequence_length,
-                 this->IsCuda());
+                 this->IsCuda(),
+                 reorder_past_state_on_cpu ? SafeInt<size_t>(sizeof(T)) * parameters->num_heads *
+                                                 parameters->max_length * parameters->head_size
+                                           : 0);
 
   IAllocatorUniquePtr<char> buffer;
   OrtValue decoder_input_ids;  // Tensor in CPU, and it will be used to initialize sequence in cpu_state
@@ -187,8 +192,6 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                         parameters->max_length,
                         parameters->sequence_length);
 
-  onnxruntime::OrtStlAllocator<HypothesisScore> hypothesis_score_allocator(this->cpu_allocator_);
-  onnxruntime::OrtStlAllocator<BeamHypotheses> beam_hyps_allocator(this->cpu_allocator_);
   this->beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters->batch_size),
                                                           static_cast<size_t>(parameters->num_beams),
                                                           static_cast<size_t>(parameters->max_length),
@@ -196,9 +199,7 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                                                           parameters->early_stopping,
                                                           static_cast<size_t>(parameters->num_return_sequences),
                                                           parameters->pad_token_id,
-                                                          parameters->eos_token_id,
-                                                          hypothesis_score_allocator,
-                                                          beam_hyps_allocator);
+                                                          parameters->eos_token_id);
   this->beam_scorer_->Initialize(this->cpu_allocator_, parameters->sequence_length);
 
   BeamSearchState<T> beam_state;
@@ -368,7 +369,8 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
           decoder_subgraph_.past_present_share_buffer_,
           decoder_subgraph_.has_decoder_masked_attention_,
           cpu_state.sequences,
-          this->GetConsoleDumper()));
+          this->GetConsoleDumper(),
+          &cpu_state.past_state_reorder_scratch));
     }
 
     if (decoder_subgraph_.past_present_share_buffer_) {
@@ -1,8 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <queue>
 #include <math.h>
+#include <memory>
+#include <type_traits>
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/common/span_utils.h"
@@ -18,43 +19,46 @@ namespace contrib {
 namespace transformers {
 using ::onnxruntime::rnn::detail::Allocate;
 
-BeamHypotheses::BeamHypotheses(int num_beams,
-                               float length_penalty,
-                               bool early_stopping,
-                               onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator)
-    : num_beams_(num_beams),
-      length_penalty_(length_penalty),
-      early_stopping_(early_stopping),
-      worst_score_(1e9),
-      beams_(hypothesis_score_allocator) {
+void BeamHypotheses::Init(float length_penalty, bool early_stopping, gsl::span<HypothesisScore> beams) {
+  beams_ = beams;
+  beams_used_ = 0;
+  length_penalty_ = length_penalty;
+  early_stopping_ = early_stopping;
 }
 
 void BeamHypotheses::Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs) {
   auto length = hypothesis.size();
   float score = sum_logprobs / pow(static_cast<float>(length), length_penalty_);
 
-  if (this->Size() < num_beams_ || score > worst_score_) {
-    HypothesisScore item(hypothesis, score);
-    beams_.push(item);
-    if (this->Size() > num_beams_) {
-      beams_.pop();
+  const int num_beams = static_cast<int>(beams_.size());
+  if (beams_used_ == num_beams) {
+    if (score <= beams_[num_beams - 1].score) {
+      return;
     }
-    worst_score_ = beams_.top().score;
+  } else {
+    beams_used_++;
+  }
+
+  // Shift the worse hypotheses down to make room. The worst one drops out when all the beams are used.
+  int index = beams_used_ - 1;
+  for (; index > 0 && beams_[index - 1].score < score; index--) {
+    beams_[index] = beams_[index - 1];
   }
+  beams_[index] = HypothesisScore{hypothesis, score};
 }
 
-bool BeamHypotheses::IsDone(float best_sum_logprobs, int current_length) {
+bool BeamHypotheses::IsDone(float best_sum_logprobs, int current_length) const {
   // If there are enough hypotheses and that none of the hypotheses being generated can become better
-  // than the worst one in the heap, then we are done with this sentence.
+  // than the worst one, then we are done with this sentence.
 
-  if (Size() < num_beams_)
+  if (beams_used_ < static_cast<int>(beams_.size()))
     return false;
 
   if (early_stopping_)
     return true;
 
   float current_score = best_sum_logprobs / pow(static_cast<float>(current_length), length_penalty_);
-  return worst_score_ >= current_score;
+  return beams_[beams_used_ - 1].score >= current_score;
 }
 
 void BeamHypotheses::Output(
@@ -64,28 +68,18 @@ void BeamHypotheses::Output(
     gsl::span<float>& sequences_scores)  // buffer of shape (num_return_sequences) or empty
 {
   ORT_ENFORCE(top_k <= Size());
-  int remove_count = Size() - top_k;
-  for (int i = 0; i < remove_count; i++) {
-    beams_.pop();
-  }
 
-  // Since pop get the worst sequence, so output it in the reverse order.
-  // The first (worst) beam shall be put at the last position among top_k sequences.
-  int index = top_k - 1;
-  while (!beams_.empty()) {
-    auto item = beams_.top();
-    gsl::span<const int32_t>& source = item.hypothesis;
+  // The hypotheses are sorted, so the best top_k are the first ones.
+  for (int index = 0; index < top_k; index++) {
+    const HypothesisScore& item = beams_[index];
     gsl::span<int32_t> target = sequences.subspan(static_cast<gsl::index>(index) * max_length, max_length);
 
     // Note that word_ids might be less than max_length.
     // Since the sequences has been filled with pad token ID, so padding is not needed here.
-    gsl::copy(source, target);
+    gsl::copy(item.hypothesis, target);
 
     if (!sequences_scores.empty())
       sequences_scores[index] = item.score;
-
-    beams_.pop();
-    index--;
   }
 }
 
@@ -96,21 +90,17 @@ BeamSearchScorer::BeamSearchScorer(size_t batch_size,
                                    bool early_stopping,
                                    size_t num_return_sequences,
                                    int pad_token_id,
-                                   int eos_token_id,
-                                   onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator,
-                                   onnxruntime::OrtStlAllocator<BeamHypotheses>& beam_hyps_allocator)
+                                   int eos_token_id)
     : batch_size_(batch_size),
       num_beams_(num_beams),
       max_length_(max_length),
       num_beam_hyps_to_keep_(num_return_sequences),
+      length_penalty_(length_penalty),
+      early_stopping_(early_stopping),
       pad_token_id_(pad_token_id),
       eos_token_id_(eos_token_id),
       hypothesis_buffer_length_(0),
-      hypothesis_buffer_offset_(0),
-      beam_hyps_(beam_hyps_allocator) {
-  for (size_t i = 0; i < batch_size; i++) {
-    beam_hyps_.push_back(BeamHypotheses(num_beams, length_penalty, early_stopping, hypothesis_score_allocator));
-  }
+      hypothesis_buffer_offset_(0) {
 }
 
 bool BeamSearchScorer::IsDone() {
@@ -138,6 +128,20 @@ void BeamSearchScorer::Initialize(AllocatorPtr& allocator, int sequence_length)
   size_t per_beam = (SafeInt<size_t>(max_length_) * (max_length_ + 1) - (sequence_length - 1) * sequence_length) / 2;
   hypothesis_buffer_length_ = batch_beam_size * per_beam;
   hypothesis_buffer_ = Allocate<int32_t>(allocator, hypothesis_buffer_length_, hypothesis_buffer_ptr_, no_fill);
+
+  // Space for the finished hypotheses of each batch, so that no allocation is needed while generating.
+  // The allocator returns raw memory, so the objects are constructed in place. They are trivially destructible,
+  // so freeing the buffers is enough to release them.
+  static_assert(std::is_trivially_destructible_v<HypothesisScore> &&
+                std::is_trivially_destructible_v<BeamHypotheses>);
+  gsl::span<HypothesisScore> hypothesis_scores = Allocate<HypothesisScore>(allocator, batch_beam_size,
+                                                                           hypothesis_scores_ptr_, no_fill);
+  std::uninitialized_default_construct_n(hypothesis_scores.data(), hypothesis_scores.size());
+  beam_hyps_ = Allocate<BeamHypotheses>(allocator, batch_size_, beam_hyps_ptr_, no_fill);
+  std::uninitialized_default_construct_n(beam_hyps_.data(), beam_hyps_.size());
+  for (size_t i = 0; i < batch_size_; i++) {
+    beam_hyps_[i].Init(length_penalty_, early_stopping_, hypothesis_scores.subspan(i * num_beams_, num_beams_));
+  }
 }
 
 void BeamSearchScorer::Process(ISequences* sequences,
@@ -4,14 +4,12 @@
 // The implementation is based on huggingface transformers generation_beam_search.py
 
 #pragma once
-#include <queue>
 #include <math.h>
 #include "core/common/common.h"
 #include "core/framework/allocator.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/tensor/utils.h"
-#include "core/providers/cpu/containers.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 
@@ -20,49 +18,36 @@ namespace contrib {
 namespace transformers {
 
 struct HypothesisScore {
-  HypothesisScore(gsl::span<const int32_t>& _hypothesis, float _score)
-      : hypothesis(_hypothesis), score(_score) {}
-
   gsl::span<const int32_t> hypothesis;
   float score;
 };
 
-class HypothesisScoreCompare {
- public:
-  bool operator()(const HypothesisScore& a, const HypothesisScore& b) {
-    return a.score > b.score;
-  }
-};
-
+// Finished hypotheses of one batch. The hypotheses are kept sorted by descending score in a fixed size slice of a
+// buffer shared by all batches, so adding a hypothesis never allocates.
 class BeamHypotheses {
  public:
-  BeamHypotheses(int num_beams,
-                 float length_penalty,
-                 bool early_stopping,
-                 onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator);
+  // Instances are constructed in place in a buffer shared by all batches and set up with Init.
+  void Init(float length_penalty, bool early_stopping, gsl::span<HypothesisScore> beams);
 
   // Number of hypotheses
-  int Size() { return static_cast<int>(beams_.size()); }
+  int Size() const { return beams_used_; }
 
   // Add a new hypothesis
   void Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs);
 
-  bool IsDone(float best_sum_logprobs, int current_length);
+  bool IsDone(float best_sum_logprobs, int current_length) const;
 
-  // Output results. Note that it will clear all beams.
+  // Output results.
   void Output(int top_k,                            // number of sequences to return
               int max_length,                       // max sequence length
               gsl::span<int32_t>& sequences,        // buffer with pad token, shape (num_return_sequences, max_length)
               gsl::span<float>& sequences_scores);  // buffer for sequence scores, with shape (num_return_sequences)
 
  private:
-  int num_beams_;
+  gsl::span<HypothesisScore> beams_;  // Space for num_beams hypotheses, the first beams_used_ sorted by score.
+  int beams_used_;
   float length_penalty_;
   bool early_stopping_;
-  float worst_score_;
-
-  // Min-heap for top k
-  std::priority_queue<HypothesisScore, onnxruntime::FastAllocVector<HypothesisScore>, HypothesisScoreCompare> beams_;
 };
 
 class BeamSearchScorer : public IBeamScorer {
@@ -74,9 +59,7 @@ class BeamSearchScorer : public IBeamScorer {
                    bool early_stopping,
                    size_t num_return_sequences,
                    int pad_token_id,
-                   int eos_token_id,
-                   onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator,
-                   onnxruntime::OrtStlAllocator<BeamHypotheses>& beam_hyps_allocator);
+                   int eos_token_id);
 
   void Initialize(AllocatorPtr& allocator, int sequence_length) override;
 
@@ -101,6 +84,8 @@ class BeamSearchScorer : public IBeamScorer {
   size_t num_beams_;
   size_t max_length_;
   size_t num_beam_hyps_to_keep_;
+  float length_penalty_;
+  bool early_stopping_;
   int pad_token_id_;
   int eos_token_id_;
 
@@ -121,7 +106,9 @@ class BeamSearchScorer : public IBeamScorer {
   size_t hypothesis_buffer_length_;                     // Total number of elements
   size_t hypothesis_buffer_offset_;                     // Offset of available buffer, or length of used buffer.
 
-  onnxruntime::FastAllocVector<BeamHypotheses> beam_hyps_;
+  IAllocatorUniquePtr<HypothesisScore> hypothesis_scores_ptr_;  // num_beams hypotheses for each batch
+  IAllocatorUniquePtr<BeamHypotheses> beam_hyps_ptr_;
+  gsl::span<BeamHypotheses> beam_hyps_;  // Shape is (batch_size).
 };
 
 }  // namespace transformers
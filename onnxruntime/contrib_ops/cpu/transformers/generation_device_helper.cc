@@ -555,45 +555,48 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* /*stre
   return Status::OK();
 }
 
-// Copy present state to past state for GPT model
+// Applies the copies from GetBeamReorderCopies to a state with block_size elements per beam.
 template <typename T>
-void PickGptPastState(const std::vector<OrtValue>& last_outputs,
-                      std::vector<OrtValue>& next_inputs,
-                      gsl::span<const int32_t>& beam_indices,
-                      int gpt_subgraph_first_past_input_idx,
-                      int gpt_subgraph_first_present_output_idx,
-                      AllocatorPtr allocator) {
+void ReorderBeamStates(gsl::span<const transformers::BeamCopy> copies, T* data, T* scratch, size_t block_size) {
+  for (const transformers::BeamCopy& copy : copies) {
+    const T* source = copy.source == transformers::kScratchBeam ? scratch : data + copy.source * block_size;
+    T* target = copy.target == transformers::kScratchBeam ? scratch : data + copy.target * block_size;
+    std::copy_n(source, block_size, target);
+  }
+}
+
+// Reorder present state in place to get past state for GPT model. Only beams that continue another beam are copied.
+template <typename T>
+Status PickGptPastState(const std::vector<OrtValue>& last_outputs,
+                        std::vector<OrtValue>& next_inputs,
+                        gsl::span<const int32_t>& beam_indices,
+                        int gpt_subgraph_first_past_input_idx,
+                        int gpt_subgraph_first_present_output_idx,
+                        transformers::PastStateReorderScratch& scratch) {
+  transformers::GetBeamReorderCopies(beam_indices, scratch.beam_reorder);
+  const InlinedVector<transformers::BeamCopy>& copies = scratch.beam_reorder.copies;
+  T* scratch_data = reinterpret_cast<T*>(scratch.state.data());
+
   int num_present_tensors = static_cast<int>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[gpt_subgraph_first_present_output_idx + i];
+    // The present state is not used after this, so the past state shares its buffer.
+    OrtValue past = last_outputs[gpt_subgraph_first_present_output_idx + i];
 
     // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
-    auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * SafeInt<size_t>(block_size_per_beam),
-                                                              onnxruntime::narrow<size_t>(block_size_per_beam));
-
-      gsl::span<T> past_key = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
-    }
+    const TensorShape& past_shape = past.Get<Tensor>().Shape();
+    const size_t block_size_per_beam = onnxruntime::narrow<size_t>(past_shape[2] * past_shape[3] * past_shape[4]);
+    const size_t past_key_size = onnxruntime::narrow<size_t>(past_shape[1]) * block_size_per_beam;
+    ORT_RETURN_IF(!copies.empty() && block_size_per_beam * sizeof(T) > scratch.state.size(),
+                  "Past state of one beam is larger than the reorder scratch space: ", past_shape);
+
+    T* past_data = past.GetMutable<Tensor>()->MutableData<T>();
+    ReorderBeamStates<T>(copies, past_data, scratch_data, block_size_per_beam);
+    ReorderBeamStates<T>(copies, past_data + past_key_size, scratch_data, block_size_per_beam);
 
     next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
   }
+
+  return Status::OK();
 }
 
 template <typename T>
@@ -614,7 +617,8 @@ Status UpdateGptFeeds(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir) {
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch) {
   // last_outputs: logits, present_0, present_1, ...
   // next_inputs: input_ids, position_id, attention_mask, past_0, past_1
   ORT_UNUSED_PARAMETER(stream);
@@ -676,9 +680,10 @@ Status UpdateGptFeeds(
       next_inputs[i + k] = last_outputs[i];
     }
   } else {
-    PickGptPastState<T>(last_outputs, next_inputs, beam_indices_cpu,
-                        gpt_subgraph_first_past_input_idx,
-                        gpt_subgraph_first_present_output_idx, allocator);
+    ORT_ENFORCE(past_state_reorder_scratch != nullptr);
+    ORT_RETURN_IF_ERROR(PickGptPastState<T>(last_outputs, next_inputs, beam_indices_cpu,
+                                            gpt_subgraph_first_past_input_idx,
+                                            gpt_subgraph_first_present_output_idx, *past_state_reorder_scratch));
   }
   return Status::OK();
 }
@@ -756,38 +761,36 @@ Status CreateEncoderInputs(
   return Status::OK();
 }
 
-// Copy present state to past state for T5 model
+// Reorder present state in place to get past state for T5 model. Only beams that continue another beam are copied.
 template <typename T>
-void PickT5PastState(const std::vector<OrtValue>& last_outputs,
-                     std::vector<OrtValue>& next_inputs,
-                     int num_present_tensors,
-                     gsl::span<const int32_t>& beam_indices,
-                     int t5_decoder_first_past_input_idx,
-                     int t5_decoder_first_present_output_idx,
-                     AllocatorPtr allocator) {
+Status PickT5PastState(const std::vector<OrtValue>& last_outputs,
+                       std::vector<OrtValue>& next_inputs,
+                       int num_present_tensors,
+                       gsl::span<const int32_t>& beam_indices,
+                       int t5_decoder_first_past_input_idx,
+                       int t5_decoder_first_present_output_idx,
+                       transformers::PastStateReorderScratch& scratch) {
+  transformers::GetBeamReorderCopies(beam_indices, scratch.beam_reorder);
+  const InlinedVector<transformers::BeamCopy>& copies = scratch.beam_reorder.copies;
+  T* scratch_data = reinterpret_cast<T*>(scratch.state.data());
+
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
+    // The present state is not used after this, so the past state shares its buffer.
+    OrtValue past = last_outputs[t5_decoder_first_present_output_idx + i];
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
-    auto block_size_per_beam = past_shape[1] * past_shape[2] * past_shape[3];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_beam = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_beam = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_beam, past_beam);
-    }
+    const TensorShape& past_shape = past.Get<Tensor>().Shape();
+    const size_t block_size_per_beam = onnxruntime::narrow<size_t>(past_shape[1] * past_shape[2] * past_shape[3]);
+    ORT_RETURN_IF(!copies.empty() && block_size_per_beam * sizeof(T) > scratch.state.size(),
+                  "Past state of one beam is larger than the reorder scratch space: ", past_shape);
+
+    ReorderBeamStates<T>(copies, past.GetMutable<Tensor>()->MutableData<T>(), scratch_data,
+                         block_size_per_beam);
 
     next_inputs[t5_decoder_first_past_input_idx + i] = past;
   }
+
+  return Status::OK();
 }
 
 // Update decoder inputs given decoder outputs of last iteration.
@@ -810,7 +813,8 @@ Status UpdateDecoderFeeds(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper) {
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch) {
   ORT_UNUSED_PARAMETER(stream);
   ORT_UNUSED_PARAMETER(beam_indices_gpu);
   ORT_UNUSED_PARAMETER(input_sequence_len);
@@ -864,8 +868,10 @@ Status UpdateDecoderFeeds(
           last_outputs[t5_decoder_first_present_output_idx + i];
     }
   } else {
-    PickT5PastState<T>(last_outputs, next_inputs, num_present_tensors, beam_indices,
-                       t5_decoder_first_past_input_idx, t5_decoder_first_present_output_idx, allocator);
+    ORT_ENFORCE(past_state_reorder_scratch != nullptr);
+    ORT_RETURN_IF_ERROR(PickT5PastState<T>(last_outputs, next_inputs, num_present_tensors, beam_indices,
+                                           t5_decoder_first_past_input_idx, t5_decoder_first_present_output_idx,
+                                           *past_state_reorder_scratch));
   }
   return Status::OK();
 }
@@ -1017,7 +1023,8 @@ template Status UpdateGptFeeds<float>(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir);
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template Status UpdateDecoderFeeds<float>(
     AllocatorPtr allocator,
@@ -1037,7 +1044,8 @@ template Status UpdateDecoderFeeds<float>(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper);
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template void ExpandInputs<int32_t>(const OrtValue& input, int num_beams, AllocatorPtr allocator, OrtValue& expanded);
 
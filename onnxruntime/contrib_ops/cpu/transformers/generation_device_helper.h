@@ -136,7 +136,8 @@ using UpdateGptFeedsFunc = std::function<Status(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir)>;
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch)>;
 
 // Create encoder inputs (for encoder-decoder model like T5).
 using CreateEncoderInputsFunc = std::function<Status(
@@ -169,7 +170,8 @@ using UpdateDecoderFeedsFunc = std::function<Status(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper)>;
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch)>;
 
 template <typename T>
 using ExpandBufferFunc = std::function<Status(
@@ -278,7 +280,8 @@ Status UpdateGptFeeds(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir);
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 // ---------------------------------------------------------------
 // Functions for encoder-decoder model like T5
@@ -313,7 +316,8 @@ Status UpdateDecoderFeeds(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper);
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 // ---------------------------------------------------------------
 // Functions for encoder-decoder model with float input like Whisper
@@ -47,7 +47,7 @@ struct IBeamSearchState {
 
 struct IBeamSearchCpuState {
   gsl::span<int32_t> sequence_lengths;  // shape (batch_size, num_beams), initial sequence length
-  gsl::span<int32_t> sequences_space;   // shape (2, batch_size, num_beams, max_seq_length)
+  gsl::span<int32_t> sequences_space;   // shape (batch_size * num_beams + 1, max_seq_length) with a scratch row
 
   // The following are used only by CUDA operator for data copied from device.
   gsl::span<float> topk_scores;        // shape (batch_size, 2*num_beams), scores of topk candidates (K=2*num_beams).
@@ -58,7 +58,7 @@ struct IBeamSearchCpuState {
 
 template <typename T>
 struct IGreedySearchState {
-  gsl::span<int32_t> sequences_space;          // shape (2, batch_size, max_length)
+  gsl::span<int32_t> sequences_space;          // shape (batch_size + 1, max_length) with a scratch row
   gsl::span<int32_t> sequence_lengths;         // shape (batch_size)
   gsl::span<int32_t> next_positions;           // shape (batch_size, num_beams). Next position value for position_ids.
   gsl::span<bool> eos_meet;                    // shape (batch_size)
@@ -89,7 +89,6 @@ struct ISamplingState {
   size_t temp_storage_bytes;
   std::default_random_engine generator;
 
-  gsl::span<T> sorted_scores;
   gsl::span<T> cumulative_probs;
 };
 
@@ -47,8 +47,6 @@ struct SamplingState : public ISamplingState<T> {
         this->h_sampled_all[i] = distribution(this->generator);
       }
     } else {
-      // TODO: Some buffer can be reused for CPU
-      this->sorted_scores = AllocateBuffer<T>(cpu_allocator, sorted_scores_buffer_, SafeInt<size_t>(total_count));
       this->cumulative_probs = AllocateBuffer<T>(cpu_allocator, cumulative_probs_buffer_, SafeInt<size_t>(total_count));
     }
   }
@@ -65,7 +63,6 @@ struct SamplingState : public ISamplingState<T> {
   BufferUniquePtr h_sampled_all_buffer_;
   BufferUniquePtr d_indices_buffer_;
   BufferUniquePtr d_presence_mask_buffer_;
-  BufferUniquePtr sorted_scores_buffer_;
   BufferUniquePtr cumulative_probs_buffer_;
 };
 
@@ -86,7 +83,7 @@ struct GreedySearchState : public IGreedySearchState<T> {
     // below buffers are on cpu
     this->sequences_space = AllocateBuffer<int32_t>(cpu_allocator,
                                                     sequences_space_buffer_,
-                                                    SafeInt<size_t>(2) * batch_size * max_length);
+                                                    (SafeInt<size_t>(batch_size) + 1) * max_length);
     memset(this->sequences_space.data(), 0, this->sequences_space.size_bytes());
     this->sequences.Init(this->sequences_space, static_cast<int>(batch_size), sequence_length, max_length);
 
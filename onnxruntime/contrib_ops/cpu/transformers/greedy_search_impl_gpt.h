@@ -177,7 +177,8 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             gpt_subgraph_.past_present_share_buffer_,
                             past_sequence_length,
                             -1,  // Input sequence length needn't be passed in for GreedySearch
-                            false);
+                            false,
+                            nullptr);  // There is only one beam, so the past state is not reordered
 }
 
 template <typename T, typename ParametersT>
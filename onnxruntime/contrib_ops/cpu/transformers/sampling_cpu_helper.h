@@ -6,54 +6,58 @@ namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
+// Number of most probable tokens selected first when looking for the tokens to keep. The selection is widened by
+// kCandidatesGrowth until it contains every kept token.
+constexpr size_t kInitialCandidates = 256;
+constexpr size_t kCandidatesGrowth = 8;
+
+// Finds how many of the most probable tokens are kept by top_p filtering, given the first 'candidate_count' token
+// indices of a batch in descending order of probability. Returns false if the kept tokens are not all candidates.
+//
+// With custom sampling a token is kept while the probability of the more probable tokens does not exceed top_p.
+// Otherwise a token is filtered when the probability of it and the less probable tokens is at most 1 - top_p, unless
+// it is one of the min_tokens_to_keep most probable tokens. That probability is computed as the total probability
+// minus that of the more probable tokens, in double so that the least probable tokens are not lost to rounding.
 template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
-}
-
-template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
-      }
-    }
+bool find_kept_count(const int64_t* candidate_indices,
+                     size_t candidate_count,
+                     const T* probs,
+                     const transformers::IGenerationParameters* parameters,
+                     size_t& kept_count) {
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  const T top_p = static_cast<T>(parameters->top_p);
+
+  double total_prob = 0;
+  if (!parameters->custom_sampling) {
+    total_prob = std::accumulate(probs, probs + vocab_size, 0.0);
   }
-}
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
+  T cumulative_prob = 0;
+  double more_probable_prob = 0;
+  for (size_t i = 0; i < vocab_size; i++) {
+    const bool filtered = parameters->custom_sampling
+                              ? (i > 0 && cumulative_prob > top_p)
+                              : total_prob - more_probable_prob <= static_cast<double>(1 - top_p);
+    if (filtered) {
+      kept_count = parameters->custom_sampling
+                       ? i
+                       : std::max(i, std::min(static_cast<size_t>(parameters->min_tokens_to_keep), vocab_size));
+      return kept_count <= candidate_count;
     }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
-      }
+    if (i == candidate_count) {
+      return false;
     }
+    cumulative_prob += probs[candidate_indices[i]];
+    more_probable_prob += static_cast<double>(probs[candidate_indices[i]]);
   }
+
+  kept_count = vocab_size;
+  return true;
 }
 
+// Keeps the smallest set of most probable tokens whose probability reaches top_p and samples the next tokens from
+// them. Instead of sorting the whole vocabulary, the probabilities are computed once and only the most probable
+// tokens are selected with TopK, which also splits each batch across threads for large vocabularies.
 template <typename T>
 Status Sample(AllocatorPtr& allocator,
               onnxruntime::concurrency::ThreadPool* thread_pool,
@@ -64,69 +68,72 @@ Status Sample(AllocatorPtr& allocator,
               const transformers::IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
+  const size_t batch_size = static_cast<size_t>(parameters->batch_size);
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
 
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
+  gsl::span<T>& probs = sampling_state->cumulative_probs;
+  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
+                                    parameters->vocab_size,
+                                    next_token_scores.data(),
+                                    probs.data(),
+                                    false,
+                                    thread_pool));
 
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
+  int64_t next_token_scores_dims[] = {static_cast<int64_t>(parameters->batch_size), parameters->vocab_size};
+  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
+  OrtValue next_token_scores_value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<T>(),
+                       next_token_scores_shape,
+                       next_token_scores.data(),
+                       allocator->Info(),
+                       next_token_scores_value);
+
+  std::vector<size_t> kept_counts(batch_size);
+  size_t candidate_count = std::min(vocab_size,
+                                    std::max(kInitialCandidates, static_cast<size_t>(parameters->min_tokens_to_keep)));
+  Tensor candidate_scores;
+  Tensor candidate_indices;
+  while (true) {
+    ORT_RETURN_IF_ERROR(GetTopK<T>(&next_token_scores_value.Get<Tensor>(), 1, static_cast<unsigned>(candidate_count),
+                                   true, true, allocator, thread_pool, candidate_scores, candidate_indices));
+
+    bool all_found = true;
+    for (size_t i = 0; i < batch_size; i++) {
+      all_found &= find_kept_count(candidate_indices.Data<int64_t>() + i * candidate_count,
+                                   candidate_count,
+                                   probs.data() + i * vocab_size,
+                                   parameters,
+                                   kept_counts[i]);
+    }
+
+    if (all_found) {
+      break;
+    }
+    candidate_count = std::min(vocab_size, candidate_count * kCandidatesGrowth);
   }
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
+  dumper->Print("candidate_scores", candidate_scores);
+  dumper->Print("candidate_indices", candidate_indices);
 #endif
 
-  gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
+  for (size_t i = 0; i < batch_size; i++) {
+    gsl::span<T> next_token_score = next_token_scores.subspan(i * vocab_size, vocab_size);
+    const T* scores = candidate_scores.Data<T>() + i * candidate_count;
+    const int64_t* indices = candidate_indices.Data<int64_t>() + i * candidate_count;
 
-  ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
-                                    parameters->vocab_size,
-                                    sorted_scores.data(),
-                                    cumulative_probs.data(),
-                                    false,
-                                    thread_pool));
-
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
+    std::fill(next_token_score.begin(), next_token_score.end(), static_cast<T>(parameters->filter_value));
+    for (size_t j = 0; j < kept_counts[i]; j++) {
+      next_token_score[static_cast<size_t>(indices[j])] = scores[j];
+    }
   }
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
   dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
   // torch.multinomial()
-  int64_t next_token_probs_dims[] = {static_cast<int64_t>(parameters->batch_size), parameters->vocab_size};
-  TensorShape next_token_probs_shape(&next_token_probs_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<T>();
-  OrtValue next_token_probs_value;
-  Tensor::InitOrtValue(element_type,
-                       next_token_probs_shape,
-                       next_token_scores.data(),
-                       allocator->Info(),
-                       next_token_probs_value);
-  const Tensor& input = next_token_probs_value.Get<Tensor>();
+  const Tensor& input = next_token_scores_value.Get<Tensor>();
 
   std::default_random_engine& generator = sampling_state->generator;
 
@@ -8,23 +8,74 @@ namespace onnxruntime {
 namespace contrib {
 namespace transformers {
 
+void GetBeamReorderCopies(gsl::span<const int32_t> beam_indices, BeamReorder& reorder) {
+  const int32_t num_beams = static_cast<int32_t>(beam_indices.size());
+  InlinedVector<BeamCopy>& copies = reorder.copies;
+  InlinedVector<int32_t>& readers = reorder.readers;
+  InlinedVector<int32_t>& ready = reorder.ready;
+  InlinedVector<bool>& copied = reorder.copied;
+
+  // The vectors keep their capacity, so they don't allocate once reserved for the number of beams.
+  copies.clear();
+  ready.clear();
+  readers.assign(num_beams, 0);
+  copied.assign(num_beams, false);
+  for (int32_t i = 0; i < num_beams; i++) {
+    if (beam_indices[i] != i) {
+      readers[beam_indices[i]]++;
+    }
+  }
+  for (int32_t i = 0; i < num_beams; i++) {
+    if (beam_indices[i] != i && readers[i] == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  while (!ready.empty()) {
+    const int32_t target = ready.back();
+    ready.pop_back();
+    const int32_t source = beam_indices[target];
+    copies.push_back({target, source});
+    copied[target] = true;
+    if (--readers[source] == 0 && beam_indices[source] != source) {
+      ready.push_back(source);
+    }
+  }
+
+  // The beams left are cycles, where every beam is read by exactly one other beam.
+  for (int32_t start = 0; start < num_beams; start++) {
+    if (beam_indices[start] == start || copied[start]) {
+      continue;
+    }
+
+    copies.push_back({kScratchBeam, start});
+    int32_t target = start;
+    while (beam_indices[target] != start) {
+      copies.push_back({target, beam_indices[target]});
+      copied[target] = true;
+      target = beam_indices[target];
+    }
+    copies.push_back({target, kScratchBeam});
+    copied[target] = true;
+  }
+}
+
 void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length) {
   size_t sequences_size = SafeInt<size_t>(batch_beam_size) * max_length;
-  assert(buffer.size() == sequences_size + sequences_size);
-
-  sequences[0] = buffer.subspan(0, sequences_size);
-  sequences[1] = buffer.subspan(sequences_size);
+  assert(buffer.size() == sequences_size + max_length);
 
-  current_sequences_buffer = 0;
+  sequences_ = buffer.subspan(0, sequences_size);
+  scratch_ = buffer.subspan(sequences_size);
 
   batch_beam_size_ = batch_beam_size;
   max_length_ = max_length;
   current_length_ = sequence_length;
+
+  beam_reorder_.Reserve(batch_beam_size);
 }
 
 gsl::span<const int32_t> Sequences::GetSequence(int beam_index) const {
-  gsl::span<const int32_t> buffer(sequences[current_sequences_buffer].data(),
-                                  sequences[current_sequences_buffer].size());
+  gsl::span<const int32_t> buffer(sequences_.data(), sequences_.size());
   gsl::span<const int32_t> sequence = buffer.subspan(SafeInt<size_t>(beam_index) * max_length_,
                                                      static_cast<gsl::index>(current_length_));
   return sequence;
@@ -47,37 +98,34 @@ void Sequences::PrintSequences(const IConsoleDumper* dumper) const {
 void Sequences::AppendNextTokenToSequences(
     gsl::span<int32_t>& beam_indices,
     gsl::span<int32_t>& beam_next_tokens) {
-  gsl::span<const int32_t> input(sequences[current_sequences_buffer].data(),
-                                 sequences[current_sequences_buffer].size());
-  gsl::span<int32_t> output = sequences[1 - current_sequences_buffer];
-
-  for (int i = 0; i < batch_beam_size_; i++) {
-    int beam_index = beam_indices[i];
-    gsl::span<const int32_t> source = input.subspan(SafeInt<size_t>(beam_index) * max_length_,
-                                                    static_cast<gsl::index>(current_length_));
-    gsl::span<int32_t> target = output.subspan(SafeInt<size_t>(i) * max_length_,
-                                               static_cast<gsl::index>(current_length_));
+  // Only the beams that continue another beam are copied.
+  GetBeamReorderCopies(beam_indices, beam_reorder_);
+  for (const BeamCopy& copy : beam_reorder_.copies) {
+    gsl::span<const int32_t> source =
+        copy.source == kScratchBeam
+            ? gsl::span<const int32_t>(scratch_.data(), static_cast<gsl::index>(current_length_))
+            : gsl::span<const int32_t>(sequences_.data() + SafeInt<size_t>(copy.source) * max_length_,
+                                       static_cast<gsl::index>(current_length_));
+    gsl::span<int32_t> target =
+        copy.target == kScratchBeam
+            ? scratch_.subspan(0, static_cast<gsl::index>(current_length_))
+            : sequences_.subspan(SafeInt<size_t>(copy.target) * max_length_, static_cast<gsl::index>(current_length_));
     gsl::copy(source, target);
   }
 
   // Append next token to each beam.
   for (int i = 0; i < batch_beam_size_; i++) {
-    output[SafeInt<size_t>(i) * max_length_ + current_length_] = beam_next_tokens[i];
+    sequences_[SafeInt<size_t>(i) * max_length_ + current_length_] = beam_next_tokens[i];
   }
 
   ++current_length_;
-
-  // Rotate buffer for next round.
-  current_sequences_buffer = 1 - current_sequences_buffer;
 }
 
 void Sequences::AppendNextTokenToSequences(
     gsl::span<int32_t>& next_tokens) {
-  gsl::span<int32_t> output(sequences[current_sequences_buffer].data(), sequences[current_sequences_buffer].size());
-
   // Append next token to each sequence.
   for (int i = 0; i < batch_beam_size_; i++) {
-    output[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
+    sequences_[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
   }
 
   ++current_length_;
@@ -4,18 +4,59 @@
 #pragma once
 
 #include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 
 namespace onnxruntime {
 namespace contrib {
 namespace transformers {
 
+// Beam index used in BeamCopy for a scratch space that holds the state of one beam.
+constexpr int32_t kScratchBeam = -1;
+
+// Copy of the state of the source beam to the target beam.
+struct BeamCopy {
+  int32_t target;
+  int32_t source;
+};
+
+// Copies that reorder the beams at one step and the space used to get them. It is kept for a whole generation run
+// and reserved once, so that getting the copies at each step doesn't allocate.
+struct BeamReorder {
+  InlinedVector<BeamCopy> copies;  // copies of the current step
+
+  InlinedVector<int32_t> readers;  // number of other beams that read the state of each beam
+  InlinedVector<int32_t> ready;    // beams that no other beam reads anymore
+  InlinedVector<bool> copied;      // whether each beam got its new state
+
+  void Reserve(size_t batch_beam_size) {
+    // Every beam is copied at most once, and each cycle of at least two beams adds one copy to the scratch space.
+    copies.reserve(batch_beam_size + batch_beam_size / 2);
+    readers.reserve(batch_beam_size);
+    ready.reserve(batch_beam_size);
+    copied.reserve(batch_beam_size);
+  }
+};
+
+// Gets the copies that reorder the states of beams in place, so that beam i gets the state of beam beam_indices[i].
+// A beam that keeps its own state is not copied and every other beam is copied once. A beam is only overwritten
+// after the beams that read it, and each cycle of beams exchanging states goes through the scratch space once.
+// The copies are put in reorder.copies, and the other members of reorder are work space.
+void GetBeamReorderCopies(gsl::span<const int32_t> beam_indices, BeamReorder& reorder);
+
+// Space to reorder the past state of the beams in place. It is allocated once per generation run, alongside the
+// scratch row of the sequences, so that reordering the past state at each step doesn't allocate.
+struct PastStateReorderScratch {
+  gsl::span<uint8_t> state;  // space for the past state of one beam, up to max_length
+  BeamReorder beam_reorder;
+};
+
 // This class keeps track of sequences generated.
 class Sequences : public ISequences {
  public:
   Sequences() {}
 
-  // Initialize the sequence.
+  // Initialize the sequence. The buffer has space for batch_beam_size + 1 sequences, the last one being scratch space.
   void Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length);
 
   // Returns a sequence of word IDs for a given beam index ( beam_index < batch_beam_size).
@@ -29,7 +70,7 @@ class Sequences : public ISequences {
   void PrintSequences(const IConsoleDumper* dumper) const;
 #endif
 
-  // Select sequences based on beam indices, then append next token to selected sequences.
+  // Select sequences based on beam indices in place, then append next token to selected sequences.
   void AppendNextTokenToSequences(
       gsl::span<int32_t>& beam_indices,
       gsl::span<int32_t>& beam_next_tokens);
@@ -38,13 +79,14 @@ class Sequences : public ISequences {
       gsl::span<int32_t>& next_tokens);
 
  private:
-  // Two buffers of shape (batch_size, num_beams, max_seq_length) to store sequences.
-  // At each time, there is only one buffer is active. The other one will be active in next token.
-  // Each AppendNextTokenToSequences call will trigger a rotation of active buffer.
-  gsl::span<int32_t> sequences[2];
+  // Buffer of shape (batch_size, num_beams, max_seq_length) to store sequences.
+  gsl::span<int32_t> sequences_;
+
+  // Space for one sequence used when reordering the sequences.
+  gsl::span<int32_t> scratch_;
 
-  // Index (either 0 or 1) of two buffers that is currently is active.
-  int current_sequences_buffer;
+  // Reserved in Init and reused across calls of AppendNextTokenToSequences to avoid allocations.
+  BeamReorder beam_reorder_;
 
   int batch_beam_size_;
   int max_length_;
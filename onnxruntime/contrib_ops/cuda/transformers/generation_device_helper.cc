@@ -918,7 +918,11 @@ Status UpdateGptFeeds(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir) {
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch) {
+  // The past state is reordered on the device.
+  ORT_UNUSED_PARAMETER(past_state_reorder_scratch);
+
 #ifdef ENABLE_NVTX_PROFILE
   profile::NvtxNestedRangeCreator updateFeedsRange("UpdateGptFeeds", profile::Color::Yellow);
   updateFeedsRange.Begin();
@@ -1039,7 +1043,11 @@ Status UpdateDecoderFeeds(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper) {
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch) {
+  // The past state is reordered on the device.
+  ORT_UNUSED_PARAMETER(past_state_reorder_scratch);
+
   // last_outputs: logits, present_key_self_0, present_value_self_0, ...
   // next_inputs: input_ids,
   //              encoder_attention_mask, encoder_hidden_states,
@@ -1296,7 +1304,8 @@ template Status UpdateGptFeeds<float>(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir);
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 // Float16
 template void InitBeamState<MLFloat16>(
@@ -1356,7 +1365,8 @@ template Status UpdateGptFeeds<MLFloat16>(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir);
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template Status UpdateDecoderFeeds<float>(
     AllocatorPtr allocator,
@@ -1376,7 +1386,8 @@ template Status UpdateDecoderFeeds<float>(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper);
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template Status UpdateDecoderFeeds<MLFloat16>(
     AllocatorPtr allocator,
@@ -1396,7 +1407,8 @@ template Status UpdateDecoderFeeds<MLFloat16>(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper);
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template Status ExpandBuffer<int32_t>(
     Stream* ort_stream,
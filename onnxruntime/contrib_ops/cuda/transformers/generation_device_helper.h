@@ -105,7 +105,8 @@ Status UpdateGptFeeds(
     bool past_present_share_buffer,
     int past_sequence_len,
     int input_sequence_len,
-    bool need_cache_indir);
+    bool need_cache_indir,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 // ---------------------------------------------------------------
 // Functions for encoder-decoder model like T5
@@ -131,7 +132,8 @@ Status UpdateDecoderFeeds(
     bool past_present_share_buffer,
     bool need_cache_indir,
     transformers::Sequences& sequences,
-    const transformers::IConsoleDumper* dumper);
+    const transformers::IConsoleDumper* dumper,
+    transformers::PastStateReorderScratch* past_state_reorder_scratch);
 
 template <typename T>
 Status ExpandBuffer(
@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/session_metrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+// Shard of the calling thread. Threads are spread round robin over the shards.
+size_t ThreadShard(size_t num_shards) noexcept {
+  static std::atomic<size_t> next_shard{0};
+  thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shard % num_shards;
+}
+
+void AppendLabel(std::string& labels, const char* name, const std::string& value) {
+  if (!labels.empty()) {
+    labels += ',';
+  }
+  labels.append(name).append("=\"").append(value).append("\"");
+}
+}  // namespace
+
+size_t LatencyHistogram::BucketIndex(std::chrono::nanoseconds duration) noexcept {
+  // round up to whole microseconds so bucket i holds (2^(i-1), 2^i] us
+  const auto count = duration.count();
+  uint64_t us = count <= 0 ? 0 : static_cast<uint64_t>((count + 999) / 1000);
+  size_t index = 0;
+  uint64_t bound = 1;
+  while (us > bound && index < kNumBuckets - 1) {
+    bound <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds duration) noexcept {
+  Shard& shard = shards_[ThreadShard(kNumShards)];
+  shard.buckets[BucketIndex(duration)].fetch_add(1, std::memory_order_relaxed);
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  shard.sum_ns.fetch_add(static_cast<uint64_t>(std::max<int64_t>(0, duration.count())), std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const noexcept {
+  Snapshot snapshot;
+  for (const auto& shard : shards_) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count += shard.count.load(std::memory_order_relaxed);
+    snapshot.sum_ns += shard.sum_ns.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+SessionMetrics::SessionMetrics(uint32_t op_sampling_interval) noexcept
+    : op_sampling_interval_(op_sampling_interval) {
+}
+
+bool SessionMetrics::SampleExecution() noexcept {
+  uint64_t execution = executions_.fetch_add(1, std::memory_order_relaxed);
+  if (op_sampling_interval_ == 0 || execution % op_sampling_interval_ != 0) {
+    return false;
+  }
+
+  sampled_executions_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void SessionMetrics::RecordRun(std::chrono::nanoseconds duration, bool succeeded) noexcept {
+  run_latency_.Record(duration);
+  if (!succeeded) {
+    failed_runs_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+LatencyHistogram* SessionMetrics::GetOrAddOpHistogram(const std::string& op_type, const std::string& provider) {
+  std::lock_guard<OrtMutex> lock(op_histograms_mutex_);
+  auto& histogram = op_histograms_[std::make_pair(op_type, provider)];
+  if (!histogram) {
+    histogram = std::make_unique<LatencyHistogram>();
+  }
+
+  return histogram.get();
+}
+
+std::string SessionMetrics::EscapeLabel(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void SessionMetrics::WriteSample(std::ostream& os, const std::string& name, const char* type,
+                                 const std::string& labels, double value) {
+  if (type != nullptr && *type != '\0') {
+    os << "# TYPE " << name << " " << type << "\n";
+  }
+  os << name;
+  if (!labels.empty()) {
+    os << "{" << labels << "}";
+  }
+  os << " " << std::setprecision(17) << value << "\n";
+}
+
+void SessionMetrics::WriteHistogram(std::ostream& os, const std::string& name, const std::string& labels,
+                                    const LatencyHistogram::Snapshot& snapshot) {
+  // only write the buckets up to the largest one in use. buckets are cumulative.
+  size_t last_used = 0;
+  for (size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    if (snapshot.buckets[i] != 0) {
+      last_used = i;
+    }
+  }
+
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i <= last_used && i < LatencyHistogram::kNumBuckets - 1; ++i) {
+    cumulative += snapshot.buckets[i];
+    std::string bucket_labels = labels;
+    AppendLabel(bucket_labels, "le", std::to_string(uint64_t{1} << i));
+    WriteSample(os, name + "_bucket", nullptr, bucket_labels, static_cast<double>(cumulative));
+  }
+
+  std::string inf_labels = labels;
+  AppendLabel(inf_labels, "le", "+Inf");
+  WriteSample(os, name + "_bucket", nullptr, inf_labels, static_cast<double>(snapshot.count));
+  WriteSample(os, name + "_sum", nullptr, labels, static_cast<double>(snapshot.sum_ns) / 1000.0);
+  WriteSample(os, name + "_count", nullptr, labels, static_cast<double>(snapshot.count));
+}
+
+void SessionMetrics::WriteSnapshot(std::ostream& os, const std::string& labels) const {
+  auto run_latency = run_latency_.GetSnapshot();
+  WriteSample(os, "onnxruntime_runs_total", "counter", labels, static_cast<double>(run_latency.count));
+  WriteSample(os, "onnxruntime_failed_runs_total", "counter", labels,
+              static_cast<double>(failed_runs_.load(std::memory_order_relaxed)));
+  WriteSample(os, "onnxruntime_graph_executions_total", "counter", labels,
+              static_cast<double>(executions_.load(std::memory_order_relaxed)));
+  WriteSample(os, "onnxruntime_sampled_graph_executions_total", "counter", labels,
+              static_cast<double>(sampled_executions_.load(std::memory_order_relaxed)));
+
+  os << "# TYPE onnxruntime_run_latency_us histogram\n";
+  WriteHistogram(os, "onnxruntime_run_latency_us", labels, run_latency);
+
+  std::lock_guard<OrtMutex> lock(op_histograms_mutex_);
+  if (!op_histograms_.empty()) {
+    os << "# TYPE onnxruntime_op_latency_us histogram\n";
+  }
+  for (const auto& entry : op_histograms_) {
+    std::string op_labels = labels;
+    AppendLabel(op_labels, "op_type", EscapeLabel(entry.first.first));
+    AppendLabel(op_labels, "provider", EscapeLabel(entry.first.second));
+    WriteHistogram(os, "onnxruntime_op_latency_us", op_labels, entry.second->GetSnapshot());
+  }
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Latency histogram that can be updated concurrently without locks.
+ * Bucket i counts latencies up to 2^i microseconds, the last bucket counts everything larger.
+ * Counters are split in shards picked by the recording thread so threads don't contend on the same cache lines.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kNumBuckets = 32;
+
+  struct Snapshot {
+    std::array<uint64_t, kNumBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+  };
+
+  LatencyHistogram() = default;
+
+  void Record(std::chrono::nanoseconds duration) noexcept;
+
+  // Sums all shards. Concurrent updates may or may not be included.
+  Snapshot GetSnapshot() const noexcept;
+
+  // Index of the bucket for a duration.
+  static size_t BucketIndex(std::chrono::nanoseconds duration) noexcept;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LatencyHistogram);
+
+  static constexpr size_t kNumShards = 16;
+
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum_ns{0};
+  };
+
+  std::array<Shard, kNumShards> shards_;
+};
+
+/**
+ * Always-on runtime metrics of an inference session, enabled with the session.enable_metrics config entry.
+ * Run latencies are recorded for every run. Kernel latencies are only recorded for one out of every
+ * op_sampling_interval graph executions to keep the overhead low.
+ * The metrics are exported in the Prometheus text exposition format so a local exporter can serve them as is.
+ */
+class SessionMetrics {
+ public:
+  // op_sampling_interval of 0 disables the kernel latencies.
+  explicit SessionMetrics(uint32_t op_sampling_interval) noexcept;
+
+  // Called at the start of every graph execution (including subgraphs).
+  // Returns true if the kernel latencies of this execution should be recorded.
+  bool SampleExecution() noexcept;
+
+  void RecordRun(std::chrono::nanoseconds duration, bool succeeded) noexcept;
+
+  // Returns the histogram for the kernels of op_type assigned to provider. The histogram lives as long as this
+  // instance. Meant to be looked up once per node when kernels are created, not during execution.
+  LatencyHistogram* GetOrAddOpHistogram(const std::string& op_type, const std::string& provider);
+
+  // Writes the counters and histograms. labels are added to every sample, e.g. session="x"; may be empty.
+  void WriteSnapshot(std::ostream& os, const std::string& labels) const;
+
+  static void WriteHistogram(std::ostream& os, const std::string& name, const std::string& labels,
+                             const LatencyHistogram::Snapshot& snapshot);
+
+  // Writes a single sample, with the # TYPE line if type is not empty.
+  static void WriteSample(std::ostream& os, const std::string& name, const char* type,
+                          const std::string& labels, double value);
+
+  // Escapes a label value.
+  static std::string EscapeLabel(const std::string& value);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionMetrics);
+
+  const uint32_t op_sampling_interval_;
+  std::atomic<uint64_t> executions_{0};
+  std::atomic<uint64_t> sampled_executions_{0};
+  std::atomic<uint64_t> failed_runs_{0};
+  LatencyHistogram run_latency_;
+
+  mutable OrtMutex op_histograms_mutex_;
+  // (op_type, provider) -> histogram. a std::map so the snapshot is sorted.
+  std::map<std::pair<std::string, std::string>, std::unique_ptr<LatencyHistogram>> op_histograms_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
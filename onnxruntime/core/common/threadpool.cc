@@ -649,6 +649,13 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   }
 }
 
+int ThreadPool::QueueDepth(const concurrency::ThreadPool* tp) {
+  if (tp && tp->underlying_threadpool_) {
+    return static_cast<int>(tp->underlying_threadpool_->QueueDepth());
+  }
+  return 0;
+}
+
 void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
   if (tp) {
     tp->StartProfiling();
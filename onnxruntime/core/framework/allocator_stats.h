@@ -22,6 +22,8 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_hits;   // Number of allocations served from per-thread caches (Relevant only for arena based allocators)
+  int64_t bytes_in_thread_caches;  // Number of freed bytes held in per-thread caches. Not included in bytes_in_use.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +37,8 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->bytes_in_thread_caches = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +51,9 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
+       << "InThreadCaches:           " << this->bytes_in_thread_caches << "\n";
     return ss.str();
   }
 };
@@ -11,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -32,6 +33,16 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
   auto device_allocator = info.device_alloc_factory(info.device_id);
 
   if (info.use_arena) {
+    // the arena only requests large regions from the device allocator, so for plain CPU memory those can be mapped
+    // from the OS with huge pages and/or locked in RAM.
+    if ((info.arena_cfg.huge_pages != 0 || info.arena_cfg.lock_memory != 0) &&
+        device_allocator->Info().device.Type() == OrtDevice::CPU &&
+        device_allocator->Info().device.MemType() == OrtDevice::MemType::DEFAULT) {
+      device_allocator = std::make_unique<HugePageAllocator>(std::move(device_allocator),
+                                                             info.arena_cfg.huge_pages,
+                                                             info.arena_cfg.lock_memory != 0);
+    }
+
     size_t max_mem = info.arena_cfg.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : info.arena_cfg.max_mem;
     int initial_chunk_size_bytes = info.arena_cfg.initial_chunk_size_bytes == -1
                                        ? BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES
@@ -77,7 +88,8 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      arena_extend_str,
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
-                                     initial_growth_chunk_size_bytes));
+                                     initial_growth_chunk_size_bytes,
+                                     info.arena_cfg.max_thread_cache_bytes));
     }
   } else {
     return device_allocator;
@@ -3,15 +3,61 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <atomic>
 #include <type_traits>
 
 namespace onnxruntime {
+namespace {
+// Guards ThreadCache::arena so a thread exiting does not race with the destruction of an arena it allocated from.
+OrtMutex& ThreadCacheRegistryLock() {
+  static OrtMutex registry_lock;
+  return registry_lock;
+}
+
+uint64_t NextThreadCacheId() {
+  static std::atomic<uint64_t> next_id{0};
+  return next_id++;
+}
+}  // namespace
+
+struct BFCArena::ThreadCache {
+  explicit ThreadCache(BFCArena* owner) : arena(owner) {}
+
+  // only contended when the arena flushes the cache or another thread frees one of its chunks
+  OrtMutex lock;
+
+  // the owning arena. set to nullptr when the arena is destroyed. guarded by ThreadCacheRegistryLock().
+  BFCArena* arena;
+  // set once the arena no longer uses the cache
+  std::atomic<bool> detached{false};
+
+  // chunks allocated through this cache and currently in use by the client, mapped to the chunk size
+  std::unordered_map<const void*, size_t> live_chunks;
+  // free chunks held by this cache per bin, as pointer and chunk size
+  std::array<std::vector<std::pair<void*, size_t>>, kNumThreadCacheBins> free_chunks;
+  size_t cached_bytes = 0;
+  int64_t num_hits = 0;
+};
+
+BFCArena::ThreadCacheHolder::~ThreadCacheHolder() {
+  std::lock_guard<OrtMutex> registry_lock(ThreadCacheRegistryLock());
+  for (auto& entry : caches) {
+    ThreadCache& cache = *entry.second;
+    if (cache.arena != nullptr && !cache.detached) {
+      std::lock_guard<OrtMutex> lock(cache.arena->lock_);
+      cache.arena->DetachThreadCache(cache);
+    }
+  }
+}
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   size_t max_thread_cache_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -23,11 +69,14 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      max_thread_cache_bytes_(max_thread_cache_bytes),
+      thread_cache_id_(NextThreadCacheId()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
+                     << " max_thread_cache_bytes: " << max_thread_cache_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -75,6 +124,15 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  {
+    // threads exiting after this point must not return their cached chunks to this arena
+    std::lock_guard<OrtMutex> registry_lock(ThreadCacheRegistryLock());
+    for (auto& cache : thread_caches_) {
+      cache->arena = nullptr;
+      cache->detached = true;
+    }
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -247,6 +305,7 @@ void BFCArena::DeallocateChunk(ChunkHandle h) {
   // clean the stream / timestamp when deallocate chunk
   c->stream = nullptr;
   c->stream_timestamp = 0;
+  c->thread_cache = nullptr;
   c->next = free_chunks_list_;
   free_chunks_list_ = h;
 }
@@ -261,9 +320,134 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (max_thread_cache_bytes_ > 0 && size > 0) {
+    size_t rounded_bytes = RoundedBytes(size);
+    if (BinNumForSize(rounded_bytes) < kNumThreadCacheBins) {
+      ThreadCache* cache = GetThreadCache();
+      void* p = AllocateFromThreadCache(*cache, rounded_bytes);
+      if (p != nullptr) {
+        return p;
+      }
+
+      return AllocateRawInternal(size, false, nullptr, false, nullptr, cache);
+    }
+  }
+
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
+BFCArena::ThreadCache* BFCArena::GetThreadCache() {
+  thread_local ThreadCacheHolder holder;
+  for (const auto& entry : holder.caches) {
+    if (entry.first == thread_cache_id_) {
+      return entry.second.get();
+    }
+  }
+
+  // drop the caches of arenas that have been destroyed
+  holder.caches.erase(std::remove_if(holder.caches.begin(), holder.caches.end(),
+                                     [](const auto& entry) { return entry.second->detached.load(); }),
+                      holder.caches.end());
+
+  auto cache = std::make_shared<ThreadCache>(this);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches_.push_back(cache);
+  }
+
+  holder.caches.emplace_back(thread_cache_id_, cache);
+  return cache.get();
+}
+
+void* BFCArena::AllocateFromThreadCache(ThreadCache& cache, size_t rounded_bytes) {
+  std::lock_guard<OrtMutex> cache_lock(cache.lock);
+  auto& free_chunks = cache.free_chunks[BinNumForSize(rounded_bytes)];
+  // most recently freed first as it's most likely to still be in the CPU cache
+  for (auto it = free_chunks.rbegin(); it != free_chunks.rend(); ++it) {
+    if (it->second >= rounded_bytes) {
+      void* p = it->first;
+      size_t chunk_size = it->second;
+      free_chunks.erase(std::next(it).base());
+      cache.cached_bytes -= chunk_size;
+      cache.live_chunks.emplace(p, chunk_size);
+      ++cache.num_hits;
+      return p;
+    }
+  }
+
+  return nullptr;
+}
+
+bool BFCArena::FreeToThreadCache(ThreadCache& cache, void* p) {
+  {
+    std::lock_guard<OrtMutex> cache_lock(cache.lock);
+    auto it = cache.live_chunks.find(p);
+    if (it == cache.live_chunks.end()) {
+      return false;
+    }
+
+    size_t chunk_size = it->second;
+    BinNum bin_num = BinNumForSize(chunk_size);
+    if (bin_num >= kNumThreadCacheBins || chunk_size > max_thread_cache_bytes_) {
+      // let the arena free it. it will be removed from live_chunks there.
+      return false;
+    }
+
+    cache.live_chunks.erase(it);
+    cache.free_chunks[bin_num].emplace_back(p, chunk_size);
+    cache.cached_bytes += chunk_size;
+    if (cache.cached_bytes <= max_thread_cache_bytes_) {
+      return true;
+    }
+  }
+
+  // over the limit. return half of the cache in one go so the arena lock is not taken on every Free.
+  std::lock_guard<OrtMutex> lock(lock_);
+  ReturnThreadCacheChunks(cache, max_thread_cache_bytes_ / 2);
+  return true;
+}
+
+void BFCArena::ReturnThreadCacheChunks(ThreadCache& cache, size_t max_cached_bytes) {
+  std::lock_guard<OrtMutex> cache_lock(cache.lock);
+  // return the largest chunks first
+  for (int bin_num = kNumThreadCacheBins - 1; bin_num >= 0 && cache.cached_bytes > max_cached_bytes; --bin_num) {
+    auto& free_chunks = cache.free_chunks[bin_num];
+    while (!free_chunks.empty() && cache.cached_bytes > max_cached_bytes) {
+      auto [p, chunk_size] = free_chunks.back();
+      free_chunks.pop_back();
+      cache.cached_bytes -= chunk_size;
+
+      ChunkHandle h = region_manager_.get_handle(p);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      ChunkFromHandle(h)->thread_cache = nullptr;
+      FreeAndMaybeCoalesce(h);
+    }
+  }
+}
+
+void BFCArena::DetachThreadCache(ThreadCache& cache) {
+  ReturnThreadCacheChunks(cache, 0);
+
+  {
+    // chunks still in use are freed through the arena from now on
+    std::lock_guard<OrtMutex> cache_lock(cache.lock);
+    for (const auto& live_chunk : cache.live_chunks) {
+      ChunkHandle h = region_manager_.get_handle(live_chunk.first);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      ChunkFromHandle(h)->thread_cache = nullptr;
+    }
+
+    cache.live_chunks.clear();
+    stats_.num_allocs += cache.num_hits;
+    cache.num_hits = 0;
+    cache.detached = true;
+  }
+
+  thread_caches_.erase(std::remove_if(thread_caches_.begin(), thread_caches_.end(),
+                                      [&cache](const auto& c) { return c.get() == &cache; }),
+                       thread_caches_.end());
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -304,7 +488,8 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
                                     bool dump_log_on_failure,
                                     Stream* stream,
                                     bool enable_cross_stream_reusing,
-                                    WaitNotificationFn wait_fn) {
+                                    WaitNotificationFn wait_fn,
+                                    ThreadCache* thread_cache) {
   if (num_bytes == 0) {
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
@@ -317,6 +502,14 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
+  auto register_with_thread_cache = [thread_cache](Chunk* chunk) {
+    if (thread_cache != nullptr) {
+      std::lock_guard<OrtMutex> cache_lock(thread_cache->lock);
+      thread_cache->live_chunks.emplace(chunk->ptr, chunk->size);
+      chunk->thread_cache = thread_cache;
+    }
+  };
+
   std::lock_guard<OrtMutex> lock(lock_);
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num,
@@ -333,6 +526,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (stream)
         chunk->stream_timestamp = stream->GetCurrentTimestamp();
     }
+    register_with_thread_cache(chunk);
     return chunk->ptr;
   }
 
@@ -348,6 +542,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (chunk->stream == nullptr && stream) {
         chunk->stream = stream;
       }
+      register_with_thread_cache(chunk);
       return chunk->ptr;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -371,6 +566,14 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  for (const auto& cache : thread_caches_) {
+    std::lock_guard<OrtMutex> cache_lock(cache->lock);
+    // allocations served by a thread cache never reach the arena
+    stats->num_allocs += cache->num_hits;
+    stats->num_thread_cache_hits += cache->num_hits;
+    stats->bytes_in_use -= static_cast<int64_t>(cache->cached_bytes);
+    stats->bytes_in_thread_caches += static_cast<int64_t>(cache->cached_bytes);
+  }
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -488,6 +691,11 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (max_thread_cache_bytes_ > 0 && FreeToThreadCache(*GetThreadCache(), p)) {
+    return;
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -502,6 +710,10 @@ void BFCArena::Free(void* p) {
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  for (auto& cache : thread_caches_) {
+    ReturnThreadCacheChunks(*cache, 0);
+  }
+
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -570,6 +782,14 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
 
+  // A chunk allocated through a thread cache is being freed by another thread, or is too big to cache.
+  Chunk* c = ChunkFromHandle(h);
+  if (c->thread_cache != nullptr) {
+    std::lock_guard<OrtMutex> cache_lock(c->thread_cache->lock);
+    c->thread_cache->live_chunks.erase(ptr);
+    c->thread_cache = nullptr;
+  }
+
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
 }
@@ -60,6 +60,8 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // per-thread caching is disabled by default
+  static const size_t DEFAULT_MAX_THREAD_CACHE_BYTES = 0;
 
   enum ArenaType {
     BaseArena,
@@ -71,7 +73,8 @@ class BFCArena : public IAllocator {
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           size_t max_thread_cache_bytes = DEFAULT_MAX_THREAD_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -84,6 +87,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // Chunks held in per-thread caches are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -106,11 +110,15 @@ class BFCArena : public IAllocator {
                               WaitNotificationFn /*wait_fn*/) const {}
 
  protected:
+  struct ThreadCache;
+
+  // If thread_cache is not null the returned chunk is registered with it so that it can be cached on Free.
   void* AllocateRawInternal(size_t num_bytes,
                             bool dump_log_on_failure,
                             Stream* stream,
                             bool enable_cross_stream_reusing,
-                            WaitNotificationFn wait_fn);
+                            WaitNotificationFn wait_fn,
+                            ThreadCache* thread_cache = nullptr);
 #ifdef ORT_ENABLE_STREAM
   // for any chunk that associated with target stream, reset it to default (nullptr in stream, timestamp 0)
   // perform coalesce if coalesce_flag is true
@@ -168,6 +176,10 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // The per-thread cache the chunk was allocated through, if any.
+    // Set and cleared with the arena lock held.
+    ThreadCache* thread_cache = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -427,6 +439,41 @@ class BFCArena : public IAllocator {
   // Computes and returns a BinDebugInfo for each Bin.
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info();
 
+  // Per-thread caching of small chunks in front of the arena.
+  //
+  // A thread that frees a chunk it allocated keeps it in its own cache (up to max_thread_cache_bytes_) and serves
+  // later allocations of a similar size from there without taking the arena lock. Cached chunks are in use from
+  // the arena's point of view. When a cache goes over its limit, half of it is returned to the arena in one batch.
+  // A chunk freed by a thread other than the one that allocated it goes back to the arena directly.
+  //
+  // Lock order is ThreadCacheRegistryLock() -> lock_ -> ThreadCache::lock. ThreadCache is defined in bfc_arena.cc.
+  static const int kNumThreadCacheBins = 12;  // chunks up to 1 MB
+
+  // Holds the caches of the current thread, one per arena it allocated from.
+  // Returns the chunks of live arenas when the thread exits.
+  struct ThreadCacheHolder {
+    ThreadCacheHolder() = default;
+    ~ThreadCacheHolder();
+    std::vector<std::pair<uint64_t, std::shared_ptr<ThreadCache>>> caches;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadCacheHolder);
+  };
+
+  // Returns the cache of the current thread for this arena, creating it if needed.
+  ThreadCache* GetThreadCache();
+
+  // Tries to serve an allocation from the cache of the current thread.
+  void* AllocateFromThreadCache(ThreadCache& cache, size_t rounded_bytes);
+
+  // Tries to keep p in the cache of the current thread. Returns false if p was not allocated through it.
+  bool FreeToThreadCache(ThreadCache& cache, void* p);
+
+  // Returns free chunks of the cache to the arena until at most max_cached_bytes are cached.
+  // lock_ must be held.
+  void ReturnThreadCacheChunks(ThreadCache& cache, size_t max_cached_bytes);
+
+  // Returns all chunks of the cache to the arena and stops using it. lock_ must be held.
+  void DetachThreadCache(ThreadCache& cache);
+
   // Structures immutable after construction
   size_t memory_limit_ = 0;
   ArenaExtendStrategy arena_extend_strategy_ = ArenaExtendStrategy::kNextPowerOfTwo;
@@ -506,6 +553,13 @@ class BFCArena : public IAllocator {
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
 
+  // maximum number of bytes a thread can hold in its cache. 0 disables per-thread caching.
+  const size_t max_thread_cache_bytes_;
+  // unique id used to find the cache for this arena in a ThreadCacheHolder. never reused by another arena.
+  const uint64_t thread_cache_id_;
+  // caches of the threads that allocated from this arena. guarded by lock_.
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
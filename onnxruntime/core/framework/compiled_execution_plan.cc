@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/compiled_execution_plan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/common/logging/logging.h"
+#include "core/common/session_metrics.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<CompiledExecutionPlan> CompiledExecutionPlan::Create(const SessionState& session_state,
+                                                                     bool enable_capture) {
+  const auto* execution_plan = session_state.GetExecutionPlan();
+  if (execution_plan == nullptr || execution_plan->NumberOfValidStreams() != 1 ||
+      execution_plan->num_barriers != 0 || !execution_plan->notification_owners.empty()) {
+    return nullptr;
+  }
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  const SequentialExecutionPlan::LogicStream* stream = nullptr;
+  for (const auto& logic_stream : execution_plan->execution_plan) {
+    if (!logic_stream->steps_.empty()) {
+      stream = logic_stream.get();
+    }
+  }
+
+  // without barriers and notifications every step of the stream launches a kernel
+  if (stream->steps_.size() != static_cast<size_t>(graph_viewer.NumberOfNodes())) {
+    return nullptr;
+  }
+
+  std::vector<const OpKernel*> kernels;
+  kernels.reserve(stream->steps_.size());
+  // non tensor values such as sequences may be appended to by the kernels instead of being overwritten,
+  // so they can't stay bound to a captured Run
+  bool all_tensors = true;
+  for (const auto& step : stream->steps_) {
+    const Node* node = graph_viewer.GetNode(step->GetNodeIndex());
+    const OpKernel* kernel = session_state.GetKernel(step->GetNodeIndex());
+    if (node == nullptr || kernel == nullptr ||
+        node->GetExecutionProviderType() != kCpuExecutionProvider ||
+        node->ContainsSubgraph() || kernel->IsAsync() || kernel->KernelDef().OpName() == "YieldOp") {
+      return nullptr;
+    }
+    kernels.push_back(kernel);
+
+    for (const auto* output_def : node->OutputDefs()) {
+      const auto* type = output_def->TypeAsProto();
+      all_tensors = all_tensors && (!output_def->Exists() || (type != nullptr && utils::HasTensorType(*type)));
+    }
+  }
+
+  if (enable_capture && !all_tensors) {
+    LOGS(session_state.Logger(), INFO) << "Run capture is not supported for graphs with non tensor values.";
+    enable_capture = false;
+  }
+
+  return std::unique_ptr<CompiledExecutionPlan>(
+      new CompiledExecutionPlan(session_state, std::move(kernels), enable_capture));
+}
+
+CompiledExecutionPlan::CompiledExecutionPlan(const SessionState& session_state,
+                                             std::vector<const OpKernel*> kernels, bool enable_capture)
+    : session_state_(session_state), kernels_(std::move(kernels)), enable_capture_(enable_capture) {
+}
+
+CompiledExecutionPlan::~CompiledExecutionPlan() = default;
+
+bool CompiledExecutionPlan::Matches(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                    gsl::span<const int> fetch_mlvalue_idxs) const {
+  if (!layout_recorded_ || feed_shapes_.size() != feeds.size() ||
+      !std::equal(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(),
+                  feed_mlvalue_idxs_.begin(), feed_mlvalue_idxs_.end()) ||
+      !std::equal(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end(),
+                  fetch_mlvalue_idxs_.begin(), fetch_mlvalue_idxs_.end())) {
+    return false;
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (!feeds[i].IsTensor() || feeds[i].Get<Tensor>().Shape() != feed_shapes_[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CompiledExecutionPlan::Record(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                   gsl::span<const int> fetch_mlvalue_idxs) {
+  Reset(/*clear_layout*/ true);
+
+  // the values of a compiled Run are bound with UpdateFeeds and UpdateFetches, which need distinct slots
+  const auto& initializers = session_state_.GetInitializedTensors();
+  for (int fetch_idx : fetch_mlvalue_idxs) {
+    if (initializers.count(fetch_idx) != 0 ||
+        std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), fetch_idx) != feed_mlvalue_idxs.end()) {
+      return;
+    }
+  }
+
+  std::vector<TensorShape> feed_shapes;
+  feed_shapes.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    if (!feed.IsTensor()) {
+      return;
+    }
+    feed_shapes.push_back(feed.Get<Tensor>().Shape());
+  }
+
+  feed_mlvalue_idxs_.assign(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end());
+  fetch_mlvalue_idxs_.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+  feed_shapes_ = std::move(feed_shapes);
+  layout_recorded_ = true;
+}
+
+Status CompiledExecutionPlan::Compile(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                      gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches) {
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  // the frame allocates the memory pattern block for the feed shapes, which is reused by every compiled Run
+  frame_ = std::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                                            /*device_streams*/ nullptr,
+#endif
+                                            session_state_);
+
+  // no memory pattern was generated for these shapes yet, let the regular executor trace one first
+  if (frame_->HasMemoryPatternPlanner()) {
+    frame_.reset();
+    return Status::OK();
+  }
+
+  const auto& initializers = session_state_.GetInitializedTensors();
+  const int max_idx = session_state_.GetOrtValueNameIdxMap().MaxIdx();
+  run_value_idxs_.clear();
+  for (int idx = 0; idx <= max_idx; ++idx) {
+    if (initializers.count(idx) == 0 ||
+        std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), idx) != feed_mlvalue_idxs.end()) {
+      run_value_idxs_.push_back(idx);
+    }
+  }
+
+  nodes_.reserve(kernels_.size());
+  for (const OpKernel* kernel : kernels_) {
+    nodes_.push_back({kernel,
+                      std::make_unique<OpKernelContextInternal>(session_state_, *frame_, *kernel,
+                                                                session_state_.Logger(), kernel_terminate_flag_,
+                                                                /*stream*/ nullptr),
+                      session_state_.GetNodeLatencyHistogram(kernel->Node().Index())});
+  }
+
+  return Status::OK();
+}
+
+Status CompiledExecutionPlan::Execute(const bool& terminate_flag) {
+  kernel_terminate_flag_ = terminate_flag;
+
+  auto* session_metrics = session_state_.GetSessionMetrics();
+  const bool sample_kernel_latencies = session_metrics != nullptr && session_metrics->SampleExecution();
+
+  for (auto& node : nodes_) {
+    if (terminate_flag) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    const auto begin_time = sample_kernel_latencies ? std::chrono::steady_clock::now()
+                                                    : std::chrono::steady_clock::time_point{};
+    Status status;
+    ORT_TRY {
+      status = node.kernel->Compute(node.context.get());
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!status.IsOK()) {
+      const auto& kernel_node = node.kernel->Node();
+      std::ostringstream ss;
+      ss << "Non-zero status code returned while running " << kernel_node.OpType() << " node. Name:'"
+         << kernel_node.Name() << "' Status Message: " << status.ErrorMessage();
+      return Status(status.Category(), status.Code(), ss.str());
+    }
+
+    if (sample_kernel_latencies && node.latency_histogram != nullptr) {
+      node.latency_histogram->Record(std::chrono::steady_clock::now() - begin_time);
+    }
+  }
+
+  return Status::OK();
+}
+
+static bool AllTensors(gsl::span<const OrtValue> values) {
+  return std::all_of(values.begin(), values.end(), [](const OrtValue& value) { return value.IsTensor(); });
+}
+
+bool CompiledExecutionPlan::UsesCapturedBuffers(gsl::span<const OrtValue> feeds,
+                                                gsl::span<const OrtValue> fetches) const {
+  if (feeds.size() != captured_feed_buffers_.size() || fetches.size() != captured_fetch_buffers_.size() ||
+      !AllTensors(fetches)) {
+    return false;
+  }
+
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    if (feeds[i].Get<Tensor>().DataRaw() != captured_feed_buffers_[i]) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0, end = fetches.size(); i < end; ++i) {
+    // the replayed kernels write the shape of the captured output
+    const Tensor& fetch = fetches[i].Get<Tensor>();
+    if (fetch.DataRaw() != captured_fetch_buffers_[i] || fetch.Shape() != captured_fetch_shapes_[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CompiledExecutionPlan::Capture(gsl::span<const OrtValue> feeds, gsl::span<const OrtValue> fetches) {
+  captured_feed_buffers_.clear();
+  for (const auto& feed : feeds) {
+    captured_feed_buffers_.push_back(feed.Get<Tensor>().DataRaw());
+  }
+
+  captured_fetch_buffers_.clear();
+  captured_fetch_shapes_.clear();
+  for (const auto& fetch : fetches) {
+    captured_fetch_buffers_.push_back(fetch.Get<Tensor>().DataRaw());
+    captured_fetch_shapes_.push_back(fetch.Get<Tensor>().Shape());
+  }
+}
+
+void CompiledExecutionPlan::ReleaseRunValues() {
+  for (int idx : run_value_idxs_) {
+    ORT_IGNORE_RETURN_VALUE(frame_->ReleaseMLValue(idx));
+  }
+}
+
+void CompiledExecutionPlan::Reset(bool clear_layout) {
+  // the kernel contexts refer to the frame
+  nodes_.clear();
+  frame_.reset();
+  run_value_idxs_.clear();
+  captured_ = false;
+  captured_feed_buffers_.clear();
+  captured_fetch_buffers_.clear();
+  captured_fetch_shapes_.clear();
+
+  if (clear_layout) {
+    feed_mlvalue_idxs_.clear();
+    fetch_mlvalue_idxs_.clear();
+    feed_shapes_.clear();
+    layout_recorded_ = false;
+  }
+}
+
+Status CompiledExecutionPlan::TryExecute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                         gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                                         const bool& terminate_flag, bool& executed) {
+  executed = false;
+
+  std::unique_lock<OrtMutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || disabled_) {
+    return Status::OK();
+  }
+
+  if (!Matches(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs)) {
+    Record(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs);
+    return Status::OK();
+  }
+
+  // the outputs can only stay bound to the frame if the caller owns them, e.g. bound with IOBinding
+  const bool can_capture = enable_capture_ && !fetches.empty() && AllTensors(fetches);
+
+  if (!frame_) {
+    auto status = Compile(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches);
+    if (!status.IsOK() || !frame_) {
+      Reset(/*clear_layout*/ false);
+      return Status::OK();
+    }
+  } else if (captured_ && UsesCapturedBuffers(feeds, fetches)) {
+    // replay. all the values are still bound to the addresses of the captured Run.
+  } else {
+    if (captured_) {
+      ReleaseRunValues();
+      captured_ = false;
+    }
+    frame_->UpdateFeeds(feed_mlvalue_idxs, feeds);
+    frame_->UpdateFetches(fetch_mlvalue_idxs, fetches, session_state_.GetInitializedTensors());
+  }
+
+  auto status = Execute(terminate_flag);
+  if (status.IsOK()) {
+    status = frame_->GetOutputs(fetches);
+  }
+
+  if (status.IsOK() && !captured_ && can_capture) {
+    Capture(feeds, fetches);
+    captured_ = true;
+  } else if (!status.IsOK() || !captured_) {
+    ReleaseRunValues();
+    captured_ = false;
+  }
+
+  if (!status.IsOK() && !terminate_flag) {
+    LOGS(session_state_.Logger(), WARNING) << "Compiled execution failed, falling back to the regular executor. "
+                                           << status.ErrorMessage();
+    disabled_ = true;
+    Reset(/*clear_layout*/ true);
+    return Status::OK();
+  }
+
+  executed = true;
+  return status;
+}
+
+}  // namespace onnxruntime
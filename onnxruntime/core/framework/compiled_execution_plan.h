@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class ExecutionFrame;
+class OpKernel;
+class OpKernelContextInternal;
+class SessionState;
+
+namespace profiling {
+class LatencyHistogram;
+}
+
+/**
+Execution of a graph with fixed input shapes as a flat list of kernel calls.
+
+The first Run with a given set of input shapes goes through the regular executor, which generates the memory
+pattern for the shapes. The next Run with the same shapes builds an ExecutionFrame that keeps the memory pattern
+block alive and an OpKernelContextInternal per node, and every Run after that only rebinds the feeds and fetches and
+calls the kernels in order. No per run stream execution context, kernel contexts, reference counting of the
+intermediate values or allocation of the pattern block is left.
+
+With capture enabled, a Run whose outputs are preallocated by the caller (e.g. bound with IOBinding) is captured:
+the frame keeps every value bound to the address it had, and a later Run with the same input and output buffers
+replays the kernel calls without rebinding or allocating anything. Like a CUDA graph the captured Run holds on to
+the input and output buffers, and the caller updates the inputs in place. Other buffers end the capture.
+
+Only graphs with a single stream on the CPU execution provider and without control flow nodes are compiled.
+If the input shapes change the compiled state is dropped and built again for the new shapes.
+If a kernel fails while running compiled, e.g. because an intermediate shape depends on the input data, compiled
+execution is disabled for the session and the Run is repeated with the regular executor.
+*/
+class CompiledExecutionPlan {
+ public:
+  ~CompiledExecutionPlan();
+
+  // Returns nullptr if the graph of the session state can't be executed as a compiled plan.
+  static std::unique_ptr<CompiledExecutionPlan> Create(const SessionState& session_state, bool enable_capture);
+
+  /**
+  Execute the graph if the compiled state matches the feeds.
+  @param executed Set to false if the graph was not executed and the caller must use the regular executor.
+  The returned status is only meaningful if executed is true.
+  Only one Run at a time executes compiled; concurrent Runs use the regular executor.
+  */
+  Status TryExecute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                    gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                    const bool& terminate_flag, bool& executed);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CompiledExecutionPlan);
+
+ private:
+  struct CompiledNode {
+    const OpKernel* kernel;
+    std::unique_ptr<OpKernelContextInternal> context;
+    profiling::LatencyHistogram* latency_histogram;
+  };
+
+  CompiledExecutionPlan(const SessionState& session_state, std::vector<const OpKernel*> kernels,
+                        bool enable_capture);
+
+  // Whether the feeds and fetches have the layout and shapes the compiled state was built for.
+  bool Matches(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+               gsl::span<const int> fetch_mlvalue_idxs) const;
+
+  // Remember the layout and shapes of a Run so the next Run with the same ones gets compiled.
+  void Record(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+              gsl::span<const int> fetch_mlvalue_idxs);
+
+  Status Compile(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                 gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches);
+
+  Status Execute(const bool& terminate_flag);
+
+  // Whether the feeds and fetches are the buffers of the captured Run.
+  bool UsesCapturedBuffers(gsl::span<const OrtValue> feeds, gsl::span<const OrtValue> fetches) const;
+
+  // Record the buffers of the Run that just completed, whose values stay bound to the frame.
+  void Capture(gsl::span<const OrtValue> feeds, gsl::span<const OrtValue> fetches);
+
+  // Release the feeds, fetches and intermediate values so no buffer of the caller is held between Runs.
+  void ReleaseRunValues();
+
+  // Drop the compiled state. The recorded layout is kept unless clear_layout is set.
+  void Reset(bool clear_layout);
+
+  const SessionState& session_state_;
+  // kernels in execution order
+  const std::vector<const OpKernel*> kernels_;
+  const bool enable_capture_;
+
+  OrtMutex mutex_;
+  bool disabled_ = false;
+
+  bool layout_recorded_ = false;
+  std::vector<int> feed_mlvalue_idxs_;
+  std::vector<int> fetch_mlvalue_idxs_;
+  std::vector<TensorShape> feed_shapes_;
+
+  std::unique_ptr<ExecutionFrame> frame_;
+  std::vector<CompiledNode> nodes_;
+  // indices of the values that are not initializers, released after every Run
+  std::vector<int> run_value_idxs_;
+  // addresses of the feeds and fetches of the captured Run
+  bool captured_ = false;
+  std::vector<const void*> captured_feed_buffers_;
+  std::vector<const void*> captured_fetch_buffers_;
+  std::vector<TensorShape> captured_fetch_shapes_;
+  // the kernel contexts refer to this flag. it is set from the terminate flag of the Run.
+  bool kernel_terminate_flag_ = false;
+};
+
+}  // namespace onnxruntime
@@ -3,8 +3,53 @@
 // Licensed under the MIT License.
 #include "core/framework/copy.h"
 
+#include <algorithm>
+
+#if defined(_M_AMD64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define ORT_COPY_USE_STREAMING_STORES
+#endif
+
 namespace onnxruntime {
 
+namespace strided_copy_detail {
+
+void CopyBytesNonTemporal(void* dst, const void* src, size_t num_bytes) {
+#if defined(ORT_COPY_USE_STREAMING_STORES)
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+
+  // streaming stores need a 16 byte aligned destination
+  size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+  head = std::min(head, num_bytes);
+  memcpy(d, s, head);
+  d += head;
+  s += head;
+  num_bytes -= head;
+
+  for (; num_bytes >= 64; num_bytes -= 64) {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+    __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+    __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+    d += 64;
+    s += 64;
+  }
+
+  // make the streaming stores visible before the thread pool signals completion
+  _mm_sfence();
+  memcpy(d, s, num_bytes);
+#else
+  memcpy(dst, src, num_bytes);
+#endif
+}
+
+}  // namespace strided_copy_detail
+
 TensorShapeVector StridesForTensor(const Tensor& tensor) {
   const auto& shape = tensor.Shape();
   TensorShapeVector strides(shape.NumDimensions());
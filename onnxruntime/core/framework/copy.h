@@ -19,6 +19,15 @@ TensorShapeVector StridesForTensor(const Tensor& tensor);
 
 namespace strided_copy_detail {
 
+// Copies with at least this many bytes in total use non-temporal stores for their large contiguous spans.
+// The destination is then too big to stay in the cache anyway, and skipping it avoids both the read for ownership
+// of the destination lines and the eviction of the data the surrounding kernels work on.
+constexpr int64_t kNonTemporalCopyMinTotalBytes = 8 * 1024 * 1024;
+constexpr std::ptrdiff_t kNonTemporalCopyMinSpanBytes = 4096;
+
+// memcpy with non-temporal stores where the platform supports them, plain memcpy otherwise.
+void CopyBytesNonTemporal(void* dst, const void* src, size_t num_bytes);
+
 template <typename T>
 void Copy1DNonContiguous(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count) {
   for (std::ptrdiff_t i = 0; i < count; i++) {
@@ -29,22 +38,29 @@ void Copy1DNonContiguous(T* dst, int64_t dst_stride, const T* src, int64_t src_s
 }
 
 template <typename T>
-void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count) {
+void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count, bool non_temporal = false) {
   if constexpr (std::is_same_v<std::string, T>) {
+    ORT_UNUSED_PARAMETER(non_temporal);
     Copy1DNonContiguous(dst, 1, src, 1, count);
   } else {
-    memcpy(dst, src, count * sizeof(T));
+    if (non_temporal && count * static_cast<std::ptrdiff_t>(sizeof(T)) >= kNonTemporalCopyMinSpanBytes) {
+      CopyBytesNonTemporal(dst, src, count * sizeof(T));
+    } else {
+      memcpy(dst, src, count * sizeof(T));
+    }
   }
 }
 
 template <typename T>
-void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count) {
+void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count,
+            bool non_temporal = false) {
   if constexpr (std::is_same_v<std::string, T>) {
     // strings should always be copied using the for loop
+    ORT_UNUSED_PARAMETER(non_temporal);
     Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
   } else {
     if (dst_stride == 1 && src_stride == 1) {
-      Copy1DContiguous(dst, src, count);
+      Copy1DContiguous(dst, src, count, non_temporal);
     } else {
       Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
     }
@@ -104,6 +120,12 @@ struct NdCounter {
 };
 }  // namespace strided_copy_detail
 
+/*
+    Copy copy_shape elements from src to dst. The element at index i is read from src[sum(i[d] * src_strides[d])] and
+    written to dst[sum(i[d] * dst_strides[d])]. Strides may be 0 (e.g. to repeat the source, as Tile does) or negative.
+
+    Contiguous dimensions are coalesced first, then the copy is split across the thread pool by its cost.
+*/
 template <typename T>
 void StridedCopy(concurrency::ThreadPool* thread_pool,
                  T* dst,
@@ -138,6 +160,9 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
   }
 
   const std::size_t dims = copy_shape.size();
+  const bool non_temporal = !std::is_same_v<std::string, T> &&
+                            total_num_elements_to_copy * static_cast<int64_t>(sizeof(T)) >=
+                                strided_copy_detail::kNonTemporalCopyMinTotalBytes;
 
   // TODOs for when we have strided tensors:
   // - Reorder dimensions so that we iterate along the smallest strides first
@@ -157,7 +182,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
     concurrency::ThreadPool::TryParallelFor(
         thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [src_stride, dst_stride, dst, src, contiguous_span_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        [src_stride, dst_stride, dst, src, contiguous_span_size, non_temporal](std::ptrdiff_t first,
+                                                                              std::ptrdiff_t last) {
           // get the current inner and outer index
           std::ptrdiff_t inner = first % contiguous_span_size;
           std::ptrdiff_t outer = first / contiguous_span_size;
@@ -170,7 +196,7 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
             auto elements_to_copy = contiguous_span_size - inner;
             // never copy more than what is in our partition
             elements_to_copy = std::min<std::ptrdiff_t>(elements_to_copy, last - first);
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy, non_temporal);
             inner = 0;
             outer++;
             first += elements_to_copy;
@@ -182,7 +208,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
 
           // Step 2: copy contiguous span by contiguous span until we reach the penultimate span
           while (first < last - contiguous_span_size) {
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size,
+                                                     non_temporal);
             dst_idx += dst_stride;
             src_idx += src_stride;
             first += contiguous_span_size;
@@ -191,7 +218,7 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
           // element in our partition
           ORT_ENFORCE(last >= first);
           auto last_span_size = last - first;
-          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size);
+          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size, non_temporal);
         });
   } else {
     // enforce that the lambda doesn't change anything
@@ -202,8 +229,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
     concurrency::ThreadPool::TryParallelFor(
         thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [&const_copy_shape, &const_dst_strides, dst, src, &const_src_strides, dims](std::ptrdiff_t first,
-                                                                                    std::ptrdiff_t last) {
+        [&const_copy_shape, &const_dst_strides, dst, src, &const_src_strides, dims,
+         non_temporal](std::ptrdiff_t first, std::ptrdiff_t last) {
           strided_copy_detail::NdCounter counter(const_copy_shape, first, last);
 
           auto last_dst_stride = const_dst_strides[dims - 1];
@@ -219,7 +246,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
               src_idx += static_cast<std::ptrdiff_t>(counter.current_index[dim] * const_src_strides[dim]);
             }
             // we can copy until the current dimension is done (or until we hit the last element we are trying to copy)
-            strided_copy_detail::Copy1D<T>(dst + dst_idx, last_dst_stride, src + src_idx, last_src_stride, iter_size);
+            strided_copy_detail::Copy1D<T>(dst + dst_idx, last_dst_stride, src + src_idx, last_src_stride, iter_size,
+                                           non_temporal);
 
             counter.Step(iter_size);
             iter_size = counter.NextStepSize();
@@ -229,6 +257,17 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
   }
 }
 
+// Copy count contiguous elements, split across the thread pool if the copy is large enough.
+template <typename T>
+void ParallelCopy(concurrency::ThreadPool* thread_pool, T* dst, const T* src, std::ptrdiff_t count) {
+  if (count <= 0) {
+    return;
+  }
+
+  const TensorShapeVector strides{1};
+  StridedCopy<T>(thread_pool, dst, strides, TensorShape({static_cast<int64_t>(count)}), src, strides);
+}
+
 // call StridedCopy if there is a type with the same size as T in the set of EnabledTypes
 // e.g. if uint32_t is enabled all 4 byte types are supported
 template <typename EnabledTypes, typename T>
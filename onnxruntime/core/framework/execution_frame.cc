@@ -65,7 +65,6 @@ Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
 }
 #endif
 
-#ifdef ENABLE_TRAINING
 void IExecutionFrame::UpdateFeeds(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds) {
   ORT_ENFORCE(feed_mlvalue_idxs.size() == feeds.size());
 
@@ -114,6 +113,7 @@ void IExecutionFrame::UpdateFetches(gsl::span<const int> fetch_mlvalue_idxs,
   }
 }
 
+#ifdef ENABLE_TRAINING
 Status IExecutionFrame::GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches) {
   auto num_fetches = fetch_mlvalue_idxs.size();
 
@@ -549,7 +549,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
           // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // with shape buckets the pattern may have been generated for a larger shape in the same bucket,
+          // in which case the block reserved for this value is big enough to hold it.
+          if (block->size_ == size ||
+              (block->size_ > size && session_state_.GetMemoryPatternUsesShapeBuckets())) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
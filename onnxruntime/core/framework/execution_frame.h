@@ -59,13 +59,15 @@ class IExecutionFrame {
   Status SetOutputMLValue(int index, const OrtValue& ort_value);
 #endif
 
-#ifdef ENABLE_TRAINING
-  // Referenced by PartialGraphExecutionState which is applicable when using ORTModule.
-  // These wont be needed when using ORT Training APIs
+  // Bind new feeds and fetches to a frame that is reused across executions. Used by PartialGraphExecutionState
+  // (ORTModule) and CompiledExecutionPlan. The slots must have been released first.
   void UpdateFeeds(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds);
   void UpdateFetches(gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
-
                      const std::unordered_map<int, OrtValue>& initializers);
+
+#ifdef ENABLE_TRAINING
+  // Referenced by PartialGraphExecutionState which is applicable when using ORTModule.
+  // These wont be needed when using ORT Training APIs
   Status GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches);
 #endif
 
@@ -229,7 +231,8 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  // Shared with the session state cache, which may evict it while this frame is alive.
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -243,7 +246,7 @@ class ExecutionFrame final : public IExecutionFrame {
   // by i, if the key i exists.
   // inferred_shapes_ is generated together with mem_patterns_.
   // It is never updated after creation
-  const InlinedHashMap<int, TensorShape>* inferred_shapes_{nullptr};
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes_;
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Size of virtual memory allocated before any kernel execution.
@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <mutex>
+
+#include "core/common/logging/logging.h"
+#include "core/mlas/inc/mlas.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kHugePageSize = size_t{2} * 1024 * 1024;
+constexpr size_t kGiantPageSize = size_t{1024} * 1024 * 1024;
+
+size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+#if defined(__linux__)
+// GEMM kernels may read a little past the end of a buffer, so every region is followed by a readable guard of
+// normal pages. Keeping it out of the region means a power of two region isn't rounded up to one more huge page.
+size_t GuardSize() {
+  static const size_t guard_size = RoundUp(MLAS_SYMM_QGEMM_BUF_OVERRUN, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+  return guard_size;
+}
+
+// Maps size bytes of normal pages starting on an alignment boundary, followed by the guard.
+uint8_t* MapAlignedRange(size_t size, size_t alignment) {
+  const size_t reserve_size = size + GuardSize() + alignment;
+  auto* base = static_cast<uint8_t*>(mmap(nullptr, reserve_size, PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (base == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto* p = reinterpret_cast<uint8_t*>(RoundUp(reinterpret_cast<uintptr_t>(base), alignment));
+  const size_t head = static_cast<size_t>(p - base);
+  const size_t tail = reserve_size - head - size - GuardSize();
+  if (head > 0) {
+    munmap(base, head);
+  }
+  if (tail > 0) {
+    munmap(p + size + GuardSize(), tail);
+  }
+  return p;
+}
+#endif
+}  // namespace
+
+HugePageAllocator::HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, int huge_pages,
+                                     bool lock_memory)
+    : IAllocator(fallback_allocator->Info()),
+      fallback_allocator_(std::move(fallback_allocator)),
+      mode_(static_cast<Mode>(huge_pages)),
+      lock_memory_(lock_memory) {
+  ORT_ENFORCE(huge_pages >= static_cast<int>(Mode::kOff) && huge_pages <= static_cast<int>(Mode::kExplicit1GB),
+              "Invalid huge_pages value: ", huge_pages);
+  if (!IsSupported()) {
+    LOGS_DEFAULT(WARNING) << "Huge pages and memory locking for arena regions are not supported on this platform. "
+                             "Regions will be allocated with the default CPU allocator.";
+  }
+}
+
+HugePageAllocator::~HugePageAllocator() {
+#if defined(__linux__)
+  // regions are normally returned by the arena before it releases us, but don't leak the mappings if not.
+  for (const auto& region : mapped_regions_) {
+    UnmapRegion(region.first, region.second);
+  }
+#endif
+}
+
+bool HugePageAllocator::IsSupported() {
+#if defined(__linux__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void* HugePageAllocator::MapRegion(size_t size, size_t& mapped_size) {
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+  if (mode_ == Mode::kExplicit2MB || mode_ == Mode::kExplicit1GB) {
+    size_t page_size = kHugePageSize;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+    // a 1 GB page for a smaller region would mostly be wasted, so those use 2 MB pages.
+    if (mode_ == Mode::kExplicit1GB && size >= kGiantPageSize) {
+      page_size = kGiantPageSize;
+      flags |= (30 << MAP_HUGE_SHIFT);
+    } else {
+      flags |= (21 << MAP_HUGE_SHIFT);
+    }
+#endif
+    mapped_size = RoundUp(size, page_size);
+
+    // reserve the range with normal pages first, then replace the region with huge pages so the guard follows it.
+    uint8_t* p = MapAlignedRange(mapped_size, page_size);
+    if (p != nullptr) {
+      if (mmap(p, mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0) != MAP_FAILED) {
+        return p;
+      }
+      UnmapRegion(p, mapped_size);
+    }
+
+    if (!logged_huge_page_fallback_) {
+      logged_huge_page_fallback_ = true;
+      LOGS_DEFAULT(WARNING) << "Failed to map " << mapped_size << " bytes of explicit huge pages. "
+                            << "Check the pages reserved in /proc/sys/vm/nr_hugepages. "
+                            << "Falling back to transparent huge pages.";
+    }
+  }
+#endif
+
+  // the kernel can only back aligned 2 MB ranges with a huge page, so the region starts on a huge page boundary.
+  mapped_size = RoundUp(size, kHugePageSize);
+  uint8_t* p = MapAlignedRange(mapped_size, kHugePageSize);
+  if (p == nullptr) {
+    return nullptr;
+  }
+
+#if defined(MADV_HUGEPAGE)
+  if (mode_ != Mode::kOff) {
+    // advisory only. fails harmlessly if THP is disabled system-wide.
+    madvise(p, mapped_size, MADV_HUGEPAGE);
+  }
+#endif
+
+  return p;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  mapped_size = 0;
+  return nullptr;
+#endif
+}
+
+void HugePageAllocator::UnmapRegion(void* p, size_t mapped_size) {
+#if defined(__linux__)
+  // the region and its guard may be different kinds of mappings, so they're unmapped separately.
+  munmap(p, mapped_size);
+  if (GuardSize() > 0) {
+    munmap(static_cast<uint8_t*>(p) + mapped_size, GuardSize());
+  }
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(mapped_size);
+#endif
+}
+
+void* HugePageAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+
+  size_t mapped_size = 0;
+  void* p = MapRegion(size, mapped_size);
+  if (p == nullptr) {
+    return fallback_allocator_->Alloc(size);
+  }
+
+#if defined(__linux__)
+  if (lock_memory_ && mlock(p, mapped_size) != 0 && !logged_lock_failure_) {
+    logged_lock_failure_ = true;
+    LOGS_DEFAULT(WARNING) << "Failed to lock " << mapped_size << " bytes of arena memory. "
+                          << "Check RLIMIT_MEMLOCK (ulimit -l). The region will be used unlocked.";
+  }
+#endif
+
+  mapped_regions_.emplace(p, mapped_size);
+  return p;
+}
+
+void HugePageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = mapped_regions_.find(p);
+    if (it != mapped_regions_.end()) {
+      // munmap also releases any mlock on the range
+      UnmapRegion(it->first, it->second);
+      mapped_regions_.erase(it);
+      return;
+    }
+  }
+
+  fallback_allocator_->Free(p);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Allocator for the regions of a CPU arena that maps them directly from the OS so they can be backed by huge pages
+// and optionally locked in RAM. The arena only asks its device allocator for large regions, so each allocation is
+// rounded up to a huge page boundary and followed by a small guard of normal pages. Falls back to the wrapped
+// allocator if the OS can't satisfy the request or the platform doesn't support it.
+class HugePageAllocator : public IAllocator {
+ public:
+  // Values of OrtArenaCfg::huge_pages
+  enum class Mode : int {
+    kOff = 0,
+    kTransparent = 1,  // madvise(MADV_HUGEPAGE)
+    kExplicit2MB = 2,  // MAP_HUGETLB with 2 MB pages
+    kExplicit1GB = 3,  // MAP_HUGETLB with 1 GB pages
+  };
+
+  HugePageAllocator(std::unique_ptr<IAllocator> fallback_allocator, int huge_pages, bool lock_memory);
+  ~HugePageAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  // Whether regions can be mapped by this allocator on the current platform.
+  static bool IsSupported();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HugePageAllocator);
+
+  void* MapRegion(size_t size, size_t& mapped_size);
+  static void UnmapRegion(void* p, size_t mapped_size);
+
+  std::unique_ptr<IAllocator> fallback_allocator_;
+  const Mode mode_;
+  const bool lock_memory_;
+  bool logged_huge_page_fallback_ = false;
+  bool logged_lock_failure_ = false;
+
+  OrtMutex lock_;
+  // regions mapped by this allocator and their mapped size. anything else came from fallback_allocator_.
+  std::unordered_map<void*, size_t> mapped_regions_;
+};
+
+}  // namespace onnxruntime
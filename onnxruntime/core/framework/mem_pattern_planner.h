@@ -16,7 +16,10 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <list>
+#include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
 #include "core/framework/allocation_planner.h"
@@ -140,6 +143,8 @@ class MemPatternPlanner {
       return;
     }
 
+    const size_t alloc_time = trace_time_++;
+
     size_t current = 0;
     size_t waste_bytes = std::numeric_limits<size_t>::max();
     size_t best_offset = 0;
@@ -175,6 +180,7 @@ class MemPatternPlanner {
     // the maximum size of the buffer.
     buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
     allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
+    allocs_.back().alloc_time_ = alloc_time;
     std::list<int>::iterator best_fit_it = blocks_.end();
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].block_.offset_ < best_offset)
@@ -194,6 +200,7 @@ class MemPatternPlanner {
 
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
+        allocs_[*it].free_time_ = trace_time_++;
         blocks_.erase(it);
         break;
       }
@@ -240,15 +247,97 @@ class MemPatternPlanner {
       pattern.patterns_.insert_or_assign(alloc.index_, alloc.block_);
     }
 
+    // The offsets above were chosen online in allocation order. Now that the lifetime of every allocation is
+    // known, re-plan them offline and use that layout if it needs a smaller buffer.
+    if (!using_counters_) {
+      InlinedVector<MemoryBlock> blocks;
+      size_t peak_size = PlanGreedyBySize(blocks);
+      if (peak_size < pattern.peak_size_) {
+        pattern.peak_size_ = peak_size;
+        for (size_t i = 0; i < allocs_.size(); ++i) {
+          pattern.patterns_.insert_or_assign(allocs_[i].index_, blocks[i]);
+        }
+      }
+    }
+
     return pattern;
   }
 
  private:
+  // Greedy-by-size planning: place the allocations from largest to smallest, each at the best fitting gap between
+  // the already placed allocations whose lifetimes overlap with it. Returns the resulting buffer size.
+  // Must be called with lock_ held.
+  size_t PlanGreedyBySize(InlinedVector<MemoryBlock>& blocks) const {
+    blocks.assign(allocs_.size(), MemoryBlock(0, 0));
+
+    InlinedVector<size_t> order;
+    order.reserve(allocs_.size());
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      if (allocs_[i].block_.size_ > 0) {
+        order.push_back(i);
+      }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].block_.size_ > allocs_[rhs].block_.size_;
+    });
+
+    auto lifetimes_overlap = [this](size_t lhs, size_t rhs) {
+      return allocs_[lhs].alloc_time_ < allocs_[rhs].free_time_ && allocs_[rhs].alloc_time_ < allocs_[lhs].free_time_;
+    };
+
+    // indices of the placed allocations, sorted by offset
+    InlinedVector<size_t> placed;
+    placed.reserve(order.size());
+    SafeInt<size_t> peak_size{0};
+
+    for (size_t i : order) {
+      const size_t size = allocs_[i].block_.size_;
+      size_t current = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      size_t best_offset = 0;
+      bool best_offset_found = false;
+
+      for (size_t j : placed) {
+        if (!lifetimes_overlap(i, j)) {
+          continue;
+        }
+
+        if (blocks[j].offset_ >= current) {
+          auto gap = blocks[j].offset_ - current;
+          if (gap >= size && (gap - size) < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+
+        current = std::max(current, blocks[j].offset_ + blocks[j].size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      blocks[i] = MemoryBlock(best_offset, size);
+      peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + size);
+
+      auto insert_pos = std::upper_bound(placed.begin(), placed.end(), best_offset,
+                                         [&blocks](size_t offset, size_t j) { return offset < blocks[j].offset_; });
+      placed.insert(insert_pos, i);
+    }
+
+    return peak_size;
+  }
+
   struct OrtValueAllocationBlock {
     int index_{-1};
     MemoryBlock block_;
     const AllocPlanPerValue::ProgramCounter* counter_{nullptr};
     bool reuse_{false};
+    // trace_time_ when the allocation was traced and freed. only set if not using counters.
+    size_t alloc_time_{0};
+    size_t free_time_{std::numeric_limits<size_t>::max()};
     OrtValueAllocationBlock() = default;
     OrtValueAllocationBlock(int index, const MemoryBlock& block) : index_(index), block_(block), reuse_{false} {}
     OrtValueAllocationBlock(int index, const AllocPlanPerValue::ProgramCounter& counter, const MemoryBlock& block)
@@ -260,6 +349,8 @@ class MemPatternPlanner {
   // blocks_ the list of currently allocated memory blocks, sorted in order of their offset
   std::list<int> blocks_;
   SafeInt<size_t> buffer_size_{0};
+  // logical clock advanced by each traced allocation and free, used to derive lifetimes
+  size_t trace_time_{0};
   bool using_counters_;
   mutable OrtMutex lock_;
 };
@@ -10,6 +10,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/compiled_execution_plan.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
@@ -180,6 +181,9 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    auto* session_metrics = session_state_.GetSessionMetrics();
+    sample_kernel_latencies_ = session_metrics != nullptr && session_metrics->SampleExecution();
+
     auto& logger = session_state_.Logger();
     LOGS(logger, VERBOSE) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -250,6 +254,8 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // whether kernel latencies are recorded in the session metrics for this execution
+  bool sample_kernel_latencies_ = false;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -334,6 +340,13 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (session_scope_.sample_kernel_latencies_) {
+      latency_histogram_ = session_state_.GetNodeLatencyHistogram(kernel_.Node().Index());
+      if (latency_histogram_ != nullptr) {
+        metrics_begin_time_ = std::chrono::steady_clock::now();
+      }
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -359,6 +372,10 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    if (latency_histogram_ != nullptr) {
+      latency_histogram_->Record(std::chrono::steady_clock::now() - metrics_begin_time_);
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
@@ -407,6 +424,8 @@ class KernelScope {
 
  private:
   TimePoint kernel_begin_time_;
+  profiling::LatencyHistogram* latency_histogram_ = nullptr;
+  std::chrono::steady_clock::time_point metrics_begin_time_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -530,6 +549,17 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                                    const bool& terminate_flag,
                                    const bool only_execute_path_to_fetches,
                                    bool single_thread_mode) {
+  auto* compiled_plan = session_state.GetCompiledExecutionPlan();
+  if (compiled_plan != nullptr && !session_state.Profiler().IsEnabled() && fetch_allocators.empty() &&
+      !only_execute_path_to_fetches) {
+    bool executed = false;
+    auto status = compiled_plan->TryExecute(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                            terminate_flag, executed);
+    if (executed) {
+      return status;
+    }
+  }
+
   auto* execution_plan = session_state.GetExecutionPlan();
   LOGS(logger, VERBOSE) << "Number of streams: " << execution_plan->execution_plan.size();
   int32_t valid_streams = 0;
@@ -3,17 +3,21 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/shared_weights_registry.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -86,6 +90,28 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+
+  share_weights_across_sessions_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareWeightsAcrossSessions, "0") == "1";
+
+  if (enable_mem_pattern_) {
+    const auto cache_size_str = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternCacheSize, "0");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(cache_size_str, mem_pattern_cache_capacity_),
+                "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternCacheSize, ": ", cache_size_str);
+
+    const auto buckets_str = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternShapeBuckets, "");
+    for (const auto& bucket_str : utils::SplitString(buckets_str, ",")) {
+      int64_t bucket = 0;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(bucket_str, bucket) && bucket > 0 &&
+                      (mem_pattern_shape_buckets_.empty() || bucket > mem_pattern_shape_buckets_.back()),
+                  "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternShapeBuckets, ": ", buckets_str,
+                  ". Expected a list of positive, strictly ascending integers.");
+      mem_pattern_shape_buckets_.push_back(bucket);
+    }
+  }
+
   SetupAllocators();
 }
 
@@ -240,6 +266,14 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       // assumes vector is already resize()'ed to the number of nodes in the graph
       ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
     }
+
+    if (session_metrics_ != nullptr) {
+      node_latency_histograms_.assign(max_nodeid + 1, nullptr);
+      for (const auto& node : nodes) {
+        node_latency_histograms_[node.Index()] =
+            session_metrics_->GetOrAddOpHistogram(node.OpType(), node.GetExecutionProviderType());
+      }
+    }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
   return Status::OK();
@@ -424,7 +458,8 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                 const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
 
                 auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
+                bool is_shared_initializer = (iter != initializers_to_share_map.end()) ||
+                                             st->shared_weights_.count(ort_value_idx) != 0;
 
                 // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
                 if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
@@ -498,6 +533,7 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     // release the constant initialized tensor
                     st->initialized_tensors_.erase(ort_value_idx);
                     constant_initialized_tensors.erase(ort_value_idx);
+                    st->shared_weights_.erase(ort_value_idx);
                   }
                 }
               }
@@ -530,12 +566,49 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
+int64_t SessionState::CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs) const {
+  uint64_t key = 0;
+  auto combine = [&key](uint64_t value) {
+    key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+  };
+
   for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    combine(dims.size());
+    for (auto dim : dims) {
+      // round up to the bucket boundary so all shapes in a bucket share a pattern.
+      // dims beyond the last boundary are used as is.
+      auto bucket = std::lower_bound(mem_pattern_shape_buckets_.begin(), mem_pattern_shape_buckets_.end(), dim);
+      combine(static_cast<uint64_t>(bucket != mem_pattern_shape_buckets_.end() ? *bucket : dim));
+    }
+  }
+
+  return static_cast<int64_t>(key);
+}
+
+void SessionState::TouchMemoryPatternGroup(int64_t key) const {
+  if (mem_pattern_cache_capacity_ == 0) {
+    return;
+  }
+
+  auto pos = mem_patterns_lru_pos_.find(key);
+  if (pos != mem_patterns_lru_pos_.end()) {
+    mem_patterns_lru_.splice(mem_patterns_lru_.end(), mem_patterns_lru_, pos->second);
+    return;
+  }
+
+  mem_patterns_lru_pos_.emplace(key, mem_patterns_lru_.insert(mem_patterns_lru_.end(), key));
+
+  while (mem_patterns_lru_.size() > mem_pattern_cache_capacity_) {
+    const int64_t evicted = mem_patterns_lru_.front();
+    mem_patterns_lru_.pop_front();
+    mem_patterns_lru_pos_.erase(evicted);
+    // execution frames using the evicted pattern keep it alive until they are done.
+    mem_patterns_.erase(evicted);
+#ifdef ENABLE_TRAINING
+    shape_patterns_.erase(evicted);
+#endif
   }
-  return key;
 }
 
 #ifdef ENABLE_TRAINING
@@ -772,12 +845,12 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+// MemoryPatternGroup is cached. It only inserted upon creation
+// and is not updated if already present. It may be evicted if the cache is bounded.
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
+    std::shared_ptr<const InlinedHashMap<int, TensorShape>>& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
   int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
@@ -787,10 +860,14 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
+      auto ptr = std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns));
+      mem_patterns_.insert_or_assign(key, ptr);
+      out_inferred_shapes = std::make_shared<const InlinedHashMap<int, TensorShape>>(std::move(inferred_shapes));
+      // the inferred shapes are only valid for the exact input shapes, not for the other shapes in a bucket.
+      if (!GetMemoryPatternUsesShapeBuckets()) {
+        shape_patterns_.insert_or_assign(key, out_inferred_shapes);
+      }
+      TouchMemoryPatternGroup(key);
       return ptr;
     }
 #else
@@ -799,11 +876,13 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
     return nullptr;
   }
 
+  auto ptr = it->second;
   auto patt_hit = shape_patterns_.find(key);
   if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+    out_inferred_shapes = patt_hit->second;
   }
-  return &it->second;
+  TouchMemoryPatternGroup(key);
+  return ptr;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -858,7 +937,9 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
   // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  if (mem_patterns_.emplace(key, std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns))).second) {
+    TouchMemoryPatternGroup(key);
+  }
   return Status::OK();
 }
 
@@ -1054,6 +1135,7 @@ Status SessionState::CreateSubgraphSessionState() {
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
+      subgraph_session_state->SetSessionMetrics(session_metrics_);
 
       // recurse
       ORT_RETURN_IF_ERROR(subgraph_session_state->CreateSubgraphSessionState());
@@ -1476,6 +1558,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  session_state_utils::GetSharedWeightFunction get_shared_weight_func = nullptr;
+  if (share_weights_across_sessions_) {
+    get_shared_weight_func = [this](int idx, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                    OrtValue& value) -> Status {
+      std::shared_ptr<const OrtValue> weight;
+      ORT_RETURN_IF_ERROR(SharedWeightsRegistry::Instance().GetOrAddWeight(tensor_proto, weight));
+      value = *weight;
+      shared_weights_[idx] = std::move(weight);
+      return Status::OK();
+    };
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
@@ -1489,7 +1583,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func,
+          get_shared_weight_func));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1563,6 +1658,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     // locations for these would be the locations they are explicitly consumed on in nested subgraphs.
   }
 
+  const bool enable_cpu_run_capture =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCpuRunCapture, "0") == "1";
+  if (parent_node == nullptr &&
+      (enable_cpu_run_capture ||
+       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCompiledExecution, "0") == "1")) {
+    compiled_execution_plan_ = CompiledExecutionPlan::Create(*this, enable_cpu_run_capture);
+    if (!compiled_execution_plan_) {
+      LOGS(logger_, INFO) << "Compiled execution is not supported for this graph. "
+                          << "It needs a single stream of CPU nodes without subgraphs.";
+    }
+  }
+
   return Status::OK();
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -14,8 +15,10 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
+#include "core/common/session_metrics.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/callback.h"
+#include "core/framework/compiled_execution_plan.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/stream_execution_context.h"
@@ -199,6 +202,31 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Get the runtime metrics of this session, or nullptr if they are not enabled.
+  */
+  profiling::SessionMetrics* GetSessionMetrics() const noexcept { return session_metrics_; }
+
+  /**
+  Set the runtime metrics of this session. Must be called before the kernels are created.
+  Subgraph session states created afterwards share them.
+  */
+  void SetSessionMetrics(profiling::SessionMetrics* session_metrics) noexcept {
+    session_metrics_ = session_metrics;
+  }
+
+  /**
+  Get the compiled execution plan, or nullptr if compiled execution is not enabled or not supported for the graph.
+  */
+  CompiledExecutionPlan* GetCompiledExecutionPlan() const noexcept { return compiled_execution_plan_.get(); }
+
+  /**
+  Get the histogram collecting the kernel latencies of a node, or nullptr if metrics are not enabled.
+  */
+  profiling::LatencyHistogram* GetNodeLatencyHistogram(NodeIndex node_index) const noexcept {
+    return node_index < node_latency_histograms_.size() ? node_latency_histograms_[node_index] : nullptr;
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* GetMemoryProfiler() const noexcept { return memory_profiler_; }
 
@@ -216,10 +244,10 @@ class SessionState {
   it is not mutable, we do not obtain a lock and simply get a pointer
   w/o copying a hashtable
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      std::shared_ptr<const InlinedHashMap<int, TensorShape>>& inferred_shapes) const;
 
   /**
   Set generated memory pattern with a given input shapes.
@@ -236,6 +264,12 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Whether memory patterns are shared by all input shapes in a shape bucket.
+  If true, a tensor smaller than its planned block may be placed in that block.
+  */
+  bool GetMemoryPatternUsesShapeBuckets() const { return !mem_pattern_shape_buckets_.empty(); }
+
   /**
   Get enable memory re-use flag.
   */
@@ -479,6 +513,10 @@ class SessionState {
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
+  profiling::SessionMetrics* session_metrics_ = nullptr;
+  // kernel latency histogram of each node, indexed by node index. empty if metrics are not enabled.
+  std::vector<profiling::LatencyHistogram*> node_latency_histograms_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* memory_profiler_;
 #endif
@@ -486,18 +524,31 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  int64_t CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs) const;
+
+  // Moves key to the most recently used position and evicts the least recently used patterns
+  // if the cache is over capacity. Must be called with mem_patterns_lock_ held.
+  void TouchMemoryPatternGroup(int64_t key) const;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
+  // values are shared with the execution frames using them so an entry can be evicted during a Run.
+  mutable NodeHashMap<int64_t, std::shared_ptr<const MemoryPatternGroup>> mem_patterns_;
   // This is mutable under mutex in training scenarios so execution frame would make a copy
   // of the value when created.
 #ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
+  mutable NodeHashMap<int64_t, std::shared_ptr<const InlinedHashMap<int, TensorShape>>> shape_patterns_;
 #else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
+  NodeHashMap<int64_t, std::shared_ptr<const InlinedHashMap<int, TensorShape>>> shape_patterns_;
 #endif
+  // keys of mem_patterns_ from least to most recently used. only maintained if the cache is bounded.
+  mutable std::list<int64_t> mem_patterns_lru_;
+  mutable InlinedHashMap<int64_t, std::list<int64_t>::iterator> mem_patterns_lru_pos_;
+  // maximum number of entries in mem_patterns_. 0 means unbounded.
+  size_t mem_pattern_cache_capacity_{0};
+  // ascending dimension boundaries used to bucket input shapes in CalculateMemoryPatternsKey.
+  InlinedVector<int64_t> mem_pattern_shape_buckets_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -520,6 +571,12 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // Constant initializers are shared with other sessions through the SharedWeightsRegistry.
+  bool share_weights_across_sessions_ = false;
+  // Handles keeping the weights this session got from the SharedWeightsRegistry registered, by OrtValue index.
+  // A handle is dropped when the weight is released after pre-packing.
+  InlinedHashMap<int, std::shared_ptr<const OrtValue>> shared_weights_;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -564,6 +621,9 @@ class SessionState {
   // flag to indicate whether current session using any EP that create device stream dynamically.
   bool has_device_stream_enabled_ep_ = false;
 #endif
+
+  // Refers to the kernels and the memory pattern cache so it is declared last to be destroyed first.
+  std::unique_ptr<CompiledExecutionPlan> compiled_execution_plan_;
 };
 
 }  // namespace onnxruntime
@@ -197,7 +197,8 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    const GetSharedWeightFunction& get_shared_weight_func) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -234,6 +235,7 @@ common::Status SaveInitializedTensors(
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   InlinedHashSet<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  InlinedHashMap<int, OrtValue> shared_weights;        // initializers shared with other sessions by the registry
 
   id_to_initialized_tensor.reserve(initialized_tensor_set.size());
   user_supplied_initializer_ids.reserve(initialized_tensor_set.size());
@@ -243,6 +245,21 @@ common::Status SaveInitializedTensors(
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (get_shared_weight_func && !utils::HasExternalData(*entry.second) &&
+               entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+               exec_plan.GetLocation(ort_value_index).device.Type() == OrtDevice::CPU &&
+               graph.IsConstantInitializer(entry.first, /* check_outer_scope */ false)
+#if !defined(DISABLE_SPARSE_TENSORS)
+               && !graph.GetGraph().IsSparseInitializer(entry.first)
+#endif
+    ) {
+      OrtValue shared_weight;
+      ORT_RETURN_IF_ERROR(get_shared_weight_func(ort_value_index, *entry.second, shared_weight));
+      if (shared_weight.IsAllocated()) {
+        // like user supplied initializers, shared weights are not traced
+        shared_weights.emplace(ort_value_index, std::move(shared_weight));
+        user_supplied_initializer_ids.insert(ort_value_index);
+      }
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -254,7 +271,8 @@ common::Status SaveInitializedTensors(
   auto initialized_tensors_to_allocate = id_to_initialized_tensor;
   for (int ort_value_index : initializer_allocation_order) {
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).device.Type() == OrtDevice::CPU)) {
+    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).device.Type() == OrtDevice::CPU) &&
+        shared_weights.find(ort_value_index) == shared_weights.end()) {
       // can not trace string tensor
       ORT_ENFORCE(entry != initialized_tensors_to_allocate.end() &&
                   entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING);
@@ -290,6 +308,8 @@ common::Status SaveInitializedTensors(
   }
 
   OrtCallback deleter{nullptr, nullptr};
+  const bool lazy_load_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyLoadInitializers, "0") == "1";
 
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
@@ -303,7 +323,10 @@ common::Status SaveInitializedTensors(
 
     OrtValue ort_value;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    if (auto shared_weight = shared_weights.find(entry.first); shared_weight != shared_weights.end()) {
+      ort_value = shared_weight->second;
+      VLOGS(logger, 1) << "Using initializer shared with other sessions with name (" << name << ").";
+    } else if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
     } else {
@@ -324,6 +347,14 @@ common::Status SaveInitializedTensors(
         oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
         return Status(st.Category(), st.Code(), oss.str());
       }
+
+      if (lazy_load_initializers && utils::HasExternalData(tensor_proto)) {
+        // CPU tensors use the mapped external data directly. only page in the parts that are read.
+        const Tensor& tensor = ort_value.Get<Tensor>();
+        if (tensor.Location().device.Type() == OrtDevice::CPU) {
+          env.AdviseRandomAccess(tensor.DataRaw(), tensor.SizeInBytes());
+        }
+      }
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
@@ -33,6 +33,10 @@ namespace session_state_utils {
 using SaveTensorFunction = std::function<Status(const std::string& name, int idx, const OrtValue& value,
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
+// Returns a weight shared with other sessions for a constant CPU initializer, or an unallocated value if the
+// initializer isn't shared.
+using GetSharedWeightFunction = std::function<Status(int idx, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                     OrtValue& value)>;
 
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
@@ -44,7 +48,8 @@ common::Status SaveInitializedTensors(
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    const GetSharedWeightFunction& get_shared_weight_func = nullptr);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_weights_registry.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/endian.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kMinRemoveExpiredThreshold = 1024;
+
+uint64_t HashWeight(int32_t data_type, const TensorShape& shape, const void* data, size_t size_in_bytes) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(&data_type, static_cast<int>(sizeof(data_type)), hash[0], &hash);
+  for (const auto dim : shape.GetDims()) {
+    MurmurHash3::x86_128(&dim, static_cast<int>(sizeof(dim)), hash[0], &hash);
+  }
+  MurmurHash3::x86_128(data, static_cast<int>(size_in_bytes), hash[0], &hash);
+
+  return (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+}
+
+// a weight only matches if it holds exactly the same data, hash collisions are not shared
+bool IsSameWeight(int32_t data_type, const TensorShape& shape, const void* data, size_t size_in_bytes,
+                  const Tensor& weight) {
+  return weight.GetElementType() == data_type &&
+         weight.Shape() == shape &&
+         weight.SizeInBytes() == size_in_bytes &&
+         std::memcmp(weight.DataRaw(), data, size_in_bytes) == 0;
+}
+}  // namespace
+
+SharedWeightsRegistry& SharedWeightsRegistry::Instance() {
+  static SharedWeightsRegistry registry;
+  return registry;
+}
+
+SharedWeightsRegistry::SharedWeightsRegistry()
+    : allocator_(std::make_shared<CPUAllocator>()), remove_expired_threshold_(kMinRemoveExpiredThreshold) {
+}
+
+Status SharedWeightsRegistry::GetOrAddWeight(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                             std::shared_ptr<const OrtValue>& weight) {
+  ORT_RETURN_IF(utils::HasExternalData(tensor_proto) ||
+                    tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING,
+                "Only weights with numeric data stored in the model can be shared. Weight: ", tensor_proto.name());
+
+  const int32_t data_type = tensor_proto.data_type();
+  const TensorShape shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+
+  // raw data has the layout of the tensor on little endian hosts, so it can be matched without unpacking it.
+  // weights in the typed fields of the proto are unpacked first, and the tensor is kept if the weight is new.
+  std::shared_ptr<OrtValue> new_weight;
+  const void* data = nullptr;
+  size_t size_in_bytes = 0;
+  if constexpr (endian::native == endian::little) {
+    if (utils::HasRawData(tensor_proto)) {
+      data = tensor_proto.raw_data().data();
+      size_in_bytes = tensor_proto.raw_data().size();
+    }
+  }
+
+  if (data == nullptr) {
+    ORT_RETURN_IF_ERROR(UnpackWeight(tensor_proto, shape, new_weight));
+    const auto& tensor = new_weight->Get<Tensor>();
+    data = tensor.DataRaw();
+    size_in_bytes = tensor.SizeInBytes();
+  }
+
+  const uint64_t hash = HashWeight(data_type, shape, data, size_in_bytes);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto range = weights_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto existing = it->second.lock();
+    if (existing && IsSameWeight(data_type, shape, data, size_in_bytes, existing->Get<Tensor>())) {
+      weight = std::move(existing);
+      return Status::OK();
+    }
+  }
+
+  if (!new_weight) {
+    ORT_RETURN_IF_ERROR(UnpackWeight(tensor_proto, shape, new_weight));
+  }
+
+  if (weights_.size() >= remove_expired_threshold_) {
+    RemoveExpiredWeights();
+    remove_expired_threshold_ = std::max(kMinRemoveExpiredThreshold, weights_.size() * 2);
+  }
+
+  weights_.emplace(hash, new_weight);
+  weight = std::move(new_weight);
+  return Status::OK();
+}
+
+Status SharedWeightsRegistry::UnpackWeight(const ONNX_NAMESPACE::TensorProto& tensor_proto, const TensorShape& shape,
+                                           std::shared_ptr<OrtValue>& weight) const {
+  const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+  weight = std::make_shared<OrtValue>();
+  Tensor::InitOrtValue(type, shape, allocator_, *weight);
+  return utils::TensorProtoToTensor(Env::Default(), nullptr, tensor_proto, *weight->GetMutable<Tensor>());
+}
+
+std::shared_ptr<PrepackedWeightsContainer> SharedWeightsRegistry::GetPrepackedWeightsContainer() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto container = prepacked_weights_container_.lock();
+  if (!container) {
+    container = std::make_shared<PrepackedWeightsContainer>();
+    prepacked_weights_container_ = container;
+  }
+
+  return container;
+}
+
+size_t SharedWeightsRegistry::NumWeights() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  RemoveExpiredWeights();
+  return weights_.size();
+}
+
+void SharedWeightsRegistry::RemoveExpiredWeights() {
+  for (auto it = weights_.begin(); it != weights_.end();) {
+    if (it->second.expired()) {
+      it = weights_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace ONNX_NAMESPACE {
+class TensorProto;
+}
+
+namespace onnxruntime {
+
+/**
+Process wide registry of the constant weights loaded by the sessions that enable
+"session.share_weights_across_sessions".
+
+Weights are keyed by a hash of their type, shape and data, so a session for a model that was already loaded, or for
+a variant of it that shares some of the weights, reuses the tensors of the first session instead of allocating its
+own. A weight stays registered while any session holds the handle returned for it. The sessions also share a
+PrepackedWeightsContainer, which lives as long as any session uses it.
+*/
+class SharedWeightsRegistry {
+ public:
+  static SharedWeightsRegistry& Instance();
+
+  /**
+  Get the weight with the data of a tensor proto, adding it if no session holds one.
+  The tensor proto must hold numeric data in the model, either as raw data or in its typed fields.
+  @param weight Set to a handle of the shared weight. The weight can be found by other sessions while it is held.
+  */
+  Status GetOrAddWeight(const ONNX_NAMESPACE::TensorProto& tensor_proto, std::shared_ptr<const OrtValue>& weight);
+
+  // Get the container for the pre-packed versions of the shared weights.
+  std::shared_ptr<PrepackedWeightsContainer> GetPrepackedWeightsContainer();
+
+  // Number of weights currently held by at least one session.
+  size_t NumWeights();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedWeightsRegistry);
+
+ private:
+  SharedWeightsRegistry();
+
+  // Unpack the data of a tensor proto into a new tensor allocated by allocator_.
+  Status UnpackWeight(const ONNX_NAMESPACE::TensorProto& tensor_proto, const TensorShape& shape,
+                      std::shared_ptr<OrtValue>& weight) const;
+
+  // Remove the entries of weights that are no longer held by any session.
+  void RemoveExpiredWeights();
+
+  OrtMutex mutex_;
+  // the weights outlive the sessions that loaded them, so they don't use any session allocator
+  AllocatorPtr allocator_;
+  std::unordered_multimap<uint64_t, std::weak_ptr<const OrtValue>> weights_;
+  size_t remove_expired_threshold_;
+  std::weak_ptr<PrepackedWeightsContainer> prepacked_weights_container_;
+};
+
+}  // namespace onnxruntime
@@ -1835,6 +1835,156 @@ ONNX_MS_OPERATOR_SET_SCHEMA(SparseToDenseMatMul, 1,
                                   sparseCompatibleMatmulShapeInference(ctx, 0, 1);
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(SparseWeightGemm, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+Computes Y = alpha * A * B + beta * C, or alpha * A * B' + beta * C if transB is non-zero,
+where B is a constant weight matrix with a high ratio of zero elements. The kernel packs
+the non-zero elements of B once and skips the zero elements during multiplication. A may
+have more than 2 dimensions, in which case the leading dimensions are treated as rows.
+This operator is inserted by the graph optimizer for MatMul and Gemm nodes with pruned weights.)DOC")
+                                .Input(
+                                    0,
+                                    "A",
+                                    "Input tensor A. The shape of A should be (..., K).",
+                                    "T")
+                                .Input(
+                                    1,
+                                    "B",
+                                    "Constant input tensor B. "
+                                    "The shape of B should be (K, N) if transB is 0, "
+                                    "or (N, K) if transB is non-zero.",
+                                    "T")
+                                .Input(
+                                    2,
+                                    "C",
+                                    "Input tensor C. The shape of C should be unidirectional broadcastable to (M, N), "
+                                    "where M is the product of the leading dimensions of A.",
+                                    "T",
+                                    OpSchema::Optional)
+                                .Output(0, "Y", "Output tensor of shape (..., N).", "T")
+                                .TypeConstraint(
+                                    "T",
+                                    {"tensor(float)"},
+                                    "Constrain input and output types to float tensors.")
+                                .Attr(
+                                    "transB",
+                                    "Whether B should be transposed",
+                                    AttributeProto::INT,
+                                    static_cast<int64_t>(0))
+                                .Attr(
+                                    "alpha",
+                                    "Scalar multiplier for the product of input tensors A * B.",
+                                    AttributeProto::FLOAT,
+                                    1.0f)
+                                .Attr(
+                                    "beta",
+                                    "Scalar multiplier for input tensor C.",
+                                    AttributeProto::FLOAT,
+                                    1.0f)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (hasNInputShapes(ctx, 2)) {
+                                    bool transB = getAttribute(ctx, "transB", int64_t(0)) != 0;
+                                    auto& first_input_shape = getInputShape(ctx, 0);
+                                    auto& second_input_shape = getInputShape(ctx, 1);
+                                    if (first_input_shape.dim_size() < 1)
+                                      fail_shape_inference("First input does not have rank 1 or higher");
+                                    if (second_input_shape.dim_size() != 2)
+                                      fail_shape_inference("Second input does not have rank 2");
+                                    ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                    for (int i = 0; i < first_input_shape.dim_size() - 1; ++i) {
+                                      *output_shape.add_dim() = first_input_shape.dim(i);
+                                    }
+                                    *output_shape.add_dim() = second_input_shape.dim(transB ? 0 : 1);
+                                    updateOutputShape(ctx, 0, output_shape);
+                                  }
+                                }));
+
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+Gathers rows of an embedding table and reduces the rows of each bag to a single row with a sum, mean or max,
+without materializing the gathered rows. This is equivalent to Gather followed by ReduceSum, ReduceMean or ReduceMax.
+The bags are given either by a 2-D indices tensor with one bag per row, or by a 1-D indices tensor and the start
+offset (or the length) of each bag. Indices may be negative, counting back from the end of the table as in Gather.
+The table may be stored as int8 or uint8 with row-wise scales and zero points, or as float16; the rows are
+accumulated in single precision. An empty bag produces a row of zeros.)DOC")
+                                .Attr("mode",
+                                      "Reduction applied to the rows of each bag: 'sum', 'mean' or 'max'.",
+                                      AttributeProto::STRING,
+                                      std::string("sum"))
+                                .Attr("use_lengths",
+                                      "If non-zero, the offsets input holds the number of indices of each bag "
+                                      "instead of the start offset of each bag.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
+                                .Input(0, "table", "Embedding table of shape (num_embeddings, embedding_dim).", "T")
+                                .Input(1,
+                                       "indices",
+                                       "Indices of the rows to gather. 2-D of shape (num_bags, bag_size) "
+                                       "when offsets is not provided, else 1-D.",
+                                       "Tind")
+                                .Input(2,
+                                       "offsets",
+                                       "1-D tensor of shape (num_bags) with the start offset of each bag in indices, "
+                                       "which must be non-decreasing, or the length of each bag if use_lengths is set.",
+                                       "Tind",
+                                       OpSchema::Optional)
+                                .Input(3,
+                                       "per_sample_weights",
+                                       "Weight of each index, same shape as indices. Not supported with mode 'max'.",
+                                       "tensor(float)",
+                                       OpSchema::Optional)
+                                .Input(4,
+                                       "table_scale",
+                                       "Scale of each row of the table, of shape (num_embeddings), or a scalar. "
+                                       "Required for int8 and uint8 tables.",
+                                       "tensor(float)",
+                                       OpSchema::Optional)
+                                .Input(5,
+                                       "table_zero_point",
+                                       "Zero point of each row of an int8 or uint8 table, same shape as table_scale. "
+                                       "Default value is 0.",
+                                       "T",
+                                       OpSchema::Optional)
+                                .Output(0, "Y", "Output of shape (num_bags, embedding_dim).", "tensor(float)")
+                                .TypeConstraint("T",
+                                                {"tensor(float)", "tensor(float16)", "tensor(int8)", "tensor(uint8)"},
+                                                "Constrain the table to float, float16 or 8-bit quantized tensors.")
+                                .TypeConstraint("Tind",
+                                                {"tensor(int32)", "tensor(int64)"},
+                                                "Constrain indices and offsets to integer tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+                                  if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+                                    return;
+                                  }
+                                  auto& table_shape = getInputShape(ctx, 0);
+                                  auto& indices_shape = getInputShape(ctx, 1);
+                                  if (table_shape.dim_size() != 2) {
+                                    fail_shape_inference("table must have rank 2");
+                                  }
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  if (ctx.hasInput(2)) {
+                                    if (!hasInputShape(ctx, 2)) {
+                                      return;
+                                    }
+                                    auto& offsets_shape = getInputShape(ctx, 2);
+                                    if (indices_shape.dim_size() != 1 || offsets_shape.dim_size() != 1) {
+                                      fail_shape_inference("indices and offsets must have rank 1");
+                                    }
+                                    *output_shape.add_dim() = offsets_shape.dim(0);
+                                  } else {
+                                    if (indices_shape.dim_size() != 2) {
+                                      fail_shape_inference("indices must have rank 2 when offsets is not provided");
+                                    }
+                                    *output_shape.add_dim() = indices_shape.dim(0);
+                                  }
+                                  *output_shape.add_dim() = table_shape.dim(1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MurmurHash3, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(The underlying implementation is MurmurHash3_x86_32 generating low latency 32bits hash suitable for implementing lookup tables, Bloom filters, count min sketch or feature hashing.)DOC")
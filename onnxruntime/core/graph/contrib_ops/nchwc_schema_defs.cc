@@ -169,6 +169,45 @@ void RegisterNchwcSchemas() {
         ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
       });
 
+  // Depthwise convolution followed by a pointwise (1x1) convolution. The
+  // convolution attributes and "activation" apply to the depthwise stage and
+  // "pointwise_activation" applies to the final output.
+  ONNX_CONTRIB_OPERATOR_SCHEMA(SeparableConv)
+      .SetDomain(kMSNchwcDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(For internal use.)DOC")
+      .Attr("auto_pad", "", AttributeProto::STRING, std::string("NOTSET"))
+      .Attr("kernel_shape", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("dilations", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("strides", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("pads", "", AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
+      .Attr("activation", "", AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Attr("pointwise_activation", "", AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("pointwise_activation_params", "", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Input(0, "X", "", "T")
+      .Input(1, "W", "", "T")
+      .Input(2, "B", "", "T", OpSchema::Optional)
+      .Input(3, "W_pointwise", "", "T")
+      .Input(4, "B_pointwise", "", "T", OpSchema::Optional)
+      .Input(5, "Sum", "", "T", OpSchema::Optional)
+      .Output(0, "Y", "", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
+
+        // The channel count comes from the pointwise filter.
+        if (hasInputShape(ctx, 3) && ctx.getOutputType(0)->tensor_type().has_shape()) {
+          const auto& pointwise_shape = ctx.getInputType(3)->tensor_type().shape();
+          auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+          if (pointwise_shape.dim_size() > 0 && output_shape->dim_size() > 1) {
+            *output_shape->mutable_dim(1) = pointwise_shape.dim(0);
+          }
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(MaxPool)
       .FillUsing(NchwcPoolOpSchemaGenerator)
       .Attr("storage_order", "", AttributeProto::INT, static_cast<int64_t>(0));
@@ -650,6 +650,53 @@ The output tensor has the same shape.
           propagateShapeFromInputToOutput(ctx, 0, 0);
         }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLayerNormalization, 1,
+    OpSchema()
+        .SetDoc(R"DOC(
+QLinearLayerNormalization computes LayerNormalization of a quantized input and quantizes the result.
+The input is dequantized, normalized over the dimensions from 'axis' onwards, scaled by 'Scale',
+shifted by the optional 'B', and quantized with 'y_scale' and 'y_zero_point'. It keeps 8-bit
+activations between quantized operators of a transformer block.
+)DOC")
+        .Attr("axis",
+              "The first normalization dimension: normalization will be performed along dimensions axis : rank(inputs).",
+              AttributeProto::INT, static_cast<int64_t>(-1))
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+        .Attr("stash_type",
+              "type used for stash mean/inv_std_var. Only float (1) is supported.",
+              AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "X", "The input tensor", "T")
+        .Input(1, "X_scale", "Scale of quantized input 'X'. It must be a scalar.", "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Zero point tensor for input 'X'. It must be a scalar.",
+               "T", OpSchema::Optional)
+        .Input(3, "Scale", "Scale tensor, shape is the normalized shape of 'X'.", "tensor(float)")
+        .Input(4, "B", "Bias tensor, shape is the normalized shape of 'X'.", "tensor(float)", OpSchema::Optional)
+        .Input(5, "Y_scale", "Scale of quantized output 'Y'. It must be a scalar.", "tensor(float)")
+        .Input(6, "Y_zero_point",
+               "Zero point tensor for output 'Y'. It must be a scalar.",
+               "T", OpSchema::Optional)
+        .Output(0, "Y", "Output data tensor. It has the same shape as 'X'.", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"},
+                        "Constrain input and output types to signed/unsigned int8 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+          if (!hasNInputShapes(ctx, 1)) {
+            return;
+          }
+
+          const ONNX_NAMESPACE::TensorShapeProto& input_shape = ctx.getInputType(0)->tensor_type().shape();
+          int r = input_shape.dim_size();
+          int axis = static_cast<int>(getAttribute(ctx, "axis", -1));
+          if (axis < -r || axis >= r) {
+            fail_shape_inference("'axis' must be in [", -r, " , ", (r - 1), "]. Its actual value is: ", axis);
+          }
+
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeLSTM, 1,
     OpSchema()
@@ -589,6 +589,7 @@ struct MLAS_GEMM_QUANT_DATA_PARAMS {
     size_t ldb = 0;
     const uint8_t* ZeroPointB = nullptr;
     bool BIsPacked = false;
+    bool BIsFolded = false;   /**< B was packed by MlasGemmPackBFolded, ZeroPointB is ignored */
     bool PerColumnZeroPoints = false;
     int32_t* C = nullptr;
     size_t ldc = 0;
@@ -714,6 +715,59 @@ MlasGemmPackB(
     void* PackedB
     );
 
+/**
+ * @brief Returns size of the packing buffer needed by MlasGemmPackBFolded
+ * @param N              Number of columns
+ * @param K              Number of rows
+ * @param AIsSigned      Whether left hand size is signed int8_t
+ * @param BIsSigned      Whether right hand size is signed int8_t
+ * @return  size of the packing buffer,
+ *          0 if operation not supported
+*/
+size_t
+MLASCALL
+MlasGemmPackBFoldedSize(
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    bool BIsSigned
+    );
+
+/**
+ * @brief Packs the right hand side of a quantized GEMM together with the
+ *        zero point and bias corrections that only depend on the constant
+ *        weights. The result is used with BIsPacked and BIsFolded set.
+ * @param N                     Number of columns
+ * @param K                     Number of rows
+ * @param B                     Right hand side matrix
+ * @param ldb                   Leading dimension of B
+ * @param AIsSigned             Whether left hand size is signed int8_t
+ * @param BIsSigned             Whether right hand size is signed int8_t
+ * @param ZeroPointB            Zero point of B, one per column if
+ *                              PerColumnZeroPoints is set
+ * @param PerColumnZeroPoints   Whether ZeroPointB holds N values
+ * @param ZeroPointA            Optional expected zero point of A. When the
+ *                              runtime zero point matches, the column
+ *                              corrections are used without any fixup
+ * @param Bias                  Optional N int32 values added to the output
+ * @param PackedB               Output buffer of MlasGemmPackBFoldedSize bytes
+*/
+void
+MLASCALL
+MlasGemmPackBFolded(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool AIsSigned,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints,
+    const uint8_t* ZeroPointA,
+    const int32_t* Bias,
+    void* PackedB
+    );
+
 /**
  * @brief For symmetric quantized GEMM, returns size of the
  *        packing buffer needed for right hand side
@@ -743,6 +797,86 @@ MlasSymmQgemmPackB(
     void* PackedB
     );
 
+//
+// Sparse weight matrix multiply routines.
+//
+
+/**
+ * @brief Returns size of the packing buffer needed by MlasSparseGemmPackB
+ * @param TransB    Whether B is transposed
+ * @param N         Number of columns of B
+ * @param K         Number of rows of B
+ * @param B         Right hand side matrix
+ * @param ldb       Leading dimension of B
+ * @return  size of the packing buffer,
+ *          0 if the matrix is too large for the packed format
+*/
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief Packs the non-zero elements of a constant right hand side matrix
+ *        in compressed sparse column form for MlasSparseGemm.
+ * @param TransB    Whether B is transposed
+ * @param N         Number of columns of B
+ * @param K         Number of rows of B
+ * @param B         Right hand side matrix
+ * @param ldb       Leading dimension of B
+ * @param PackedB   Output buffer of MlasSparseGemmPackBSize bytes
+*/
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Single precision matrix multiply C = alpha * op(A) * B + beta * C
+ *        with B packed by MlasSparseGemmPackB. The cost scales with the
+ *        number of non-zero elements of B, so this is faster than MlasGemm
+ *        only for highly sparse (pruned) weights.
+ * @param TransA        Whether A is transposed
+ * @param M             Number of rows of op(A) and C
+ * @param N             Number of columns of B and C
+ * @param K             Number of columns of op(A) and rows of B
+ * @param alpha         Scalar multiplier of the product
+ * @param A             Left hand side matrix
+ * @param lda           Leading dimension of A
+ * @param PackedB       Packed sparse right hand side matrix
+ * @param beta          Scalar multiplier of C, C is not read when zero
+ * @param C             Output matrix
+ * @param ldc           Leading dimension of C
+ * @param ThreadPool
+*/
+void
+MLASCALL
+MlasSparseGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Convolution routines.
 //
@@ -751,6 +885,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -783,6 +918,10 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t OutputTileSize;
+            size_t TileBlockSize;
+        } Winograd;
     } u;
 };
 
@@ -816,6 +955,58 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution routines for 3x3 kernels with unit stride and dilation.
+//
+// MlasConvWinogradGetOutputTileSize returns the output tile size (2 or 4) of
+// the transform to use for the convolution shape, or zero if the existing
+// algorithms are expected to be faster. The filter is then transformed once
+// with MlasConvWinogradPackW and MlasConvWinogradPrepare switches parameters
+// returned by MlasConvPrepare to the Winograd algorithm, in which case the
+// packed filter is passed to MlasConv in place of the filter tensor.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradGetOutputTileSize(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackWSize(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackW(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1013,6 +1204,72 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Layer normalization routines.
+//
+
+/**
+ * @brief Optional inputs and outputs of the layer normalization routines.
+ *
+ * Each row of the input is normalized independently. When Skip or Bias is
+ * supplied, the row is first replaced by Input + Skip + Bias, which is also
+ * written to SkipInputBiasSum when that buffer is supplied.
+ */
+struct MLAS_LAYERNORM_PARAMS {
+    const float* Skip = nullptr;        /**< optional residual, same shape as the input */
+    const float* Bias = nullptr;        /**< optional bias added before normalization, RowSize elements */
+    const float* Gamma = nullptr;       /**< scale, RowSize elements */
+    const float* Beta = nullptr;        /**< optional shift, RowSize elements, ignored when Simplified */
+    float* SkipInputBiasSum = nullptr;  /**< optional output of Input + Skip + Bias */
+    float* Mean = nullptr;              /**< optional output of the mean of each row */
+    float* InvStdDev = nullptr;         /**< optional output of the inverse standard deviation of each row */
+    float Epsilon = 1e-5f;
+    bool Simplified = false;            /**< root mean square normalization, without mean subtraction */
+};
+
+/**
+ * @brief Layer normalization over the last dimension of a float tensor.
+ *
+ * @param Input      RowCount x RowSize input
+ * @param Output     RowCount x RowSize output
+ * @param RowCount   number of rows to normalize
+ * @param RowSize    number of elements in each row
+ * @param Params     optional inputs and outputs, Gamma is required
+ * @param ThreadPool optional thread pool
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Layer normalization of a quantized tensor, with quantized output.
+ *
+ * The input is dequantized one row at a time, so no full precision copy of
+ * the tensor is materialized.
+ */
+template<typename DataType>
+void
+MLASCALL
+MlasQLinearLayerNormalization(
+    const DataType* Input,
+    float InputScale,
+    DataType InputZeroPoint,
+    DataType* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    float OutputScale,
+    DataType OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -1021,6 +1278,47 @@ MlasComputeTanh(
     size_t N
     );
 
+//
+// Embedding bag routines.
+//
+
+/**
+ * @brief Reduction applied to the rows of an embedding bag. A mean is
+ *        computed as a sum with the row scales divided by the row count.
+ */
+enum MLAS_EMBEDDING_BAG_MODE {
+    MlasEmbeddingBagSum,
+    MlasEmbeddingBagMax,
+};
+
+/**
+ * @brief Reduce a bag of embedding table rows to a single float row.
+ *
+ * Each row contributes RowScales[i] * Rows[i] + RowBiases[i], which also
+ * dequantizes the rows of an int8 or uint8 table with row-wise scales and
+ * zero points. The rows ahead of the current one are prefetched.
+ *
+ * @param Mode          reduction to apply to the rows
+ * @param Rows          addresses of the RowCount rows of the bag
+ * @param RowScales     optional multiplier of each row, RowCount elements
+ * @param RowBiases     optional value added to each scaled row, RowCount elements
+ * @param RowCount      number of rows in the bag, the output is zero for an empty bag
+ * @param EmbeddingDim  number of elements in each row
+ * @param Output        EmbeddingDim elements output
+ */
+template<typename T>
+void
+MLASCALL
+MlasEmbeddingBag(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const T* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -1168,6 +1466,27 @@ MlasNchwcConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasNchwcConvDepthwisePointwise(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* DepthwiseFilter,
+    const float* DepthwiseBias,
+    const MLAS_ACTIVATION* DepthwiseActivation,
+    const float* PointwiseFilter,
+    const float* PointwiseBias,
+    float* Output,
+    const MLAS_ACTIVATION* PointwiseActivation,
+    bool ZeroMode,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasNchwcPool(
@@ -1409,6 +1728,16 @@ constexpr size_t FP16_SIZE = sizeof(uint16_t);
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether MlasHalfGemmBatch has an optimized kernel on current CPU.
+ *
+ * This is true when the CPU supports FP16 acceleration, and on x64 CPUs
+ * with AVX2 and F16C, where fp16 is the storage format and the products
+ * are accumulated in fp32.
+*/
+bool MLASCALL
+MlasHalfGemmAccelerationSupported();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -0,0 +1,909 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_winograd.cpp
+
+Abstract:
+
+    This module implements the single precision Winograd minimal filtering
+    convolution F(2x2,3x3) and F(4x4,3x3) for 3x3 kernels with unit stride
+    and dilation.
+
+    The filter is transformed to the Winograd domain once and stored as one
+    packed GEMM matrix per transform position. At run time, blocks of input
+    tiles are transformed to the Winograd domain, multiplied by the packed
+    filter using one GEMM per transform position and then transformed back
+    to the output tensor.
+
+--*/
+
+#include "mlasi.h"
+
+#include <vector>
+
+//
+// Define the minimum number of input channels and filters per group for the
+// GEMM per transform position to amortize the cost of the transforms.
+//
+
+#define MLAS_WINOGRAD_MINIMUM_CHANNELS              32
+
+//
+// Define the range of tiles processed by a single block and the target
+// number of working buffer elements used per thread to size the block.
+//
+
+#define MLAS_WINOGRAD_MINIMUM_TILE_BLOCK            8
+#define MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK            32
+#define MLAS_WINOGRAD_TARGET_ELEMENTS_PER_THREAD    (size_t(256) * size_t(1024))
+
+//
+// Define the one dimensional transforms for each supported output tile size.
+// The two dimensional transforms are formed by applying the one dimensional
+// transform to the columns and then the rows of a tile. The input and output
+// transforms operate on vectors of channels or filters.
+//
+
+template<size_t OutputTileSize>
+struct MLAS_WINOGRAD_TRANSFORM;
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<2>
+{
+    static constexpr size_t InputTileSize = 4;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Filter(const float* g, size_t gs, float* u, size_t us)
+    {
+        const float g0 = g[0];
+        const float g1 = g[gs];
+        const float g2 = g[2 * gs];
+
+        u[0] = g0;
+        u[us] = 0.5f * (g0 + g1 + g2);
+        u[2 * us] = 0.5f * (g0 - g1 + g2);
+        u[3 * us] = g2;
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Input(const MLAS_FLOAT32X4* d, size_t ds, MLAS_FLOAT32X4* v, size_t vs)
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+
+        v[0] = MlasSubtractFloat32x4(d0, d2);
+        v[vs] = MlasAddFloat32x4(d1, d2);
+        v[2 * vs] = MlasSubtractFloat32x4(d2, d1);
+        v[3 * vs] = MlasSubtractFloat32x4(d1, d3);
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Output(const MLAS_FLOAT32X4* m, size_t ms, MLAS_FLOAT32X4* y, size_t ys)
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+
+        y[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+        y[ys] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+    }
+};
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<4>
+{
+    static constexpr size_t InputTileSize = 6;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Filter(const float* g, size_t gs, float* u, size_t us)
+    {
+        const float g0 = g[0];
+        const float g1 = g[gs];
+        const float g2 = g[2 * gs];
+
+        u[0] = g0 / 4.0f;
+        u[us] = -(g0 + g1 + g2) / 6.0f;
+        u[2 * us] = -(g0 - g1 + g2) / 6.0f;
+        u[3 * us] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        u[4 * us] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        u[5 * us] = g2;
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Input(const MLAS_FLOAT32X4* d, size_t ds, MLAS_FLOAT32X4* v, size_t vs)
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+        const MLAS_FLOAT32X4 d4 = d[4 * ds];
+        const MLAS_FLOAT32X4 d5 = d[5 * ds];
+
+        const MLAS_FLOAT32X4 d31 = MlasSubtractFloat32x4(d3, d1);
+        const MLAS_FLOAT32X4 d42 = MlasSubtractFloat32x4(d4, d2);
+
+        v[0] = MlasMultiplyAddFloat32x4(d0, 4.0f, MlasMultiplyAddFloat32x4(d2, -5.0f, d4));
+        v[vs] = MlasMultiplyAddFloat32x4(MlasAddFloat32x4(d1, d2), -4.0f, MlasAddFloat32x4(d3, d4));
+        v[2 * vs] = MlasMultiplyAddFloat32x4(MlasSubtractFloat32x4(d1, d2), 4.0f, MlasSubtractFloat32x4(d4, d3));
+        v[3 * vs] = MlasMultiplyAddFloat32x4(d31, 2.0f, d42);
+        v[4 * vs] = MlasMultiplyAddFloat32x4(d31, -2.0f, d42);
+        v[5 * vs] = MlasMultiplyAddFloat32x4(d1, 4.0f, MlasMultiplyAddFloat32x4(d3, -5.0f, d5));
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    Output(const MLAS_FLOAT32X4* m, size_t ms, MLAS_FLOAT32X4* y, size_t ys)
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+        const MLAS_FLOAT32X4 m4 = m[4 * ms];
+        const MLAS_FLOAT32X4 m5 = m[5 * ms];
+
+        const MLAS_FLOAT32X4 s12 = MlasAddFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 d12 = MlasSubtractFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 s34 = MlasAddFloat32x4(m3, m4);
+        const MLAS_FLOAT32X4 d34 = MlasSubtractFloat32x4(m3, m4);
+
+        y[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, s12), s34);
+        y[ys] = MlasMultiplyAddFloat32x4(d34, 2.0f, d12);
+        y[2 * ys] = MlasMultiplyAddFloat32x4(s34, 4.0f, s12);
+        y[3 * ys] = MlasMultiplyAddFloat32x4(d34, 8.0f, MlasAddFloat32x4(d12, m5));
+    }
+};
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const void* PackedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    ptrdiff_t TargetThreadCount;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasConvWinogradWorkingBufferSize(
+    size_t OutputTileSize,
+    size_t TileBlockSize,
+    size_t TileColumns,
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of the working buffer used
+    by a single thread.
+
+Arguments:
+
+    OutputTileSize - Supplies the output tile size of the Winograd transform.
+
+    TileBlockSize - Supplies the number of tiles processed per work item.
+
+    TileColumns - Supplies the number of tiles per row of the output image.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+Return Value:
+
+    Returns the number of elements for the working buffer of a thread.
+
+--*/
+{
+    const size_t InputTileSize = OutputTileSize + 2;
+    const size_t TransformSize = InputTileSize * InputTileSize;
+    const size_t PaddedChannels = (InputChannels + 3) & ~size_t(3);
+    const size_t PaddedFilters = (FilterCount + 3) & ~size_t(3);
+    const size_t BandColumns = std::min(TileBlockSize, TileColumns) * OutputTileSize + 2;
+
+    return TransformSize * TileBlockSize * (PaddedChannels + PaddedFilters) +
+        InputTileSize * BandColumns * PaddedChannels +
+        OutputTileSize * OutputTileSize * PaddedFilters;
+}
+
+template<size_t OutputTileSize>
+void
+MlasConvWinogradPackWTransform(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter tensor to the Winograd domain and packs
+    the transformed filter as one GEMM matrix per transform position.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor in MCHW (3x3) format.
+
+    PackedFilter - Supplies the address of the packed filter buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<OutputTileSize>;
+
+    constexpr size_t InputTileSize = Transform::InputTileSize;
+    constexpr size_t TransformSize = InputTileSize * InputTileSize;
+
+    const size_t PackedMatrixSize = MlasGemmPackBSize(FilterCount, InputChannels);
+    const size_t MatrixElements = FilterCount * InputChannels;
+
+    //
+    // Transform the filters to a temporary buffer with a [C x M] matrix for
+    // each transform position and then pack each matrix. The filter is only
+    // packed once, so the buffer is released on return instead of being kept
+    // as the thread local buffer of the calling thread.
+    //
+
+    std::vector<float> TransformedFilterBuffer(TransformSize * MatrixElements);
+    float* TransformedFilter = TransformedFilterBuffer.data();
+
+    uint8_t* packed = static_cast<uint8_t*>(PackedFilter);
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                float Temp[InputTileSize * 3];
+                float Transformed[TransformSize];
+
+                for (size_t kx = 0; kx < 3; kx++) {
+                    Transform::Filter(Filter + kx, 3, Temp + kx, 3);
+                }
+
+                for (size_t i = 0; i < InputTileSize; i++) {
+                    Transform::Filter(Temp + i * 3, 1, Transformed + i * InputTileSize, 1);
+                }
+
+                for (size_t p = 0; p < TransformSize; p++) {
+                    TransformedFilter[p * MatrixElements + c * FilterCount + f] = Transformed[p];
+                }
+
+                Filter += 9;
+            }
+        }
+
+        for (size_t p = 0; p < TransformSize; p++) {
+            MlasGemmPackB(CblasNoTrans, FilterCount, InputChannels,
+                TransformedFilter + p * MatrixElements, FilterCount, packed);
+            packed += PackedMatrixSize;
+        }
+    }
+}
+
+template<size_t OutputTileSize>
+void
+MlasConvWinogradOperation(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<OutputTileSize>;
+
+    constexpr size_t InputTileSize = Transform::InputTileSize;
+    constexpr size_t TransformSize = InputTileSize * InputTileSize;
+
+    const auto* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t GroupCount = Parameters->GroupCount;
+    const float Beta = Parameters->Beta;
+
+    const size_t TileColumns = MlasDivRoundup(OutputWidth, OutputTileSize);
+    const size_t TileCount = MlasDivRoundup(OutputHeight, OutputTileSize) * TileColumns;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t BlockCount = MlasDivRoundup(TileCount, TileBlockSize);
+
+    const size_t PackedMatrixSize = MlasGemmPackBSize(FilterCount, InputChannels);
+    const size_t AlignedN =
+        (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // The channels and filters are padded to a multiple of the vector width
+    // in the working buffers.
+    //
+
+    const size_t PaddedChannels = (InputChannels + 3) & ~size_t(3);
+    const size_t PaddedFilters = (FilterCount + 3) & ~size_t(3);
+    const size_t BandColumns = std::min(TileBlockSize, TileColumns) * OutputTileSize + 2;
+
+    const size_t TransformedInputStride = TileBlockSize * PaddedChannels;
+    const size_t TransformedOutputStride = TileBlockSize * PaddedFilters;
+
+    float* TransformedInput = WorkBlock->WorkingBuffer + Index * MlasConvWinogradWorkingBufferSize(
+        OutputTileSize, TileBlockSize, TileColumns, InputChannels, FilterCount);
+    float* TransformedOutput = TransformedInput + TransformSize * TransformedInputStride;
+    float* Band = TransformedOutput + TransformSize * TransformedOutputStride;
+    float* OutputTile = Band + InputTileSize * BandColumns * PaddedChannels;
+
+    //
+    // The GEMM does not write the padding filters of the transformed output,
+    // so clear these once to keep the padding lanes of the output transform
+    // well defined.
+    //
+
+    if (PaddedFilters != FilterCount) {
+        for (size_t i = 0; i < TransformSize * TileBlockSize; i++) {
+            std::fill_n(TransformedOutput + i * PaddedFilters + FilterCount,
+                PaddedFilters - FilterCount, 0.0f);
+        }
+    }
+
+    //
+    // Compute the range of tile blocks to use for this thread.
+    //
+
+    size_t WorkIndex;
+    size_t WorkRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount,
+        Parameters->BatchCount * GroupCount * BlockCount, &WorkIndex, &WorkRemaining);
+
+    for (; WorkRemaining > 0; WorkIndex++, WorkRemaining--) {
+
+        const size_t bg = WorkIndex / BlockCount;
+        const size_t group = bg % GroupCount;
+        const size_t TileStart = (WorkIndex % BlockCount) * TileBlockSize;
+        const size_t TileBlockCount = std::min(TileBlockSize, TileCount - TileStart);
+        const size_t TileEnd = TileStart + TileBlockCount;
+
+        const float* input = WorkBlock->Input + bg * InputChannels * InputSize;
+        float* output = WorkBlock->Output + bg * FilterCount * OutputSize;
+        const uint8_t* filter = static_cast<const uint8_t*>(WorkBlock->PackedFilter) +
+            group * TransformSize * PackedMatrixSize;
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        //
+        // Transform the input tiles to a [Tiles x C] matrix for each transform
+        // position. Each row of tiles is first copied to a band of the input
+        // image in channels last order with the zero padding applied.
+        //
+
+        for (size_t tile = TileStart; tile < TileEnd;) {
+
+            const size_t SegmentStart = tile;
+            const size_t TileRow = tile / TileColumns;
+            const size_t TileRowEnd = std::min(TileEnd, (TileRow + 1) * TileColumns);
+            const size_t SegmentColumns = (TileRowEnd - tile) * OutputTileSize + 2;
+
+            const size_t ih0 = TileRow * OutputTileSize - PaddingTop;
+
+            //
+            // Compute the range of band columns that map inside the input
+            // image. The columns outside this range are zero padding.
+            //
+
+            const ptrdiff_t ColumnOrigin =
+                ptrdiff_t((tile % TileColumns) * OutputTileSize) - ptrdiff_t(PaddingLeft);
+            const ptrdiff_t ColumnLimit = ptrdiff_t(SegmentColumns);
+
+            const size_t ColumnStart = size_t(std::min(std::max(-ColumnOrigin, ptrdiff_t(0)), ColumnLimit));
+            const size_t ColumnEnd = size_t(std::max(std::min(ptrdiff_t(InputWidth) - ColumnOrigin, ColumnLimit),
+                ptrdiff_t(ColumnStart)));
+
+            std::fill_n(Band, InputTileSize * SegmentColumns * PaddedChannels, 0.0f);
+
+            for (size_t i = 0; i < InputTileSize; i++) {
+
+                const size_t ih = ih0 + i;
+
+                if (ih >= InputHeight) {
+                    continue;
+                }
+
+                const float* input_row = input + ih * InputWidth;
+                float* band_row = Band + i * SegmentColumns * PaddedChannels;
+
+                for (size_t x = ColumnStart; x < ColumnEnd; x++) {
+
+                    const float* input_column = input_row + size_t(ptrdiff_t(x) + ColumnOrigin);
+                    float* band = band_row + x * PaddedChannels;
+
+                    for (size_t c = 0; c < InputChannels; c++) {
+                        band[c] = input_column[c * InputSize];
+                    }
+                }
+            }
+
+            for (; tile < TileRowEnd; tile++) {
+
+                const float* band_tile = Band + (tile - SegmentStart) * OutputTileSize * PaddedChannels;
+                float* transformed = TransformedInput + (tile - TileStart) * PaddedChannels;
+
+                for (size_t c = 0; c < PaddedChannels; c += 4) {
+
+                    MLAS_FLOAT32X4 Tile[TransformSize];
+                    MLAS_FLOAT32X4 Temp[TransformSize];
+
+                    for (size_t i = 0; i < InputTileSize; i++) {
+                        for (size_t j = 0; j < InputTileSize; j++) {
+                            Tile[i * InputTileSize + j] = MlasLoadFloat32x4(
+                                band_tile + (i * SegmentColumns + j) * PaddedChannels + c);
+                        }
+                    }
+
+                    for (size_t j = 0; j < InputTileSize; j++) {
+                        Transform::Input(Tile + j, InputTileSize, Temp + j, InputTileSize);
+                    }
+
+                    for (size_t i = 0; i < InputTileSize; i++) {
+                        Transform::Input(Temp + i * InputTileSize, 1, Tile + i * InputTileSize, 1);
+                    }
+
+                    for (size_t p = 0; p < TransformSize; p++) {
+                        MlasStoreFloat32x4(transformed + p * TransformedInputStride + c, Tile[p]);
+                    }
+                }
+            }
+        }
+
+        //
+        // Multiply each transform position by the packed filter matrix.
+        //
+
+        for (size_t p = 0; p < TransformSize; p++) {
+            MlasSgemmPackedOperation(CblasNoTrans, TileBlockCount, 0, FilterCount,
+                InputChannels, 1.0f, TransformedInput + p * TransformedInputStride,
+                PaddedChannels, filter + p * PackedMatrixSize, AlignedN, 0.0f,
+                TransformedOutput + p * TransformedOutputStride, PaddedFilters);
+        }
+
+        //
+        // Transform the products back to output tiles, clipping the tiles at
+        // the right and bottom edges of the output image.
+        //
+
+        for (size_t t = 0; t < TileBlockCount; t++) {
+
+            const size_t tile = TileStart + t;
+            const size_t oh0 = (tile / TileColumns) * OutputTileSize;
+            const size_t ow0 = (tile % TileColumns) * OutputTileSize;
+            const size_t RowCount = std::min(OutputTileSize, OutputHeight - oh0);
+            const size_t ColumnCount = std::min(OutputTileSize, OutputWidth - ow0);
+
+            const float* transformed = TransformedOutput + t * PaddedFilters;
+
+            for (size_t f = 0; f < PaddedFilters; f += 4) {
+
+                MLAS_FLOAT32X4 Tile[TransformSize];
+                MLAS_FLOAT32X4 Temp[OutputTileSize * InputTileSize];
+
+                for (size_t p = 0; p < TransformSize; p++) {
+                    Tile[p] = MlasLoadFloat32x4(transformed + p * TransformedOutputStride + f);
+                }
+
+                for (size_t j = 0; j < InputTileSize; j++) {
+                    Transform::Output(Tile + j, InputTileSize, Temp + j, InputTileSize);
+                }
+
+                for (size_t i = 0; i < OutputTileSize; i++) {
+                    Transform::Output(Temp + i * InputTileSize, 1, Tile + i * OutputTileSize, 1);
+                }
+
+                for (size_t ij = 0; ij < OutputTileSize * OutputTileSize; ij++) {
+                    MlasStoreFloat32x4(OutputTile + ij * PaddedFilters + f, Tile[ij]);
+                }
+            }
+
+            for (size_t f = 0; f < FilterCount; f++) {
+
+                float* y = output + f * OutputSize + oh0 * OutputWidth + ow0;
+
+                for (size_t i = 0; i < RowCount; i++) {
+
+                    const float* tile_row = OutputTile + i * OutputTileSize * PaddedFilters + f;
+
+                    for (size_t j = 0; j < ColumnCount; j++) {
+                        y[j] = (Beta != 0.0f) ? tile_row[j * PaddedFilters] + Beta * y[j] :
+                            tile_row[j * PaddedFilters];
+                    }
+
+                    y += OutputWidth;
+                }
+            }
+        }
+
+        //
+        // Apply the activation with optional bias to the output rows covered
+        // by this block of tiles.
+        //
+
+        for (size_t tile = TileStart; tile < TileEnd;) {
+
+            const size_t TileRow = tile / TileColumns;
+            const size_t TileRowEnd = std::min(TileEnd, (TileRow + 1) * TileColumns);
+
+            const size_t oh0 = TileRow * OutputTileSize;
+            const size_t ow0 = (tile % TileColumns) * OutputTileSize;
+            const size_t RowCount = std::min(OutputTileSize, OutputHeight - oh0);
+            const size_t ColumnCount =
+                std::min((TileRowEnd - TileRow * TileColumns) * OutputTileSize, OutputWidth) - ow0;
+
+            for (size_t i = 0; i < RowCount; i++) {
+                MlasActivation(Parameters->Activation, output + (oh0 + i) * OutputWidth + ow0,
+                    bias, FilterCount, ColumnCount, OutputSize);
+            }
+
+            tile = TileRowEnd;
+        }
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution operation.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters prepared by MlasConvWinogradPrepare.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter packed by MlasConvWinogradPackW.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvWinogradPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+    if (Parameters->u.Winograd.OutputTileSize == 4) {
+        MlasExecuteThreaded(MlasConvWinogradOperation<4>, &WorkBlock,
+            WorkBlock.TargetThreadCount, ThreadPool);
+    } else {
+        MlasExecuteThreaded(MlasConvWinogradOperation<2>, &WorkBlock,
+            WorkBlock.TargetThreadCount, ThreadPool);
+    }
+}
+
+size_t
+MLASCALL
+MlasConvWinogradGetOutputTileSize(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd transform for a convolution.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputShape - Optionally supplies the shape of the input image if known.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns the output tile size of the Winograd transform to use, else zero
+    if the convolution is not supported or should use the other algorithms.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return 0;
+    }
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return 0;
+        }
+    }
+
+    if (InputChannels < MLAS_WINOGRAD_MINIMUM_CHANNELS ||
+        FilterCount < MLAS_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
+    }
+
+    //
+    // F(4x4,3x3) performs fewer multiplies per output, but wastes more of
+    // each edge tile on small images.
+    //
+
+    if (InputShape != nullptr && (InputShape[0] < 12 || InputShape[1] < 12)) {
+        return 2;
+    }
+
+    return 4;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackWSize(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed filter buffer.
+
+Arguments:
+
+    OutputTileSize - Supplies the output tile size of the Winograd transform.
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the size in bytes for the packed filter buffer.
+
+--*/
+{
+    const size_t InputTileSize = OutputTileSize + 2;
+
+    return GroupCount * InputTileSize * InputTileSize *
+        MlasGemmPackBSize(FilterCount, InputChannels);
+}
+
+void
+MLASCALL
+MlasConvWinogradPackW(
+    size_t OutputTileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms and packs the filter tensor for a Winograd
+    convolution. The destination buffer should be sized based on
+    MlasConvWinogradPackWSize().
+
+Arguments:
+
+    OutputTileSize - Supplies the output tile size of the Winograd transform.
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Supplies the address of the packed filter buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (OutputTileSize == 4) {
+        MlasConvWinogradPackWTransform<4>(GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+    } else {
+        MlasConvWinogradPackWTransform<2>(GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+    }
+}
+
+void
+MLASCALL
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t OutputTileSize,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine updates the parameters computed by MlasConvPrepare to
+    perform the convolution with the Winograd algorithm. The convolution must
+    be supported by the transform returned from
+    MlasConvWinogradGetOutputTileSize().
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    OutputTileSize - Supplies the output tile size of the Winograd transform
+        used to pack the filter.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputTileSize = OutputTileSize + 2;
+    const size_t TransformSize = InputTileSize * InputTileSize;
+
+    const size_t TileColumns = MlasDivRoundup(Parameters->OutputShape[1], OutputTileSize);
+    const size_t TileCount = MlasDivRoundup(Parameters->OutputShape[0], OutputTileSize) * TileColumns;
+
+    //
+    // Size the block of tiles so that the transformed input and output of a
+    // block stay within the target working set of a thread.
+    //
+
+    const size_t ElementsPerTile =
+        TransformSize * (Parameters->InputChannels + Parameters->FilterCount);
+
+    size_t TileBlockSize = MLAS_WINOGRAD_TARGET_ELEMENTS_PER_THREAD / ElementsPerTile;
+
+    TileBlockSize = std::max(TileBlockSize, size_t(MLAS_WINOGRAD_MINIMUM_TILE_BLOCK));
+    TileBlockSize = std::min(TileBlockSize, size_t(MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK));
+    TileBlockSize = std::min(TileBlockSize, TileCount);
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution operation.
+    //
+
+    const size_t WorkCount = Parameters->BatchCount * Parameters->GroupCount *
+        MlasDivRoundup(TileCount, TileBlockSize);
+
+    const double Complexity = double(Parameters->BatchCount * Parameters->GroupCount) *
+        double(Parameters->FilterCount) * double(Parameters->OutputSize) * double(Parameters->K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= WorkCount) {
+        TargetThreadCount = ptrdiff_t(WorkCount);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.OutputTileSize = OutputTileSize;
+    Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * MlasConvWinogradWorkingBufferSize(OutputTileSize,
+        TileBlockSize, TileColumns, Parameters->InputChannels, Parameters->FilterCount);
+}
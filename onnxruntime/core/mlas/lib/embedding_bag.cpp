@@ -0,0 +1,317 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    embedding_bag.cpp
+
+Abstract:
+
+    This module implements routines to reduce a bag of embedding table rows
+    to a single row.
+
+    The rows are visited through an array of row pointers, so the gathered
+    rows are never materialized. Quantized and half precision rows are
+    converted to single precision one block at a time, and the rows ahead of
+    the current one are prefetched to hide the latency of the random table
+    accesses.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns converted and accumulated at a time.
+//
+
+#define MLAS_EMBEDDING_BAG_BLOCK_SIZE 256
+
+//
+// Define the number of rows to prefetch ahead of the current row and the
+// distance in bytes between the prefetched addresses of a row.
+//
+
+#define MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE 4
+
+#define MLAS_EMBEDDING_BAG_PREFETCH_STRIDE 64
+
+MLAS_FORCEINLINE
+void
+MlasEmbeddingBagPrefetchRow(
+    const void* Row,
+    size_t RowBytes
+    )
+{
+    const char* Address = static_cast<const char*>(Row);
+
+    for (size_t offset = 0; offset < RowBytes; offset += MLAS_EMBEDDING_BAG_PREFETCH_STRIDE) {
+#if defined(MLAS_TARGET_AMD64_IX86)
+        _mm_prefetch(Address + offset, _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(Address + offset);
+#else
+        MLAS_UNREFERENCED_PARAMETER(Address);
+#endif
+    }
+}
+
+template<typename T>
+MLAS_FORCEINLINE
+const float*
+MlasEmbeddingBagLoadRow(
+    const T* Row,
+    float* Buffer,
+    size_t Count
+    )
+{
+    for (size_t n = 0; n < Count; n++) {
+        Buffer[n] = float(Row[n]);
+    }
+
+    return Buffer;
+}
+
+template<>
+MLAS_FORCEINLINE
+const float*
+MlasEmbeddingBagLoadRow<float>(
+    const float* Row,
+    float* Buffer,
+    size_t Count
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Buffer);
+    MLAS_UNREFERENCED_PARAMETER(Count);
+
+    return Row;
+}
+
+template<>
+MLAS_FORCEINLINE
+const float*
+MlasEmbeddingBagLoadRow<MLAS_FP16>(
+    const MLAS_FP16* Row,
+    float* Buffer,
+    size_t Count
+    )
+{
+    for (size_t n = 0; n < Count; n++) {
+        Buffer[n] = MLAS_Half2Float(Row[n].val);
+    }
+
+    return Buffer;
+}
+
+template<bool ComputeMax, bool IsFirstRow>
+MLAS_FORCEINLINE
+void
+MlasEmbeddingBagAccumulateRow(
+    const float* Input,
+    float* Output,
+    size_t Count,
+    float Scale,
+    float Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces Scale * Input + Bias into the output block.
+
+Arguments:
+
+    Input - Supplies the converted block of the row.
+
+    Output - Supplies the output block.
+
+    Count - Supplies the number of columns in the block.
+
+    Scale - Supplies the multiplier of the row.
+
+    Bias - Supplies the value added to the scaled row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+    size_t n = 0;
+
+    for (; n + 4 <= Count; n += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input + n), ScaleVector, BiasVector);
+
+        if (!IsFirstRow) {
+            MLAS_FLOAT32X4 Accumulator = MlasLoadFloat32x4(Output + n);
+            Vector = ComputeMax ? MlasMaximumFloat32x4(Accumulator, Vector) : MlasAddFloat32x4(Accumulator, Vector);
+        }
+
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < Count; n++) {
+
+        float Value = Input[n] * Scale + Bias;
+
+        if (!IsFirstRow) {
+            Value = ComputeMax ? std::max(Output[n], Value) : Output[n] + Value;
+        }
+
+        Output[n] = Value;
+    }
+}
+
+template<bool ComputeMax, typename T>
+void
+MlasEmbeddingBagReduce(
+    const T* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_EMBEDDING_BAG_BLOCK_SIZE], 64);
+
+    for (size_t d = 0; d < EmbeddingDim; d += MLAS_EMBEDDING_BAG_BLOCK_SIZE) {
+
+        const size_t Count = std::min(EmbeddingDim - d, size_t(MLAS_EMBEDDING_BAG_BLOCK_SIZE));
+
+        for (size_t i = 0; i < std::min(RowCount, size_t(MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE)); i++) {
+            MlasEmbeddingBagPrefetchRow(Rows[i] + d, Count * sizeof(T));
+        }
+
+        for (size_t i = 0; i < RowCount; i++) {
+
+            if (i + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE < RowCount) {
+                MlasEmbeddingBagPrefetchRow(Rows[i + MLAS_EMBEDDING_BAG_PREFETCH_DISTANCE] + d, Count * sizeof(T));
+            }
+
+            const float* Input = MlasEmbeddingBagLoadRow(Rows[i] + d, Buffer, Count);
+            const float Scale = (RowScales != nullptr) ? RowScales[i] : 1.0f;
+            const float Bias = (RowBiases != nullptr) ? RowBiases[i] : 0.0f;
+
+            if (i == 0) {
+                MlasEmbeddingBagAccumulateRow<ComputeMax, true>(Input, Output + d, Count, Scale, Bias);
+            } else {
+                MlasEmbeddingBagAccumulateRow<ComputeMax, false>(Input, Output + d, Count, Scale, Bias);
+            }
+        }
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasEmbeddingBag(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const T* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a bag of embedding table rows to a single row. Each
+    row contributes RowScales[i] * Rows[i] + RowBiases[i] to the reduction.
+
+Arguments:
+
+    Mode - Supplies the reduction to apply to the rows.
+
+    Rows - Supplies the addresses of the rows of the bag.
+
+    RowScales - Supplies the optional multiplier of each row, else nullptr
+        if the rows are not scaled.
+
+    RowBiases - Supplies the optional value added to each scaled row, else
+        nullptr if no value is added.
+
+    RowCount - Supplies the number of rows in the bag. The output is set to
+        zero for an empty bag.
+
+    EmbeddingDim - Supplies the number of columns of each row.
+
+    Output - Supplies the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (RowCount == 0) {
+        std::fill_n(Output, EmbeddingDim, 0.0f);
+        return;
+    }
+
+    if (Mode == MlasEmbeddingBagMax) {
+        MlasEmbeddingBagReduce<true>(Rows, RowScales, RowBiases, RowCount, EmbeddingDim, Output);
+    } else {
+        MlasEmbeddingBagReduce<false>(Rows, RowScales, RowBiases, RowCount, EmbeddingDim, Output);
+    }
+}
+
+template
+void
+MLASCALL
+MlasEmbeddingBag<float>(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const float* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    );
+
+template
+void
+MLASCALL
+MlasEmbeddingBag<MLAS_FP16>(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const MLAS_FP16* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    );
+
+template
+void
+MLASCALL
+MlasEmbeddingBag<int8_t>(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const int8_t* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    );
+
+template
+void
+MLASCALL
+MlasEmbeddingBag<uint8_t>(
+    MLAS_EMBEDDING_BAG_MODE Mode,
+    const uint8_t* const* Rows,
+    const float* RowScales,
+    const float* RowBiases,
+    size_t RowCount,
+    size_t EmbeddingDim,
+    float* Output
+    );
@@ -0,0 +1,301 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements half precision GEMM kernel for avx2.
+
+    x64 processors have no fp16 arithmetic, so fp16 is only used as the
+    storage format: the kernel widens the fp16 elements of A and B to fp32
+    with F16C as they are loaded, accumulates in fp32 with FMA and narrows
+    the results back to fp16 when they are stored. Matrix B is read in place,
+    which halves the memory traffic of bandwidth bound GEMMs compared to
+    casting the inputs to fp32.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <cstring>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadHalfFloat8(
+    const _mlas_fp16_* src
+    )
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadHalfFloatPartial(
+    const _mlas_fp16_* src,
+    size_t len
+    )
+{
+    _mlas_fp16_ buf[8] = {};
+    std::memcpy(buf, src, len * sizeof(_mlas_fp16_));
+    return MlasLoadHalfFloat8(buf);
+}
+
+MLAS_FORCEINLINE
+void
+MlasStoreHalfFloatPartial(
+    _mlas_fp16_* dest,
+    __m256 value,
+    size_t len
+    )
+{
+    const __m128i half = _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT);
+    if (len == 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), half);
+        return;
+    }
+    _mlas_fp16_ buf[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), half);
+    std::memcpy(dest, buf, len * sizeof(_mlas_fp16_));
+}
+
+
+MLAS_FORCEINLINE
+void
+CvtFloat2Half(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 8) {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), half);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    while (len > 0) {
+        *dest++ = MLAS_Float2Half(*src++);
+        len--;
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2D(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2Half(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2Half(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, B, ldb, CountK, CountN);
+}
+
+
+/**
+ * @brief Compute a block of RowCount rows by up to 16 columns of C.
+ *
+ * @tparam RowCount   # of rows of the block, at most KernelMaxM
+ * @tparam FullBlock  Whether the block has all 16 columns, so the columns
+ *                    of B can be loaded without bounds checks
+ */
+template<size_t RowCount, bool FullBlock>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx2Block(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    const size_t CountN0 = std::min(CountN, size_t{8});
+    const size_t CountN1 = CountN - CountN0;
+
+    __m256 Accumulators[RowCount][2];
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_ps();
+        Accumulators[r][1] = _mm256_setzero_ps();
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m256 B0;
+        __m256 B1;
+        if constexpr (FullBlock) {
+            B0 = MlasLoadHalfFloat8(B);
+            B1 = MlasLoadHalfFloat8(B + 8);
+        } else {
+            B0 = MlasLoadHalfFloatPartial(B, CountN0);
+            B1 = CountN1 > 0 ? MlasLoadHalfFloatPartial(B + 8, CountN1) : _mm256_setzero_ps();
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 AValue = _mm256_set1_ps(_cvtsh_ss(A[r * lda + k]));
+            Accumulators[r][0] = _mm256_fmadd_ps(AValue, B0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(AValue, B1, Accumulators[r][1]);
+        }
+
+        B += ldb;
+    }
+
+    __m256 Bias0 = _mm256_setzero_ps();
+    __m256 Bias1 = _mm256_setzero_ps();
+    if (Bias != nullptr) {
+        Bias0 = MlasLoadHalfFloatPartial(Bias, CountN0);
+        if (CountN1 > 0) {
+            Bias1 = MlasLoadHalfFloatPartial(Bias + 8, CountN1);
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        _mlas_fp16_* c = C + r * ldc;
+        __m256 C0 = _mm256_add_ps(Accumulators[r][0], Bias0);
+        __m256 C1 = _mm256_add_ps(Accumulators[r][1], Bias1);
+        if (!ZeroMode) {
+            C0 = _mm256_add_ps(C0, MlasLoadHalfFloatPartial(c, CountN0));
+            if (CountN1 > 0) {
+                C1 = _mm256_add_ps(C1, MlasLoadHalfFloatPartial(c + 8, CountN1));
+            }
+        }
+        MlasStoreHalfFloatPartial(c, C0, CountN0);
+        if (CountN1 > 0) {
+            MlasStoreHalfFloatPartial(c + 8, C1, CountN1);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx2Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    size_t n = 0;
+    for (; n + 16 <= CountN; n += 16) {
+        MlasHalfGemmKernelAvx2Block<RowCount, true>(
+            16, CountK, C + n, ldc, Bias == nullptr ? nullptr : Bias + n, A, lda, B + n, ldb, ZeroMode);
+    }
+
+    if (n < CountN) {
+        MlasHalfGemmKernelAvx2Block<RowCount, false>(
+            CountN - n, CountK, C + n, ldc, Bias == nullptr ? nullptr : Bias + n, A, lda, B + n, ldb, ZeroMode);
+    }
+}
+
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmKernelAvx2Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx2Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx2Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx2Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
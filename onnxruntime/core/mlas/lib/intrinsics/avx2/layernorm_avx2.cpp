@@ -0,0 +1,204 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m256i
+MlasLayerNormTailMaskAvx2(
+    size_t N
+    )
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(N)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+MLAS_FORCEINLINE
+float
+MlasLayerNormReduceAddAvx2(
+    __m256 Vector
+    )
+{
+    __m128 Vector128 = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Vector128 = _mm_add_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+    Vector128 = _mm_add_ss(Vector128, _mm_shuffle_ps(Vector128, Vector128, 1));
+    return _mm_cvtss_f32(Vector128);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelFma3(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipInputBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes one row of the input.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    See MlasLayerNormF32Kernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const __m256i TailMask = MlasLayerNormTailMaskAvx2(N % 8);
+    const size_t NBlock = N - (N % 8);
+
+    //
+    // Add the residual and bias to the input and sum the row, or the squares
+    // of the row for the simplified normalization.
+    //
+
+    const float* Source = Input;
+    float* Sum = (SkipInputBiasSum != nullptr) ? SkipInputBiasSum : Output;
+    const bool AddInputs = (Skip != nullptr || Bias != nullptr);
+
+    __m256 Accumulator0 = _mm256_setzero_ps();
+    __m256 Accumulator1 = _mm256_setzero_ps();
+
+    auto LoadSum = [&](size_t n, bool Tail) {
+        __m256 Vector = Tail ? _mm256_maskload_ps(Input + n, TailMask) : _mm256_loadu_ps(Input + n);
+        if (AddInputs) {
+            if (Skip != nullptr) {
+                Vector = _mm256_add_ps(Vector, Tail ? _mm256_maskload_ps(Skip + n, TailMask) : _mm256_loadu_ps(Skip + n));
+            }
+            if (Bias != nullptr) {
+                Vector = _mm256_add_ps(Vector, Tail ? _mm256_maskload_ps(Bias + n, TailMask) : _mm256_loadu_ps(Bias + n));
+            }
+            if (Tail) {
+                _mm256_maskstore_ps(Sum + n, TailMask, Vector);
+            } else {
+                _mm256_storeu_ps(Sum + n, Vector);
+            }
+        }
+        return Vector;
+    };
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        __m256 Vector0 = LoadSum(n, false);
+        __m256 Vector1 = LoadSum(n + 8, false);
+        if (Simplified) {
+            Accumulator0 = _mm256_fmadd_ps(Vector0, Vector0, Accumulator0);
+            Accumulator1 = _mm256_fmadd_ps(Vector1, Vector1, Accumulator1);
+        } else {
+            Accumulator0 = _mm256_add_ps(Accumulator0, Vector0);
+            Accumulator1 = _mm256_add_ps(Accumulator1, Vector1);
+        }
+    }
+
+    for (; n < N; n += 8) {
+        __m256 Vector = LoadSum(n, n == NBlock);
+        Accumulator0 = Simplified ? _mm256_fmadd_ps(Vector, Vector, Accumulator0) : _mm256_add_ps(Accumulator0, Vector);
+    }
+
+    if (AddInputs) {
+        Source = Sum;
+    }
+
+    const float Total = MlasLayerNormReduceAddAvx2(_mm256_add_ps(Accumulator0, Accumulator1));
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = Total / N;
+
+    } else {
+
+        //
+        // Compute the variance around the mean.
+        //
+
+        MeanValue = Total / N;
+
+        const __m256 MeanVector = _mm256_set1_ps(MeanValue);
+        Accumulator0 = _mm256_setzero_ps();
+        Accumulator1 = _mm256_setzero_ps();
+
+        for (n = 0; n + 16 <= N; n += 16) {
+            __m256 Vector0 = _mm256_sub_ps(_mm256_loadu_ps(Source + n), MeanVector);
+            __m256 Vector1 = _mm256_sub_ps(_mm256_loadu_ps(Source + n + 8), MeanVector);
+            Accumulator0 = _mm256_fmadd_ps(Vector0, Vector0, Accumulator0);
+            Accumulator1 = _mm256_fmadd_ps(Vector1, Vector1, Accumulator1);
+        }
+
+        for (; n < N; n += 8) {
+            __m256 Vector;
+            if (n == NBlock) {
+                // masked lanes load as zero, so mask them again after the subtraction
+                Vector = _mm256_sub_ps(_mm256_maskload_ps(Source + n, TailMask), MeanVector);
+                Vector = _mm256_and_ps(Vector, _mm256_castsi256_ps(TailMask));
+            } else {
+                Vector = _mm256_sub_ps(_mm256_loadu_ps(Source + n), MeanVector);
+            }
+            Accumulator0 = _mm256_fmadd_ps(Vector, Vector, Accumulator0);
+        }
+
+        Variance = MlasLayerNormReduceAddAvx2(_mm256_add_ps(Accumulator0, Accumulator1)) / N;
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    //
+    // Normalize the row and apply the scale and shift.
+    //
+
+    const __m256 MeanVector = _mm256_set1_ps(MeanValue);
+    const __m256 InvStdDevVector = _mm256_set1_ps(InvStdDevValue);
+    const float* Shift = Simplified ? nullptr : Beta;
+
+    for (n = 0; n < N; n += 8) {
+        const bool Tail = (n == NBlock);
+        __m256 Vector = Tail ? _mm256_maskload_ps(Source + n, TailMask) : _mm256_loadu_ps(Source + n);
+        __m256 Scale = Tail ? _mm256_maskload_ps(Gamma + n, TailMask) : _mm256_loadu_ps(Gamma + n);
+        Vector = _mm256_mul_ps(_mm256_sub_ps(Vector, MeanVector), InvStdDevVector);
+        if (Shift != nullptr) {
+            __m256 ShiftVector = Tail ? _mm256_maskload_ps(Shift + n, TailMask) : _mm256_loadu_ps(Shift + n);
+            Vector = _mm256_fmadd_ps(Vector, Scale, ShiftVector);
+        } else {
+            Vector = _mm256_mul_ps(Vector, Scale);
+        }
+        if (Tail) {
+            _mm256_maskstore_ps(Output + n, TailMask, Vector);
+        } else {
+            _mm256_storeu_ps(Output + n, Vector);
+        }
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
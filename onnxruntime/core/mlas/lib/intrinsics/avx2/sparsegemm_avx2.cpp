@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm_avx2.cpp
+
+Abstract:
+
+    This module implements the sparse SGEMM kernel with AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasSparseSgemmKernelFma3(
+    const float* A,
+    const uint32_t* ColumnOffsets,
+    const uint32_t* PanelOffsets,
+    const float* Values,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a transposed panel of matrix A by a range of
+    columns of the packed sparse matrix B.
+
+    The panel is held in two 256-bit vectors per row and four non-zero
+    elements are processed per iteration with independent accumulators.
+
+Arguments:
+
+    See MlasSparseSgemmKernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(MLAS_SPARSE_SGEMM_STRIDEM == 16, "kernel assumes two vectors per panel row");
+
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        __m256 Accumulator0a = _mm256_setzero_ps();
+        __m256 Accumulator0b = _mm256_setzero_ps();
+        __m256 Accumulator1a = _mm256_setzero_ps();
+        __m256 Accumulator1b = _mm256_setzero_ps();
+        __m256 Accumulator2a = _mm256_setzero_ps();
+        __m256 Accumulator2b = _mm256_setzero_ps();
+        __m256 Accumulator3a = _mm256_setzero_ps();
+        __m256 Accumulator3b = _mm256_setzero_ps();
+
+        size_t i = ColumnOffsets[n];
+        const size_t ColumnEnd = ColumnOffsets[n + 1];
+
+        for (; i + 4 <= ColumnEnd; i += 4) {
+
+            const float* a0 = A + PanelOffsets[i];
+            const float* a1 = A + PanelOffsets[i + 1];
+            const float* a2 = A + PanelOffsets[i + 2];
+            const float* a3 = A + PanelOffsets[i + 3];
+            __m256 b0 = _mm256_broadcast_ss(Values + i);
+            __m256 b1 = _mm256_broadcast_ss(Values + i + 1);
+            __m256 b2 = _mm256_broadcast_ss(Values + i + 2);
+            __m256 b3 = _mm256_broadcast_ss(Values + i + 3);
+
+            Accumulator0a = _mm256_fmadd_ps(_mm256_loadu_ps(a0), b0, Accumulator0a);
+            Accumulator0b = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + 8), b0, Accumulator0b);
+            Accumulator1a = _mm256_fmadd_ps(_mm256_loadu_ps(a1), b1, Accumulator1a);
+            Accumulator1b = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + 8), b1, Accumulator1b);
+            Accumulator2a = _mm256_fmadd_ps(_mm256_loadu_ps(a2), b2, Accumulator2a);
+            Accumulator2b = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + 8), b2, Accumulator2b);
+            Accumulator3a = _mm256_fmadd_ps(_mm256_loadu_ps(a3), b3, Accumulator3a);
+            Accumulator3b = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + 8), b3, Accumulator3b);
+        }
+
+        for (; i < ColumnEnd; i++) {
+
+            const float* a0 = A + PanelOffsets[i];
+            __m256 b0 = _mm256_broadcast_ss(Values + i);
+
+            Accumulator0a = _mm256_fmadd_ps(_mm256_loadu_ps(a0), b0, Accumulator0a);
+            Accumulator0b = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + 8), b0, Accumulator0b);
+        }
+
+        Accumulator0a = _mm256_add_ps(_mm256_add_ps(Accumulator0a, Accumulator1a),
+                                      _mm256_add_ps(Accumulator2a, Accumulator3a));
+        Accumulator0b = _mm256_add_ps(_mm256_add_ps(Accumulator0b, Accumulator1b),
+                                      _mm256_add_ps(Accumulator2b, Accumulator3b));
+
+        MLAS_DECLSPEC_ALIGN(float Row[MLAS_SPARSE_SGEMM_STRIDEM], 32);
+
+        _mm256_store_ps(Row, _mm256_mul_ps(Accumulator0a, AlphaBroadcast));
+        _mm256_store_ps(Row + 8, _mm256_mul_ps(Accumulator0b, AlphaBroadcast));
+
+        float* c = C + n;
+
+        if (beta == 0.0f) {
+            for (size_t m = 0; m < CountM; m++) {
+                c[m * ldc] = Row[m];
+            }
+        } else {
+            for (size_t m = 0; m < CountM; m++) {
+                c[m * ldc] = Row[m] + beta * c[m * ldc];
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel with AVX512F
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipInputBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes one row of the input.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    See MlasLayerNormF32Kernel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    auto MaskFor = [N](size_t n) -> __mmask16 {
+        const size_t Remaining = N - n;
+        return Remaining >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << Remaining) - 1);
+    };
+
+    //
+    // Add the residual and bias to the input and sum the row, or the squares
+    // of the row for the simplified normalization.
+    //
+
+    const float* Source = Input;
+    float* Sum = (SkipInputBiasSum != nullptr) ? SkipInputBiasSum : Output;
+    const bool AddInputs = (Skip != nullptr || Bias != nullptr);
+
+    __m512 Accumulator0 = _mm512_setzero_ps();
+    __m512 Accumulator1 = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n < N; n += 16) {
+        const __mmask16 Mask = MaskFor(n);
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + n);
+        if (AddInputs) {
+            if (Skip != nullptr) {
+                Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + n));
+            }
+            if (Bias != nullptr) {
+                Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias + n));
+            }
+            _mm512_mask_storeu_ps(Sum + n, Mask, Vector);
+        }
+        if (Simplified) {
+            Accumulator0 = _mm512_fmadd_ps(Vector, Vector, Accumulator0);
+        } else {
+            Accumulator0 = _mm512_add_ps(Accumulator0, Vector);
+        }
+        std::swap(Accumulator0, Accumulator1);
+    }
+
+    if (AddInputs) {
+        Source = Sum;
+    }
+
+    const float Total = _mm512_reduce_add_ps(_mm512_add_ps(Accumulator0, Accumulator1));
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = Total / N;
+
+    } else {
+
+        //
+        // Compute the variance around the mean.
+        //
+
+        MeanValue = Total / N;
+
+        const __m512 MeanVector = _mm512_set1_ps(MeanValue);
+        Accumulator0 = _mm512_setzero_ps();
+        Accumulator1 = _mm512_setzero_ps();
+
+        for (n = 0; n < N; n += 16) {
+            const __mmask16 Mask = MaskFor(n);
+            __m512 Vector = _mm512_maskz_sub_ps(Mask, _mm512_maskz_loadu_ps(Mask, Source + n), MeanVector);
+            Accumulator0 = _mm512_fmadd_ps(Vector, Vector, Accumulator0);
+            std::swap(Accumulator0, Accumulator1);
+        }
+
+        Variance = _mm512_reduce_add_ps(_mm512_add_ps(Accumulator0, Accumulator1)) / N;
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    //
+    // Normalize the row and apply the scale and shift.
+    //
+
+    const __m512 MeanVector = _mm512_set1_ps(MeanValue);
+    const __m512 InvStdDevVector = _mm512_set1_ps(InvStdDevValue);
+    const float* Shift = Simplified ? nullptr : Beta;
+
+    for (n = 0; n < N; n += 16) {
+        const __mmask16 Mask = MaskFor(n);
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Source + n);
+        __m512 Scale = _mm512_maskz_loadu_ps(Mask, Gamma + n);
+        Vector = _mm512_mul_ps(_mm512_sub_ps(Vector, MeanVector), InvStdDevVector);
+        if (Shift != nullptr) {
+            Vector = _mm512_fmadd_ps(Vector, Scale, _mm512_maskz_loadu_ps(Mask, Shift + n));
+        } else {
+            Vector = _mm512_mul_ps(Vector, Scale);
+        }
+        _mm512_mask_storeu_ps(Output + n, Mask, Vector);
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
@@ -0,0 +1,570 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization, root
+    mean square (simplified) layer normalization and skip layer normalization.
+
+    Each row is processed with three passes over data that stays in the L1
+    cache: the first pass adds the optional residual and bias and sums the
+    row, the second pass computes the variance around the mean, and the last
+    pass normalizes and applies the scale and shift.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Structure to pass layer normalization parameters to worker threads.
+//
+
+struct MLAS_LAYERNORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const float* Input;
+    void* Output;
+    size_t N;
+    size_t D;
+    const MLAS_LAYERNORM_PARAMS* Params;
+    float Scale;
+    int32_t ZeroPoint;
+    const void* QuantizedInput;
+    const float* DequantizeTable;
+};
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipInputBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes one row of the input.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the optional residual row to add to the input.
+
+    Bias - Supplies the optional bias to add to the input.
+
+    Gamma - Supplies the scale to apply to the normalized row.
+
+    Beta - Supplies the optional shift to apply to the normalized row.
+
+    Output - Supplies the output row.
+
+    SkipInputBiasSum - Supplies the optional buffer to receive the sum of
+        the input, residual and bias.
+
+    N - Supplies the number of elements to process.
+
+    Epsilon - Supplies the value added to the variance for numerical
+        stability.
+
+    Simplified - Supplies true to normalize by the root mean square of the
+        row without subtracting the mean.
+
+    Mean - Receives the mean of the row.
+
+    InvStdDev - Receives the inverse standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Add the residual and bias to the input. The sum is kept in the output
+    // buffer when the caller does not need it separately.
+    //
+
+    const float* Source = Input;
+
+    MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+    float AccumulatorTail = 0.0f;
+
+    if (Skip != nullptr || Bias != nullptr) {
+
+        float* Sum = (SkipInputBiasSum != nullptr) ? SkipInputBiasSum : Output;
+        size_t n = 0;
+
+        for (; n + 4 <= N; n += 4) {
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+            if (Skip != nullptr) {
+                Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + n));
+            }
+            if (Bias != nullptr) {
+                Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+            }
+            MlasStoreFloat32x4(Sum + n, Vector);
+            Accumulator = Simplified ? MlasMultiplyAddFloat32x4(Vector, Vector, Accumulator)
+                                     : MlasAddFloat32x4(Accumulator, Vector);
+        }
+
+        for (; n < N; n++) {
+            float Value = Input[n];
+            if (Skip != nullptr) {
+                Value += Skip[n];
+            }
+            if (Bias != nullptr) {
+                Value += Bias[n];
+            }
+            Sum[n] = Value;
+            AccumulatorTail += Simplified ? Value * Value : Value;
+        }
+
+        Source = Sum;
+
+    } else {
+
+        size_t n = 0;
+
+        for (; n + 4 <= N; n += 4) {
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+            Accumulator = Simplified ? MlasMultiplyAddFloat32x4(Vector, Vector, Accumulator)
+                                     : MlasAddFloat32x4(Accumulator, Vector);
+        }
+
+        for (; n < N; n++) {
+            AccumulatorTail += Simplified ? Input[n] * Input[n] : Input[n];
+        }
+    }
+
+    const float Total = MlasReduceAddFloat32x4(Accumulator) + AccumulatorTail;
+
+    float MeanValue = 0.0f;
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = Total / N;
+
+    } else {
+
+        //
+        // Compute the variance around the mean, which does not suffer from the
+        // cancellation of the E[x^2] - E[x]^2 formulation.
+        //
+
+        MeanValue = Total / N;
+
+        MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+        MLAS_FLOAT32X4 SquareAccumulator = MlasZeroFloat32x4();
+        float SquareAccumulatorTail = 0.0f;
+        size_t n = 0;
+
+        for (; n + 4 <= N; n += 4) {
+            MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Source + n), MeanVector);
+            SquareAccumulator = MlasMultiplyAddFloat32x4(Vector, Vector, SquareAccumulator);
+        }
+
+        for (; n < N; n++) {
+            const float Value = Source[n] - MeanValue;
+            SquareAccumulatorTail += Value * Value;
+        }
+
+        Variance = (MlasReduceAddFloat32x4(SquareAccumulator) + SquareAccumulatorTail) / N;
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    //
+    // Normalize the row and apply the scale and shift.
+    //
+
+    MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+    MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDevValue);
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Source + n), MeanVector);
+        Vector = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Vector, InvStdDevVector), MlasLoadFloat32x4(Gamma + n));
+        if (Beta != nullptr && !Simplified) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Beta + n));
+        }
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < N; n++) {
+        float Value = (Source[n] - MeanValue) * InvStdDevValue * Gamma[n];
+        if (Beta != nullptr && !Simplified) {
+            Value += Beta[n];
+        }
+        Output[n] = Value;
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormRow(
+    const float* Input,
+    float* Output,
+    size_t Row,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMS& Params
+    )
+{
+    const size_t Offset = Row * D;
+    float Mean;
+    float InvStdDev;
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYERNORM_FLOAT_KERNEL* LayerNormF32Kernel = GetMlasPlatform().LayerNormF32Kernel;
+#else
+    MLAS_LAYERNORM_FLOAT_KERNEL* LayerNormF32Kernel = MlasLayerNormF32Kernel;
+#endif
+
+    LayerNormF32Kernel(
+        Input,
+        Params.Skip != nullptr ? Params.Skip + Offset : nullptr,
+        Params.Bias,
+        Params.Gamma,
+        Params.Beta,
+        Output,
+        Params.SkipInputBiasSum != nullptr ? Params.SkipInputBiasSum + Offset : nullptr,
+        D,
+        Params.Epsilon,
+        Params.Simplified,
+        &Mean,
+        &InvStdDev);
+
+    if (Params.Mean != nullptr) {
+        Params.Mean[Row] = Mean;
+    }
+
+    if (Params.InvStdDev != nullptr) {
+        Params.InvStdDev[Row] = InvStdDev;
+    }
+}
+
+void
+MlasLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYERNORM_WORK_BLOCK*)Context;
+
+    size_t n;
+    size_t CountN;
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+    float* Output = static_cast<float*>(WorkBlock->Output);
+
+    while (CountN > 0) {
+        MlasLayerNormRow(WorkBlock->Input + n * D, Output + n * D, n, D, *WorkBlock->Params);
+        n++;
+        CountN--;
+    }
+}
+
+template<typename DataType>
+void
+MlasQLinearLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation with quantized input and output. Each row is
+    dequantized through a lookup table into a thread local buffer, normalized
+    in place and then quantized to the output.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYERNORM_WORK_BLOCK*)Context;
+
+    size_t n;
+    size_t CountN;
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+    const uint8_t* Input = static_cast<const uint8_t*>(WorkBlock->QuantizedInput);
+    DataType* Output = static_cast<DataType*>(WorkBlock->Output);
+    const DataType ZeroPoint = static_cast<DataType>(WorkBlock->ZeroPoint);
+    const float* DequantizeTable = WorkBlock->DequantizeTable;
+
+    MlasThreadedBufAlloc(D * sizeof(float));
+    float* RowBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    while (CountN > 0) {
+
+        const uint8_t* InputRow = Input + n * D;
+
+        for (size_t d = 0; d < D; d++) {
+            RowBuffer[d] = DequantizeTable[InputRow[d]];
+        }
+
+        MlasLayerNormRow(RowBuffer, RowBuffer, n, D, *WorkBlock->Params);
+        MlasQuantizeLinear(RowBuffer, Output + n * D, D, WorkBlock->Scale, ZeroPoint);
+        n++;
+        CountN--;
+    }
+}
+
+void
+MlasLayerNormExecute(
+    MLAS_LAYERNORM_WORK_BLOCK* WorkBlock,
+    MLAS_THREADED_ROUTINE* ThreadedRoutine,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    const size_t N = WorkBlock->N;
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * WorkBlock->D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock->ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(ThreadedRoutine, WorkBlock, ThreadCountN, ThreadPool);
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization over the rows of the input.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    RowCount - Supplies the number of rows to process.
+
+    RowSize - Supplies the number of columns per row to process.
+
+    Params - Supplies the optional inputs and outputs of the operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (RowCount == 0 || RowSize == 0) {
+        return;
+    }
+
+    MLAS_LAYERNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = RowCount;
+    WorkBlock.D = RowSize;
+    WorkBlock.Params = &Params;
+    WorkBlock.Scale = 1.0f;
+    WorkBlock.ZeroPoint = 0;
+    WorkBlock.QuantizedInput = nullptr;
+    WorkBlock.DequantizeTable = nullptr;
+
+    MlasLayerNormExecute(&WorkBlock, MlasLayerNormThreaded, ThreadPool);
+}
+
+template<typename DataType>
+void
+MLASCALL
+MlasQLinearLayerNormalization(
+    const DataType* Input,
+    float InputScale,
+    DataType InputZeroPoint,
+    DataType* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    float OutputScale,
+    DataType OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization over the rows of a quantized
+    input and quantizes the normalized rows, so that 8-bit activations flow
+    between quantized operators without a full precision tensor in between.
+
+Arguments:
+
+    Input - Supplies the quantized input buffer.
+
+    InputScale - Supplies the quantization scale of the input.
+
+    InputZeroPoint - Supplies the quantization zero point of the input.
+
+    Output - Supplies the quantized output buffer.
+
+    RowCount - Supplies the number of rows to process.
+
+    RowSize - Supplies the number of columns per row to process.
+
+    Params - Supplies the optional inputs and outputs of the operation.
+
+    OutputScale - Supplies the quantization scale of the output.
+
+    OutputZeroPoint - Supplies the quantization zero point of the output.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (RowCount == 0 || RowSize == 0) {
+        return;
+    }
+
+    //
+    // Build the dequantization table indexed by the raw bits of the input.
+    //
+
+    float DequantizeTable[256];
+
+    for (int32_t i = 0; i < 256; i++) {
+        const DataType Value = static_cast<DataType>(i);
+        DequantizeTable[static_cast<uint8_t>(Value)] =
+            (int32_t(Value) - int32_t(InputZeroPoint)) * InputScale;
+    }
+
+    MLAS_LAYERNORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = nullptr;
+    WorkBlock.Output = Output;
+    WorkBlock.N = RowCount;
+    WorkBlock.D = RowSize;
+    WorkBlock.Params = &Params;
+    WorkBlock.Scale = OutputScale;
+    WorkBlock.ZeroPoint = OutputZeroPoint;
+    WorkBlock.QuantizedInput = Input;
+    WorkBlock.DequantizeTable = DequantizeTable;
+
+    MlasLayerNormExecute(&WorkBlock, MlasQLinearLayerNormThreaded<DataType>, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasQLinearLayerNormalization<int8_t>(
+    const int8_t* Input,
+    float InputScale,
+    int8_t InputZeroPoint,
+    int8_t* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    float OutputScale,
+    int8_t OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasQLinearLayerNormalization<uint8_t>(
+    const uint8_t* Input,
+    float InputScale,
+    uint8_t InputZeroPoint,
+    uint8_t* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const MLAS_LAYERNORM_PARAMS& Params,
+    float OutputScale,
+    uint8_t OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -286,6 +286,7 @@ static_assert(sizeof(MLAS_FP16) == FP16_SIZE);
 #define MLAS_SGEMM_PACKED_STRIDEK                   256
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
+#define MLAS_SPARSE_SGEMM_STRIDEM                   16
 
 //
 // Define the alignment for segmenting a GEMM operation across multiple
@@ -574,6 +575,38 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_LAYERNORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipInputBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+typedef
+void
+(MLASCALL MLAS_SPARSE_SGEMM_KERNEL)(
+    const float* A,
+    const uint32_t* ColumnOffsets,
+    const uint32_t* PanelOffsets,
+    const float* Values,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha,
+    float beta
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -742,7 +775,12 @@ extern "C" {
     MLAS_QLINEAR_BINARY_OP_U8_KERNEL MlasQLinearAddU8Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8Kernel;
+    MLAS_LAYERNORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
+    MLAS_SPARSE_SGEMM_KERNEL MlasSparseSgemmKernel;
 #if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYERNORM_FLOAT_KERNEL MlasLayerNormF32KernelFma3;
+    MLAS_LAYERNORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+    MLAS_SPARSE_SGEMM_KERNEL MlasSparseSgemmKernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasErfKernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelFma3;
     MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasComputeExpF32KernelAvx512F;
@@ -814,6 +852,23 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
 //
 // Quantized integer matrix/matrix dispatch structure.
 //
@@ -857,6 +912,17 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot;
 
+//
+// Half precision matrix/matrix dispatch structure.
+//
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+#if defined(MLAS_TARGET_AMD64)
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+#endif
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -969,8 +1035,11 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_LAYERNORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_SPARSE_SGEMM_KERNEL* SparseSgemmKernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
@@ -1113,6 +1182,17 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -469,6 +469,166 @@ Return Value:
     }
 }
 
+size_t
+MLASCALL
+MlasGemmPackBFoldedSize(
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack a matrix with
+    the supplied shape and type together with its folded zero point and bias
+    corrections.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the the number of rows of matrix B.
+
+    AIsSigned - Supplies true if matrix A is signed data, else false if matrix
+        A is unsigned data.
+
+    BIsSigned - Supplies true if matrix B is signed data, else false if matrix
+        B is unsigned data.
+
+Return Value:
+
+    Returns the number of bytes required to pack the matrix, else zero if the
+        current implementation does not support packing.
+
+--*/
+{
+    const size_t PackedBSize = MlasGemmPackBSize(N, K, AIsSigned, BIsSigned);
+
+    if (PackedBSize == 0) {
+        return 0;
+    }
+
+    const size_t AlignedN =
+        (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    return sizeof(MLAS_GEMM_QUANT_FOLDED_HEADER) + 3 * AlignedN * sizeof(int32_t) + PackedBSize;
+}
+
+void
+MLASCALL
+MlasGemmPackBFolded(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool AIsSigned,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints,
+    const uint8_t* ZeroPointA,
+    const int32_t* Bias,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the supplied matrix B to the supplied packed matrix B
+    buffer and precomputes the terms of the zero point expansion that only
+    depend on matrix B:
+
+        sum((A[k] - ZeroPointA) * (B[k][n] - ZeroPointB[n])) + Bias[n]
+            ==>
+        sum(A[k] * B[k][n]) - ZeroPointB[n] * sum(A[k]) +
+            (Bias[n] - ZeroPointA * sum(B[k][n] - ZeroPointB[n]))
+
+    The sum of (B - ZeroPointB) is invariant to the sign bit fixups applied by
+    the kernels, so the packed corrections are stored in the data domain and
+    adjusted at runtime only if the zero point of matrix A differs from the
+    value supplied here. The size of the packed buffer was obtained from
+    MlasGemmPackBFoldedSize.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    AIsSigned - Supplies true if matrix A is signed data, else false if matrix
+        A is unsigned data.
+
+    BIsSigned - Supplies true if matrix B is signed data, else false if matrix
+        B is unsigned data.
+
+    ZeroPointB - Supplies the address of the zero point offsets of matrix B.
+
+    PerColumnZeroPoints - Supplies true if ZeroPointB holds one offset per
+        column, else false if ZeroPointB holds a single offset.
+
+    ZeroPointA - Optionally supplies the address of the expected zero point
+        offset of matrix A.
+
+    Bias - Optionally supplies the address of the per column bias vector.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    auto* Header = reinterpret_cast<MLAS_GEMM_QUANT_FOLDED_HEADER*>(PackedB);
+    int32_t* Corrections = reinterpret_cast<int32_t*>(Header + 1);
+    int32_t* ColumnSums = Corrections + AlignedN;
+    int32_t* NegZeroPointB = ColumnSums + AlignedN;
+
+    auto DataValue = [](uint8_t Value, bool IsSigned) -> int32_t {
+        return IsSigned ? int32_t(int8_t(Value)) : int32_t(Value);
+    };
+
+    std::fill_n(reinterpret_cast<int32_t*>(Header), sizeof(*Header) / sizeof(int32_t), 0);
+    Header->ZeroPointA = (ZeroPointA != nullptr) ? DataValue(*ZeroPointA, AIsSigned) : 0;
+    Header->ZeroPointB = DataValue(*ZeroPointB, BIsSigned);
+    Header->PerColumnZeroPoints = PerColumnZeroPoints ? 1 : 0;
+
+    //
+    // Compute the column sums of (B - ZeroPointB) directly from the source
+    // matrix, one row at a time to keep the accesses sequential.
+    //
+
+    for (size_t n = 0; n < AlignedN; n++) {
+        NegZeroPointB[n] = (n < N) ?
+            -DataValue(ZeroPointB[PerColumnZeroPoints ? n : 0], BIsSigned) : 0;
+        ColumnSums[n] = int32_t(K) * NegZeroPointB[n];
+    }
+
+    const uint8_t* b = B;
+
+    for (size_t k = 0; k < K; k++) {
+        for (size_t n = 0; n < N; n++) {
+            ColumnSums[n] += DataValue(b[n], BIsSigned);
+        }
+        b += ldb;
+    }
+
+    for (size_t n = 0; n < AlignedN; n++) {
+        Corrections[n] = ((n < N && Bias != nullptr) ? Bias[n] : 0) -
+            Header->ZeroPointA * ColumnSums[n];
+    }
+
+    MlasGemmPackB(N, K, B, ldb, AIsSigned, BIsSigned, NegZeroPointB + AlignedN);
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // We can not make this function constexpr across different platforms
@@ -47,6 +47,21 @@ struct MLAS_GEMM_QUANT_STRIDES {
     size_t K;
 };
 
+//
+// Define the header that precedes a matrix packed by MlasGemmPackBFolded. The
+// header is followed by the folded column corrections, the column sums of
+// (B - ZeroPointB), the negated zero points of matrix B (each AlignedN int32
+// values) and then the regular packed matrix. Zero points are stored in the
+// data domain. The header is sized to keep the following arrays aligned.
+//
+
+struct MLAS_GEMM_QUANT_FOLDED_HEADER {
+    int32_t ZeroPointA;
+    int32_t ZeroPointB;
+    int32_t PerColumnZeroPoints;
+    int32_t Reserved[MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 3];
+};
+
 template<typename KernelType>
 MLAS_FORCEINLINE
 bool
@@ -560,12 +575,13 @@ Return Value:
     const uint8_t* A = Data->A + RangeStartM * lda;
     const uint8_t* PackedB = (const uint8_t*)Data->B;
     int32_t* C = Data->C + RangeStartM * ldc + RangeStartN;
-    const uint8_t* PackedZeroPointB = Data->PerColumnZeroPoints ?
+    const bool BIsFolded = Data->BIsFolded;
+    const uint8_t* PackedZeroPointB = (Data->PerColumnZeroPoints && !BIsFolded) ?
         Data->ZeroPointB + RangeStartN : nullptr;
     bool IsAccumulateMode = Shape->IsAccumulateMode;
 
     int32_t ZeroPointA = typename KernelType::OffsetAType(Data->ZeroPointA);
-    int32_t ZeroPointB = typename KernelType::OffsetBType(*Data->ZeroPointB);
+    int32_t ZeroPointB = BIsFolded ? 0 : int32_t(typename KernelType::OffsetBType(*Data->ZeroPointB));
 
     //
     // Fixup the sign bit of the per-matrix zero point offset of matrix A if the
@@ -588,6 +604,44 @@ Return Value:
 
     const size_t AlignedN =
         (Shape->N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Extract the folded corrections if matrix B was packed together with its
+    // zero points and bias. These are stored in the data domain, so translate
+    // the zero points to the kernel domain by the constant offset that the
+    // sign bit fixups apply to every value of the type.
+    //
+
+    const int32_t* FoldedCorrections = nullptr;
+    const int32_t* FoldedColumnSums = nullptr;
+    const int32_t* FoldedNegZeroPointB = nullptr;
+    int32_t FoldedZeroPointAAdjust = 0;
+    int32_t ZeroPointBDomainOffset = 0;
+
+    if (BIsFolded) {
+
+        const auto* Header = reinterpret_cast<const MLAS_GEMM_QUANT_FOLDED_HEADER*>(PackedB);
+
+        FoldedCorrections = reinterpret_cast<const int32_t*>(Header + 1);
+        FoldedColumnSums = FoldedCorrections + AlignedN;
+        FoldedNegZeroPointB = FoldedColumnSums + AlignedN;
+        PackedB = (const uint8_t*)(FoldedNegZeroPointB + AlignedN);
+
+        FoldedCorrections += RangeStartN;
+        FoldedColumnSums += RangeStartN;
+        FoldedNegZeroPointB += RangeStartN;
+
+        FoldedZeroPointAAdjust = Header->ZeroPointA - ZeroPointA;
+
+        ZeroPointBDomainOffset = MlasGemmQuantFixupZeroPointB<KernelType>(
+            typename KernelType::OffsetBType(0), Shape->BIsSigned);
+
+        if (Header->PerColumnZeroPoints == 0) {
+            ZeroPointB = Header->ZeroPointB + ZeroPointBDomainOffset;
+            FoldedNegZeroPointB = nullptr;
+        }
+    }
+
     const int32_t* PackedColumnSumBuffer = (const int32_t*)PackedB;
     PackedB = (const uint8_t*)(PackedColumnSumBuffer + AlignedN);
     PackedColumnSumBuffer += RangeStartN;
@@ -618,7 +672,43 @@ Return Value:
 
             CountN = std::min(RangeCountN - n, Strides.N);
 
-            if (k == 0) {
+            const int32_t* ColumnSums = ColumnSumBuffer;
+            const int32_t* ZeroPointBs = (PackedZeroPointB != nullptr) ? ZeroPointBBuffer : nullptr;
+
+            if (BIsFolded) {
+
+                //
+                // The folded corrections already include the bias and the
+                // ZeroPointA term if the zero point offset of matrix A matches
+                // the value supplied at packing time.
+                //
+
+                if (k == 0) {
+                    if (FoldedZeroPointAAdjust == 0) {
+                        ColumnSums = FoldedCorrections + n;
+                    } else {
+                        for (size_t nn = 0; nn < CountN; nn++) {
+                            ColumnSumBuffer[nn] = FoldedCorrections[n + nn] +
+                                FoldedZeroPointAAdjust * FoldedColumnSums[n + nn];
+                        }
+                    }
+                }
+
+                if (FoldedNegZeroPointB != nullptr) {
+                    if (ZeroPointBDomainOffset == 0) {
+                        ZeroPointBs = FoldedNegZeroPointB + n;
+                    } else {
+                        const size_t AlignedCountN = (CountN + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) &
+                            ~(MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1);
+                        for (size_t nn = 0; nn < AlignedCountN; nn++) {
+                            ZeroPointBBuffer[nn] = (nn < CountN) ?
+                                FoldedNegZeroPointB[n + nn] - ZeroPointBDomainOffset : 0;
+                        }
+                        ZeroPointBs = ZeroPointBBuffer;
+                    }
+                }
+
+            } else if (k == 0) {
                 MlasGemmQuantScaleSumBuffer(ColumnSumBuffer, PackedColumnSumBuffer + n,
                     CountN, -ZeroPointA);
             }
@@ -671,17 +761,21 @@ Return Value:
                 //
                 // The ZeroPointB term is factored out and either applied below for per-matrix
                 // quantization or inside the kernel for per-column quantization.
+                // Folded matrices already carry the ZeroPointA term in their
+                // corrections as ZeroPointA * sum(B[i] - ZeroPointB).
                 //
 
-                for (size_t mm = 0; mm < CountM; mm++) {
-                    RowSumBuffer[mm] -= int32_t(CountK) * ZeroPointA;
+                if (!BIsFolded) {
+                    for (size_t mm = 0; mm < CountM; mm++) {
+                        RowSumBuffer[mm] -= int32_t(CountK) * ZeroPointA;
+                    }
                 }
 
                 //
                 // Scale the row sums by the per-matrix zero point offset of matrix B.
                 //
 
-                if (PackedZeroPointB == nullptr) {
+                if (ZeroPointBs == nullptr) {
                     MlasGemmQuantScaleSumBuffer(RowSumBuffer, CountM, -ZeroPointB);
                 }
 
@@ -707,8 +801,8 @@ Return Value:
                         CountN,
                         ldc,
                         RowSums,
-                        ColumnSumBuffer,
-                        (PackedZeroPointB != nullptr) ? ZeroPointBBuffer : nullptr,
+                        ColumnSums,
+                        ZeroPointBs,
                         ZeroMode);
 
                     if (PostProcess && Data->OutputProcessor != nullptr) {
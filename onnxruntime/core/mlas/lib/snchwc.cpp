@@ -55,6 +55,22 @@ struct MLAS_NCHWC_CONV_WORK_BLOCK : MLAS_NCHWC_WORK_BLOCK
     bool ZeroMode;
 };
 
+//
+// Define the worker thread context for a fused NCHWc depthwise and pointwise
+// convolution operation. The base structure describes the depthwise
+// convolution.
+//
+
+struct MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_WORK_BLOCK : MLAS_NCHWC_CONV_WORK_BLOCK
+{
+    const float* PointwiseFilter;
+    const float* PointwiseBias;
+    const MLAS_ACTIVATION* PointwiseActivation;
+    size_t PointwiseOutputChannels;
+    size_t BandHeight;
+    bool PointwiseZeroMode;
+};
+
 //
 // Define the worker thread context for a NCHWc pooling operation.
 //
@@ -75,6 +91,13 @@ struct MLAS_NCHWC_POOL_WORK_BLOCK : MLAS_NCHWC_WORK_BLOCK
 #define MLAS_CONV_KERNEL_FLAG_RELU_ACTIVATION       0x00000004
 #define MLAS_CONV_KERNEL_FLAG_OTHER_ACTIVATION      0x00000008
 
+//
+// Define the target number of intermediate elements buffered per thread by the
+// fused depthwise and pointwise convolution.
+//
+
+#define MLAS_NCHWC_DEPTHWISE_POINTWISE_BAND_ELEMENTS  (64 * 1024)
+
 size_t
 MLASCALL
 MlasNchwcGetBlockSize(
@@ -1087,6 +1110,217 @@ struct MLAS_NCHWC_CONV_DEPTHWISE_ALGORITHM : MLAS_NCHWC_CONV_ALGORITHM
     }
 };
 
+//
+// Implementation of the fused depthwise and pointwise convolution algorithm.
+//
+// Each thread computes the depthwise convolution for a band of output rows
+// across all channels into a thread local buffer, then applies the pointwise
+// convolution to the band. The intermediate tensor is never written to memory
+// in full and the band is sized to stay resident in the processor cache.
+//
+
+struct MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_ALGORITHM : MLAS_NCHWC_CONV_ALGORITHM
+{
+    static constexpr size_t FilterSetSize = 4;
+
+    const MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_WORK_BLOCK* WorkBlock;
+    const size_t ChannelCount;
+    const size_t PointwiseOutputChannels;
+
+    MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_ALGORITHM(const MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_WORK_BLOCK* WorkBlock) :
+        MLAS_NCHWC_CONV_ALGORITHM(WorkBlock),
+        WorkBlock(WorkBlock),
+        ChannelCount(WorkBlock->GroupCount),
+        PointwiseOutputChannels(WorkBlock->PointwiseOutputChannels)
+    {
+    }
+
+    void
+    ComputeDepthwiseBand(
+        const float* input,
+        float* band,
+        size_t ph0,
+        size_t BandRows
+        )
+    {
+        const size_t StrideWidthBytes = BlockSize * StrideWidth * sizeof(float);
+        const size_t DilationWidthBytes = BlockSize * DilationWidth * sizeof(float);
+        const size_t InputWidthBytes = BlockSize * InputWidth * sizeof(float);
+        const size_t DilatedInputWidthBytes = BlockSize * DilationHeight * InputWidth * sizeof(float);
+        const size_t InputStrideBytes = DilatedInputWidthBytes - KernelWidth * DilationWidthBytes;
+
+        const size_t BlockedOutputWidth = BlockSize * OutputWidth;
+
+#if defined(MLAS_TARGET_AMD64)
+        MLAS_CONV_DEPTHWISE_FLOAT_KERNEL* Kernel = GetMlasPlatform().ConvDepthwiseFloatKernel;
+#else
+        MLAS_CONV_DEPTHWISE_FLOAT_KERNEL* Kernel = MlasConvDepthwiseFloatKernel;
+#endif
+
+        const unsigned KernelFlags = ComputeKernelFlags(0, InputChannels);
+
+        const float* filter = Filter;
+        const float* bias = Bias;
+
+        for (size_t c = 0; c < ChannelCount; c += BlockSize) {
+
+            for (size_t ph = ph0; ph < ph0 + BandRows; ph++) {
+
+                //
+                // Constrain the effective kernel parameters if the output row
+                // uses one or more input padding rows.
+                //
+
+                const float* effective_filter = filter;
+                size_t ih;
+                size_t EffectiveKernelHeight;
+
+                ComputeEffectiveKernel(ph, BlockSize * KernelWidth, &effective_filter, &ih,
+                    &EffectiveKernelHeight);
+
+                Kernel(input + BlockSize * (ih * InputWidth - PaddingLeftX), effective_filter,
+                    band, StrideWidthBytes, DilationWidthBytes, InputStrideBytes,
+                    EffectiveKernelHeight, KernelWidth, input + BlockSize * (ih * InputWidth),
+                    InputWidthBytes, DilatedInputWidthBytes, OutputCountLeftPadX,
+                    OutputCountX, OutputCountRightPadX, bias, KernelFlags);
+
+                if ((KernelFlags & MLAS_CONV_KERNEL_FLAG_OTHER_ACTIVATION) != 0) {
+                    DoActivation(band, 1, BlockedOutputWidth);
+                }
+
+                band += BlockedOutputWidth;
+            }
+
+            input += BlockSize * InputSize;
+            filter += BlockSize * KernelSize;
+
+            if (bias != nullptr) {
+                bias += BlockSize;
+            }
+        }
+    }
+
+    void
+    ComputePointwiseBand(
+        const float* band,
+        float* output,
+        size_t BandRows
+        )
+    {
+        const size_t BandSize = BandRows * OutputWidth;
+
+        const size_t StrideWidthBytes = BlockSize * sizeof(float);
+        const size_t InputStrideBytes = BlockSize * BandSize * sizeof(float);
+        const size_t FilterStrideBytes = BlockSize * ChannelCount * sizeof(float);
+        const size_t OutputStrideBytes = BlockSize * OutputSize * sizeof(float);
+
+#if defined(MLAS_TARGET_AMD64)
+        MLAS_CONV_POINTWISE_FLOAT_KERNEL* Kernel = GetMlasPlatform().ConvPointwiseFloatKernel;
+#else
+        MLAS_CONV_POINTWISE_FLOAT_KERNEL* Kernel = MlasConvPointwiseFloatKernel;
+#endif
+
+        const MLAS_ACTIVATION* PointwiseActivation = WorkBlock->PointwiseActivation;
+        const MLAS_ACTIVATION_KIND PointwiseActivationKind = PointwiseActivation->ActivationKind;
+
+        const float* filter = WorkBlock->PointwiseFilter;
+        const float* bias = WorkBlock->PointwiseBias;
+
+        for (size_t oc = 0; oc < PointwiseOutputChannels; oc += BlockSize * FilterSetSize) {
+
+            const size_t FilterCount = std::min(FilterSetSize, (PointwiseOutputChannels - oc) / BlockSize);
+
+            size_t InputChannelBatch;
+
+            for (size_t ic = 0; ic < ChannelCount; ic += InputChannelBatch) {
+
+                constexpr size_t MaximumInputChannelBatch = 128;
+
+                InputChannelBatch = std::min(ChannelCount - ic, MaximumInputChannelBatch);
+
+                //
+                // Compute the kernel flags as done by ComputeKernelFlags for
+                // the pointwise convolution parameters.
+                //
+
+                unsigned KernelFlags = 0;
+
+                if (ic != 0 || !WorkBlock->PointwiseZeroMode) {
+                    KernelFlags |= MLAS_CONV_KERNEL_FLAG_ACCUMULATE_OUTPUT;
+                }
+
+                if (ic + InputChannelBatch == ChannelCount) {
+
+                    if (bias != nullptr) {
+                        KernelFlags |= MLAS_CONV_KERNEL_FLAG_BIAS_ADDITION;
+                    }
+
+                    if (PointwiseActivationKind == MlasReluActivation) {
+                        KernelFlags |= MLAS_CONV_KERNEL_FLAG_RELU_ACTIVATION;
+                    } else if (PointwiseActivationKind != MlasIdentityActivation) {
+                        KernelFlags |= MLAS_CONV_KERNEL_FLAG_OTHER_ACTIVATION;
+                    }
+                }
+
+                Kernel(band + ic * BandSize, filter + BlockSize * ic, output, StrideWidthBytes,
+                    InputChannelBatch / BlockSize, FilterCount, InputStrideBytes,
+                    FilterStrideBytes, OutputStrideBytes, BandSize, bias, KernelFlags);
+
+                if ((KernelFlags & MLAS_CONV_KERNEL_FLAG_OTHER_ACTIVATION) != 0) {
+                    MlasActivation(PointwiseActivation, output, nullptr, FilterCount,
+                        BlockSize * BandSize, BlockSize * OutputSize);
+                }
+            }
+
+            const size_t BlockedFilterCount = BlockSize * FilterCount;
+
+            output += BlockedFilterCount * OutputSize;
+            filter += BlockedFilterCount * ChannelCount;
+
+            if (bias != nullptr) {
+                bias += BlockedFilterCount;
+            }
+        }
+    }
+
+    void Execute(ptrdiff_t Index)
+    {
+        const size_t BandHeight = WorkBlock->BandHeight;
+        const size_t BandCount = (OutputHeight + BandHeight - 1) / BandHeight;
+
+        const size_t TotalWork = BatchCount * BandCount;
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(Index, WorkBlock->tids, TotalWork, &WorkIndex, &WorkRemaining);
+
+        if (WorkRemaining == 0) {
+            return;
+        }
+
+        MlasThreadedBufAlloc(ChannelCount * BandHeight * OutputWidth * sizeof(float));
+
+        float* band = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        for (; WorkRemaining > 0; WorkIndex++, WorkRemaining--) {
+
+            const size_t batch = WorkIndex / BandCount;
+            const size_t ph0 = (WorkIndex % BandCount) * BandHeight;
+            const size_t BandRows = std::min(BandHeight, OutputHeight - ph0);
+
+            const float* input = Input + batch * ChannelCount * InputSize;
+            float* output = Output + batch * PointwiseOutputChannels * OutputSize +
+                BlockSize * ph0 * OutputWidth;
+
+            ComputeDepthwiseBand(input, band, ph0, BandRows);
+            ComputePointwiseBand(band, output, BandRows);
+        }
+    }
+};
+
+constexpr size_t MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_ALGORITHM::FilterSetSize;
+
 //
 // Implementation of the pooling algorithm.
 //
@@ -1332,6 +1566,139 @@ Return Value:
     MlasExecuteThreaded(ThreadedRoutine, &WorkBlock, WorkBlock.tids, ThreadPool);
 }
 
+void
+MLASCALL
+MlasNchwcConvDepthwisePointwise(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* DepthwiseFilter,
+    const float* DepthwiseBias,
+    const MLAS_ACTIVATION* DepthwiseActivation,
+    const float* PointwiseFilter,
+    const float* PointwiseBias,
+    float* Output,
+    const MLAS_ACTIVATION* PointwiseActivation,
+    bool ZeroMode,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a NCHWc depthwise convolution followed by a NCHWc
+    pointwise convolution without materializing the intermediate tensor.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor.
+
+    KernelShape - Supplies the shape of the depthwise kernel transform.
+
+    DilationShape - Supplies the shape of the depthwise dilation.
+
+    Padding - Supplies the number of padding elements at the edge of the input
+        tensor.
+
+    StrideShape - Supplies the shape of the depthwise stride.
+
+    OutputShape - Supplies the shape of the output tensor. The spatial
+        dimensions are the output dimensions of the depthwise convolution and
+        the channel dimension is the number of pointwise filters.
+
+    Input - Supplies the input tensor.
+
+    DepthwiseFilter - Supplies the depthwise filter tensor.
+
+    DepthwiseBias - Optionally supplies the depthwise bias vector.
+
+    DepthwiseActivation - Supplies the parameters for the activation to apply
+        to the depthwise convolution output.
+
+    PointwiseFilter - Supplies the pointwise filter tensor.
+
+    PointwiseBias - Optionally supplies the pointwise bias vector.
+
+    Output - Supplies the output tensor.
+
+    PointwiseActivation - Supplies the parameters for the activation to apply
+        to the pointwise convolution output.
+
+    ZeroMode - Supplies true if the output tensor must be zero initialized
+        first, else false if the output tensor is accumulated into. This flag is
+        used to implement Conv/Sum fusion.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the convolution specific parameters to the work block.
+    //
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.GroupCount = size_t(InputShape[1]);
+    WorkBlock.Filter = DepthwiseFilter;
+    WorkBlock.Bias = DepthwiseBias;
+    WorkBlock.Activation = DepthwiseActivation;
+    WorkBlock.ZeroMode = true;
+    WorkBlock.PointwiseFilter = PointwiseFilter;
+    WorkBlock.PointwiseBias = PointwiseBias;
+    WorkBlock.PointwiseActivation = PointwiseActivation;
+    WorkBlock.PointwiseOutputChannels = size_t(OutputShape[1]);
+    WorkBlock.PointwiseZeroMode = ZeroMode;
+
+    //
+    // Capture the generic shape parameters of the depthwise convolution to the
+    // work block.
+    //
+
+    const int64_t DepthwiseOutputShape[] = {OutputShape[0], InputShape[1], OutputShape[2], OutputShape[3]};
+
+    MlasNchwcPrepareWorkBlock(&WorkBlock, InputShape, KernelShape,
+        DilationShape, Padding, StrideShape, DepthwiseOutputShape);
+
+    WorkBlock.InputChannels = 1;
+    WorkBlock.OutputChannels = 1;
+
+    //
+    // Size the band of depthwise output rows to stay resident in the processor
+    // cache, but use enough bands to keep the threads busy.
+    //
+
+    const size_t OutputHeight = WorkBlock.OutputShape[0];
+    const size_t BandElements = WorkBlock.GroupCount * WorkBlock.OutputShape[1];
+
+    WorkBlock.tids = MlasGetMaximumThreadCount(ThreadPool);
+
+    size_t BandHeight = std::max(size_t(MLAS_NCHWC_DEPTHWISE_POINTWISE_BAND_ELEMENTS) / BandElements, size_t(1));
+
+    const size_t BandsPerBatch = (size_t(WorkBlock.tids) + WorkBlock.BatchCount - 1) / WorkBlock.BatchCount;
+
+    BandHeight = std::min(BandHeight, (OutputHeight + BandsPerBatch - 1) / BandsPerBatch);
+
+    WorkBlock.BandHeight = BandHeight;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasExecuteThreaded(MlasNchwcThreaded<MLAS_NCHWC_CONV_DEPTHWISE_POINTWISE_ALGORITHM>,
+        &WorkBlock, WorkBlock.tids, ThreadPool);
+}
+
 void
 MLASCALL
 MlasNchwcPool(
@@ -0,0 +1,581 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a constant right hand side matrix that has been
+    pruned to a high ratio of zero elements.
+
+    The constant matrix is packed once in compressed sparse column form: for
+    each output column, the row index and value of every non-zero element.
+    The left hand side is transposed into panels of MLAS_SPARSE_SGEMM_STRIDEM
+    rows so that the kernels multiply a single non-zero element against a
+    contiguous vector of rows. Zero elements of the packed matrix are never
+    visited, so the cost of the operation scales with the non-zero count.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the header of the packed sparse matrix. The header is followed by
+// N+1 column offsets into the non-zero arrays, then the panel offset (row
+// index scaled by MLAS_SPARSE_SGEMM_STRIDEM) of each non-zero element and
+// finally the value of each non-zero element.
+//
+
+struct MLAS_SPARSE_SGEMM_PACKED_HEADER {
+    size_t N;
+    size_t K;
+    size_t NonZeroCount;
+    size_t Reserved;
+};
+
+static_assert(sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER) % sizeof(float) == 0, "header must keep arrays aligned");
+
+//
+// Structure to pass sparse SGEMM parameters to worker threads.
+//
+
+struct MLAS_SPARSE_SGEMM_WORK_BLOCK {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    CBLAS_TRANSPOSE TransA;
+    size_t M;
+    size_t N;
+    size_t K;
+    float alpha;
+    const float* A;
+    size_t lda;
+    const uint32_t* ColumnOffsets;
+    const uint32_t* PanelOffsets;
+    const float* Values;
+    float beta;
+    float* C;
+    size_t ldc;
+};
+
+MLAS_FORCEINLINE
+float
+MlasSparseSgemmGetElement(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t k,
+    size_t n
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed sparse matrix B
+    buffer.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer or zero if the
+    matrix is too large to be represented by the packed format.
+
+--*/
+{
+    if (K > (std::numeric_limits<uint32_t>::max)() / MLAS_SPARSE_SGEMM_STRIDEM) {
+        return 0;
+    }
+
+    size_t NonZeroCount = 0;
+
+    for (size_t n = 0; n < N; n++) {
+        for (size_t k = 0; k < K; k++) {
+            if (MlasSparseSgemmGetElement(TransB, B, ldb, k, n) != 0.0f) {
+                NonZeroCount++;
+            }
+        }
+    }
+
+    if (NonZeroCount > (std::numeric_limits<uint32_t>::max)()) {
+        return 0;
+    }
+
+    return sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER) + (N + 1) * sizeof(uint32_t) +
+        NonZeroCount * (sizeof(uint32_t) + sizeof(float));
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the non-zero elements of matrix B into a buffer
+    suitable for MlasSparseGemm.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B. The buffer must be at
+        least MlasSparseGemmPackBSize bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    auto* Header = reinterpret_cast<MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB);
+    uint32_t* ColumnOffsets = reinterpret_cast<uint32_t*>(Header + 1);
+    uint32_t* PanelOffsets = ColumnOffsets + N + 1;
+
+    uint32_t NonZeroCount = 0;
+
+    for (size_t n = 0; n < N; n++) {
+
+        ColumnOffsets[n] = NonZeroCount;
+
+        for (size_t k = 0; k < K; k++) {
+            if (MlasSparseSgemmGetElement(TransB, B, ldb, k, n) != 0.0f) {
+                PanelOffsets[NonZeroCount++] = uint32_t(k * MLAS_SPARSE_SGEMM_STRIDEM);
+            }
+        }
+    }
+
+    ColumnOffsets[N] = NonZeroCount;
+
+    float* Values = reinterpret_cast<float*>(PanelOffsets + NonZeroCount);
+
+    for (size_t n = 0; n < N; n++) {
+        for (uint32_t i = ColumnOffsets[n]; i < ColumnOffsets[n + 1]; i++) {
+            size_t k = PanelOffsets[i] / MLAS_SPARSE_SGEMM_STRIDEM;
+            Values[i] = MlasSparseSgemmGetElement(TransB, B, ldb, k, n);
+        }
+    }
+
+    Header->N = N;
+    Header->K = K;
+    Header->NonZeroCount = NonZeroCount;
+    Header->Reserved = 0;
+}
+
+void
+MLASCALL
+MlasSparseSgemmKernel(
+    const float* A,
+    const uint32_t* ColumnOffsets,
+    const uint32_t* PanelOffsets,
+    const float* Values,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a transposed panel of matrix A by a range of
+    columns of the packed sparse matrix B.
+
+Arguments:
+
+    A - Supplies the address of the transposed panel of matrix A. Each row of
+        the panel holds MLAS_SPARSE_SGEMM_STRIDEM elements.
+
+    ColumnOffsets - Supplies the offsets of the first non-zero element of each
+        column in the range. CountN+1 entries are accessed.
+
+    PanelOffsets - Supplies the offset into the panel of matrix A for each
+        non-zero element of matrix B.
+
+    Values - Supplies the value of each non-zero element of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of the panel to store to matrix C.
+
+    CountN - Supplies the number of columns to compute.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static_assert(MLAS_SPARSE_SGEMM_STRIDEM == 16, "kernel assumes four vectors per panel row");
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        MLAS_FLOAT32X4 Accumulators[2][4];
+
+        for (size_t j = 0; j < 4; j++) {
+            Accumulators[0][j] = MlasZeroFloat32x4();
+            Accumulators[1][j] = MlasZeroFloat32x4();
+        }
+
+        //
+        // Use two independent sets of accumulators to hide the latency of
+        // the multiply/add chains.
+        //
+
+        size_t i = ColumnOffsets[n];
+        const size_t ColumnEnd = ColumnOffsets[n + 1];
+
+        for (; i + 2 <= ColumnEnd; i += 2) {
+
+            const float* a0 = A + PanelOffsets[i];
+            const float* a1 = A + PanelOffsets[i + 1];
+            MLAS_FLOAT32X4 b0 = MlasBroadcastFloat32x4(Values + i);
+            MLAS_FLOAT32X4 b1 = MlasBroadcastFloat32x4(Values + i + 1);
+
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[0][j] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a0 + j * 4), b0, Accumulators[0][j]);
+                Accumulators[1][j] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a1 + j * 4), b1, Accumulators[1][j]);
+            }
+        }
+
+        if (i < ColumnEnd) {
+
+            const float* a0 = A + PanelOffsets[i];
+            MLAS_FLOAT32X4 b0 = MlasBroadcastFloat32x4(Values + i);
+
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[0][j] = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a0 + j * 4), b0, Accumulators[0][j]);
+            }
+        }
+
+        MLAS_DECLSPEC_ALIGN(float Row[MLAS_SPARSE_SGEMM_STRIDEM], 16);
+
+        for (size_t j = 0; j < 4; j++) {
+            MLAS_FLOAT32X4 Sum = MlasAddFloat32x4(Accumulators[0][j], Accumulators[1][j]);
+            MlasStoreAlignedFloat32x4(Row + j * 4, MlasMultiplyFloat32x4(Sum, AlphaBroadcast));
+        }
+
+        float* c = C + n;
+
+        if (beta == 0.0f) {
+            for (size_t m = 0; m < CountM; m++) {
+                c[m * ldc] = Row[m];
+            }
+        } else {
+            for (size_t m = 0; m < CountM; m++) {
+                c[m * ldc] = Row[m] + beta * c[m * ldc];
+            }
+        }
+    }
+}
+
+void
+MlasSparseSgemmTransposeA(
+    CBLAS_TRANSPOSE TransA,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t K,
+    float* Panel
+    )
+/*++
+
+Routine Description:
+
+    This routine copies rows of matrix A into a panel where each row of the
+    panel holds one column of the rows. Unused rows of the panel are zeroed.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    A - Supplies the address of the first row of matrix A to copy.
+
+    lda - Supplies the first dimension of matrix A.
+
+    CountM - Supplies the number of rows to copy.
+
+    K - Supplies the number of columns of matrix A.
+
+    Panel - Supplies the address of the panel buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (TransA == CblasNoTrans) {
+
+        for (size_t k = 0; k < K; k++) {
+
+            float* p = Panel + k * MLAS_SPARSE_SGEMM_STRIDEM;
+            const float* a = A + k;
+            size_t m = 0;
+
+            for (; m < CountM; m++) {
+                p[m] = a[m * lda];
+            }
+
+            for (; m < MLAS_SPARSE_SGEMM_STRIDEM; m++) {
+                p[m] = 0.0f;
+            }
+        }
+
+    } else {
+
+        for (size_t k = 0; k < K; k++) {
+
+            float* p = Panel + k * MLAS_SPARSE_SGEMM_STRIDEM;
+            const float* a = A + k * lda;
+            size_t m = 0;
+
+            for (; m < CountM; m++) {
+                p[m] = a[m];
+            }
+
+            for (; m < MLAS_SPARSE_SGEMM_STRIDEM; m++) {
+                p[m] = 0.0f;
+            }
+        }
+    }
+}
+
+void
+MlasSparseSgemmThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    sparse SGEMM operation. Each work item covers a range of panels of rows
+    of matrix A and a range of columns of matrix B.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SPARSE_SGEMM_WORK_BLOCK*)Context;
+
+    const ptrdiff_t ThreadIdM = Index / WorkBlock->ThreadCountN;
+    const ptrdiff_t ThreadIdN = Index % WorkBlock->ThreadCountN;
+
+    size_t Panel;
+    size_t CountPanels;
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, MlasDivRoundup(WorkBlock->M, MLAS_SPARSE_SGEMM_STRIDEM),
+        &Panel, &CountPanels);
+
+    size_t n;
+    size_t CountN;
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    if (CountPanels == 0 || CountN == 0) {
+        return;
+    }
+
+    const size_t K = WorkBlock->K;
+
+    MlasThreadedBufAlloc(K * MLAS_SPARSE_SGEMM_STRIDEM * sizeof(float));
+    float* PanelBuffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_SPARSE_SGEMM_KERNEL* SparseSgemmKernel = GetMlasPlatform().SparseSgemmKernel;
+#else
+    MLAS_SPARSE_SGEMM_KERNEL* SparseSgemmKernel = MlasSparseSgemmKernel;
+#endif
+
+    while (CountPanels > 0) {
+
+        const size_t m = Panel * MLAS_SPARSE_SGEMM_STRIDEM;
+        const size_t CountM = std::min(WorkBlock->M - m, size_t(MLAS_SPARSE_SGEMM_STRIDEM));
+
+        const float* A = WorkBlock->A;
+
+        if (WorkBlock->TransA == CblasNoTrans) {
+            A += m * WorkBlock->lda;
+        } else {
+            A += m;
+        }
+
+        MlasSparseSgemmTransposeA(WorkBlock->TransA, A, WorkBlock->lda, CountM, K, PanelBuffer);
+
+        SparseSgemmKernel(PanelBuffer, WorkBlock->ColumnOffsets + n, WorkBlock->PanelOffsets, WorkBlock->Values,
+            WorkBlock->C + m * WorkBlock->ldc + n, WorkBlock->ldc, CountM, CountN, WorkBlock->alpha,
+            WorkBlock->beta);
+
+        Panel++;
+        CountPanels--;
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a right hand side packed by MlasSparseGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of the packed sparse matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* Header = reinterpret_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB);
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    MLAS_SPARSE_SGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.alpha = alpha;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.ColumnOffsets = reinterpret_cast<const uint32_t*>(Header + 1);
+    WorkBlock.PanelOffsets = WorkBlock.ColumnOffsets + N + 1;
+    WorkBlock.Values = reinterpret_cast<const float*>(WorkBlock.PanelOffsets + Header->NonZeroCount);
+    WorkBlock.beta = beta;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. The panels of rows are split across the threads; when there
+    // are fewer panels than threads, the columns are also split so that every
+    // thread has work.
+    //
+
+    const size_t PanelCount = MlasDivRoundup(M, MLAS_SPARSE_SGEMM_STRIDEM);
+
+    constexpr size_t MinimumMultiplyAddsPerThread = 65536;
+
+    const size_t Complexity = PanelCount * MLAS_SPARSE_SGEMM_STRIDEM * (Header->NonZeroCount + N);
+
+    size_t TargetThreadCount = (Complexity / MinimumMultiplyAddsPerThread) + 1;
+    const size_t MaximumThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+
+    if (TargetThreadCount > MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    size_t ThreadCountM = std::min(TargetThreadCount, PanelCount);
+    size_t ThreadCountN = std::min(MlasDivRoundup(TargetThreadCount, ThreadCountM), N);
+
+    WorkBlock.ThreadCountM = ptrdiff_t(ThreadCountM);
+    WorkBlock.ThreadCountN = ptrdiff_t(ThreadCountN);
+
+    MlasExecuteThreaded(MlasSparseSgemmThreaded, &WorkBlock, ptrdiff_t(ThreadCountM * ThreadCountN), ThreadPool);
+}
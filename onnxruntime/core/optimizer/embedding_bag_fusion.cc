@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Returns the EmbeddingBag mode for a reduction over the bag dimension, or nullptr if the node does not match.
+const char* GetEmbeddingBagMode(const Graph& graph, const Node& reduce_node) {
+  const char* mode = nullptr;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceSum", {1, 11, 13})) {
+    mode = "sum";
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMean", {1, 11, 13, 18})) {
+    mode = "mean";
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(reduce_node, "ReduceMax", {1, 11, 12, 13, 18})) {
+    mode = "max";
+  } else {
+    return nullptr;
+  }
+
+  // keepdims defaults to 1, which would leave the bag dimension in the output.
+  if (!optimizer_utils::IsAttributeWithExpectedValue(reduce_node, "keepdims", static_cast<int64_t>(0))) {
+    return nullptr;
+  }
+
+  // axes is an attribute before ReduceSum-13 and the other reductions in opset 18, and an input afterwards.
+  InlinedVector<int64_t> axes;
+  const auto* axes_attr = graph_utils::GetNodeAttribute(reduce_node, "axes");
+  if (axes_attr != nullptr) {
+    axes = graph_utils::RetrieveValues<int64_t>(*axes_attr);
+  } else {
+    const auto& input_defs = reduce_node.InputDefs();
+    if (input_defs.size() < 2 || !input_defs[1]->Exists() ||
+        !optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[1], axes)) {
+      return nullptr;
+    }
+  }
+
+  if (axes.size() != 1 || (axes[0] != 1 && axes[0] != -2)) {
+    return nullptr;
+  }
+
+  return mode;
+}
+
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& gather_node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(gather_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather_node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, gather_node, 1)) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(gather_node, "axis");
+    if (axis_attr != nullptr && axis_attr->i() != 0) {
+      continue;
+    }
+
+    // EmbeddingBag produces float output, so only float tables keep the data type of the original pattern.
+    const auto& gather_inputs = gather_node.InputDefs();
+    const auto* table_type = gather_inputs[0]->TypeAsProto();
+    const auto* table_shape = gather_inputs[0]->Shape();
+    const auto* indices_shape = gather_inputs[1]->Shape();
+    if (table_type == nullptr ||
+        table_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+        table_shape == nullptr || table_shape->dim_size() != 2 ||
+        indices_shape == nullptr || indices_shape->dim_size() != 2) {
+      continue;
+    }
+
+    Node& reduce_node = *graph.GetNode(gather_node.OutputNodesBegin()->Index());
+    if (reduce_node.GetExecutionProviderType() != gather_node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    const char* mode = GetEmbeddingBagMode(graph, reduce_node);
+    if (mode == nullptr) {
+      continue;
+    }
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                             "EmbeddingBag",
+                                             "fused Gather and " + reduce_node.OpType(),
+                                             {gather_node.MutableInputDefs()[0], gather_node.MutableInputDefs()[1]},
+                                             {},
+                                             nullptr,
+                                             kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(mode));
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    embedding_bag_node.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
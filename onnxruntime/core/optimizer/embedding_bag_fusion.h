@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EmbeddingBagFusion
+
+Fuses a Gather of the rows of a 2-D float table with 2-D indices, followed by a ReduceSum, ReduceMean or ReduceMax
+over the bag dimension, into com.microsoft.EmbeddingBag, which reduces the rows of each bag without materializing
+the gathered rows.
+
+      table   indices (num_bags, bag_size)
+          \   /
+          Gather                       table   indices
+            |           ==>                \   /
+   ReduceSum/Mean/Max                   EmbeddingBag
+  (axes=[1], keepdims=0)
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <deque>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -129,6 +130,9 @@ class NchwcTransformerImpl {
   void TransformResize(Node& node);
   void TrackTransposeFromNhwc(Node& node);
 
+  bool IsNchwcDepthwiseConv(const Node& node);
+  void FuseSeparableConv(Node& depthwise_node, Node& pointwise_node);
+
   Graph& graph_;
 
   // Stores a queue of nodes to be removed after walking through the graph.
@@ -160,6 +164,11 @@ class NchwcTransformerImpl {
   // NHWC to NCHW format.
   Node* transpose_from_nhwc_node_{nullptr};
   NodeArg* transpose_from_nhwc_output_arg_{nullptr};
+
+  // Stores the NCHWc depthwise convolution outputs that are consumed by a
+  // pointwise convolution. The pairs are fused in Finalize() after any
+  // activation or Add/Sum fusions have been applied to the pointwise node.
+  InlinedVector<std::pair<NchwcArgument*, Node*>> separable_convs_;
 };
 
 size_t NchwcTransformerImpl::RemoveOutputEdges(Node& node) {
@@ -497,6 +506,23 @@ void NchwcTransformerImpl::TransformConv(Node& node) {
       nchwc_node.MutableInputDefs()[0] = nchwc_input->nchwc_arg_;
       nchwc_input->remaining_original_uses_--;
       ConvPoolShapeInference(node, nchwc_input->shape_, output_shape, conv_W_tensor_proto);
+
+      // Check if this is a pointwise convolution that consumes the single use
+      // output of a depthwise convolution.
+      if ((group_count == 1) && ((input_channels % nchwc_block_size) == 0) &&
+          (conv_W_tensor_proto->dims(2) == 1) && (conv_W_tensor_proto->dims(3) == 1) &&
+          (nchwc_input->starting_original_uses_ == 1) &&
+          IsNchwcDepthwiseConv(nchwc_input->output_node_)) {
+        const auto* strides_attr = graph_utils::GetNodeAttribute(node, "strides");
+        const auto* pads_attr = graph_utils::GetNodeAttribute(node, "pads");
+        auto is_all_value = [](const ONNX_NAMESPACE::AttributeProto* attr, int64_t value) {
+          return attr == nullptr || std::all_of(attr->ints().begin(), attr->ints().end(),
+                                                [value](int64_t v) { return v == value; });
+        };
+        if (is_all_value(strides_attr, 1) && is_all_value(pads_attr, 0)) {
+          separable_convs_.emplace_back(nchwc_input, &nchwc_node);
+        }
+      }
     }
   }
 
@@ -504,6 +530,34 @@ void NchwcTransformerImpl::TransformConv(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
+bool NchwcTransformerImpl::IsNchwcDepthwiseConv(const Node& node) {
+  if ((node.OpType() != "Conv") || (node.Domain() != kMSNchwcDomain)) {
+    return false;
+  }
+
+  // Bail out if the convolution has been fused with an Add/Sum node.
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() > 3) {
+    return false;
+  }
+
+  const ONNX_NAMESPACE::TensorProto* conv_W_tensor_proto = nullptr;
+  if (!graph_.GetInitializedTensor(input_defs[1]->Name(), conv_W_tensor_proto) ||
+      (conv_W_tensor_proto->dims_size() != 4)) {
+    return false;
+  }
+
+  const auto* group_attr = graph_utils::GetNodeAttribute(node, "group");
+  if (group_attr == nullptr || !utils::HasInt(*group_attr) ||
+      (group_attr->i() != conv_W_tensor_proto->dims(0)) ||
+      (conv_W_tensor_proto->dims(1) != 1)) {
+    return false;
+  }
+
+  // Exclude the 1x1 depthwise convolutions generated for BatchNormalization.
+  return (conv_W_tensor_proto->dims(2) != 1) || (conv_W_tensor_proto->dims(3) != 1);
+}
+
 void NchwcTransformerImpl::TransformPool(Node& node) {
   auto& input_defs = node.MutableInputDefs();
   auto& output_defs = node.MutableOutputDefs();
@@ -1190,6 +1244,49 @@ void NchwcTransformerImpl::Transform(Node& node) {
   // format.
 }
 
+void NchwcTransformerImpl::FuseSeparableConv(Node& depthwise_node, Node& pointwise_node) {
+  auto& depthwise_input_defs = depthwise_node.MutableInputDefs();
+  auto& pointwise_input_defs = pointwise_node.MutableInputDefs();
+  auto* empty_arg = &graph_.GetOrCreateNodeArg("", nullptr);
+
+  auto get_input = [empty_arg](std::vector<NodeArg*>& input_defs, size_t index) {
+    return (index < input_defs.size() && input_defs[index]->Exists()) ? input_defs[index] : empty_arg;
+  };
+
+  InlinedVector<NodeArg*, 6> input_defs{depthwise_input_defs[0],
+                                        depthwise_input_defs[1],
+                                        get_input(depthwise_input_defs, 2),
+                                        pointwise_input_defs[1],
+                                        get_input(pointwise_input_defs, 2)};
+  if (pointwise_input_defs.size() > 3) {
+    input_defs.push_back(pointwise_input_defs[3]);
+  }
+
+  // The depthwise convolution supplies the convolution attributes and the
+  // pointwise activation is renamed to apply to the final output.
+  std::string nchwc_node_name = graph_.GenerateNodeName(pointwise_node.Name() + "_separable");
+  Node& nchwc_node = graph_.AddNode(nchwc_node_name,
+                                    "SeparableConv",
+                                    nchwc_node_name,
+                                    input_defs,
+                                    pointwise_node.MutableOutputDefs(),
+                                    &depthwise_node.GetAttributes(),
+                                    kMSNchwcDomain);
+  nchwc_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+  for (const char* attr_name : {"activation", "activation_params"}) {
+    const auto* attr = graph_utils::GetNodeAttribute(pointwise_node, attr_name);
+    if (attr != nullptr) {
+      ONNX_NAMESPACE::AttributeProto pointwise_attr(*attr);
+      pointwise_attr.set_name(std::string("pointwise_") + attr_name);
+      nchwc_node.AddAttributeProto(std::move(pointwise_attr));
+    }
+  }
+
+  graph_.RemoveNode(depthwise_node.Index());
+  graph_.RemoveNode(pointwise_node.Index());
+}
+
 void NchwcTransformerImpl::Finalize(bool& modified) {
   // Create ReorderOutput nodes for any NCHWc outputs that still have uses with
   // the original tensor format.
@@ -1209,6 +1306,15 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
     }
   }
 
+  // Fuse the depthwise and pointwise convolutions if the depthwise output is
+  // not needed elsewhere in the original tensor format.
+  for (auto& separable_conv : separable_convs_) {
+    if (separable_conv.first->remaining_original_uses_ == 0) {
+      FuseSeparableConv(separable_conv.first->output_node_, *separable_conv.second);
+      modified = true;
+    }
+  }
+
   for (auto index : removed_nodes_) {
     graph_.RemoveNode(index);
   }
@@ -87,6 +87,34 @@ std::vector<NodeAndMoveInfo> WhereMoves() {
       MoveAll(q, ArgType::kOutput)};
   return moves;
 }
+
+// moves for replacing LayerNormalization with a DQ input for X and float Scale and B.
+// LayerNormReplaceWithQLinear gives the target an empty B first if it has none.
+std::vector<NodeAndMoveInfo> LayerNormMoves() {
+  NTO::NodeLocation dq_x{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq_x, ArgType::kInput),                              // append all inputs from x
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput),  // append Scale
+      MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),  // append B
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),       // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput),       // append zp (input 2) from q
+      MoveAll(q, ArgType::kOutput)};
+  return moves;
+}
+
+// B is optional in LayerNormalization. Give the target an empty B so Y_scale and Y_zero_point still land in their
+// QLinearLayerNormalization slots.
+void AddMissingLayerNormBias(Graph& graph, const NodesToOptimize& selected_nodes) {
+  Node& target = selected_nodes.Target();
+  if (target.InputDefs().size() < 3) {
+    target.MutableInputDefs().push_back(&graph.GetOrCreateNodeArg("", nullptr));
+    target.MutableInputArgsCount().push_back(1);
+  }
+}
+
 QDQReplaceWithNew SplitReplacer() {
   NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
   NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
@@ -241,6 +269,23 @@ ConvReplaceWithQLinear::ConvReplaceWithQLinear()
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
+LayerNormReplaceWithQLinear::LayerNormReplaceWithQLinear()
+    : ReplaceWithQLinear(kMSDomain, LayerNormMoves()) {
+}
+
+Status LayerNormReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  AddMissingLayerNormBias(graph, selected_nodes);
+  return ReplaceWithQLinear::Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status LayerNormReplaceWithQLinear::RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                                               const SatRuntimeOptimizationSaveContext& save_context,
+                                               SavedState& saved_state, bool& graph_modified) const {
+  AddMissingLayerNormBias(graph, selected_nodes);
+  return ReplaceWithQLinear::RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
 MatMulReplaceWithQLinear::MatMulReplaceWithQLinear()
     : matmul_int_to_float_replacer_{MatMulIntToFloatReplacer()},
       qlinear_matmul_replacer_{kOnnxDomain} {
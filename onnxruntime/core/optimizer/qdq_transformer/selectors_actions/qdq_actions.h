@@ -62,6 +62,17 @@ struct ConvReplaceWithQLinear : ReplaceWithQLinear {
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
 };
+struct LayerNormReplaceWithQLinear : ReplaceWithQLinear {
+  LayerNormReplaceWithQLinear();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& graph, const NodesToOptimize& selected_nodes,
+                    const SatRuntimeOptimizationSaveContext& save_context,
+                    SavedState& saved_state, bool& graph_modified) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+};
 struct SplitReplaceWithQuant : public Action {
   Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
 };
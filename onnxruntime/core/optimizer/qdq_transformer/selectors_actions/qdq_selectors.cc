@@ -6,6 +6,7 @@
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 
 #include "core/graph/graph.h"
+#include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/shared/utils.h"
@@ -349,6 +350,36 @@ bool InstanceNormalizationNodeGroupSelector::Check(const GraphViewer& graph_view
          (dt_bias == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32);
 }
 
+bool LayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                                const Node& node,
+                                                const std::vector<const Node*>& dq_nodes,
+                                                const std::vector<const Node*>& q_nodes) const {
+  // only X is quantized. Scale and B stay float.
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1)) {
+    return false;
+  }
+
+  if (dq_nodes[0]->OutputDefs()[0] != node.InputDefs()[0]) {
+    return false;
+  }
+
+  // X and Scale are required, B is optional
+  const int num_inputs = NumActualValues(node, true);
+  if (num_inputs != 2 && num_inputs != 3) {
+    return false;
+  }
+
+  // QLinearLayerNormalization computes the row statistics in float
+  const auto* stash_type = graph_utils::GetNodeAttribute(node, "stash_type");
+  if (stash_type != nullptr && stash_type->i() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  return dt_input == dt_output;
+}
+
 bool BatchNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer,
                                                 const Node& node,
                                                 const std::vector<const Node*>& dq_nodes,
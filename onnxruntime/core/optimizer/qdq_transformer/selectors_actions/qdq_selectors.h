@@ -160,6 +160,14 @@ class BatchNormalizationNodeGroupSelector : public NodeGroupSelector {
   bool int8_allowed_;
 };
 
+// DQ node for X, float Scale and optional B -> LayerNormalization -> Q
+class LayerNormalizationNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 /*
  * NodeSelector instances for use in the QDQ::SelectorActionTransformer.
  */
@@ -266,6 +274,14 @@ class BatchNormalizationSelector : public BaseSelector {
       : BaseSelector(std::make_unique<BatchNormalizationNodeGroupSelector>(int8_allowed)) {}
 };
 
+// Input: DQ node for X. Scale and the optional B (bias) are not quantized.
+// Output: Q node for output
+class LayerNormalizationSelector : public BaseSelector {
+ public:
+  LayerNormalizationSelector()
+      : BaseSelector(std::make_unique<LayerNormalizationNodeGroupSelector>()) {}
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
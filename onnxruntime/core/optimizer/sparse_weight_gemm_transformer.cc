@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/sparse_weight_gemm_transformer.h"
+
+#include <algorithm>
+#include <string>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Small weights are cheap enough with the dense kernels and are left alone.
+constexpr int64_t kMinimumWeightElements = 4096;
+
+// A float is zero when all its bits other than the sign are clear. TensorProto raw data is little endian.
+size_t CountNonZeroRawFloats(const std::string& raw_data) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(raw_data.data());
+  size_t non_zero_count = 0;
+  for (size_t i = 0; i + sizeof(float) <= raw_data.size(); i += sizeof(float)) {
+    non_zero_count += (bytes[i] | bytes[i + 1] | bytes[i + 2] | (bytes[i + 3] & 0x7f)) != 0;
+  }
+  return non_zero_count;
+}
+
+bool IsSparseWeight(const Graph& graph, const NodeArg& weight_arg, float density_threshold) {
+  const ONNX_NAMESPACE::TensorProto* weight_tensor_proto =
+      graph_utils::GetConstantInitializer(graph, weight_arg.Name());
+  if (weight_tensor_proto == nullptr ||
+      weight_tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+      weight_tensor_proto->dims_size() != 2) {
+    return false;
+  }
+
+  const int64_t weight_size = utils::GetTensorShapeFromTensorProto(*weight_tensor_proto).Size();
+  if (weight_size < kMinimumWeightElements) {
+    return false;
+  }
+
+  // count the non-zero elements in place. only external data has to be read into a buffer first.
+  size_t non_zero_count = 0;
+  if (utils::HasExternalData(*weight_tensor_proto)) {
+    Initializer weight{*weight_tensor_proto, graph.ModelPath()};
+    const auto weight_data = weight.DataAsSpan<float>();
+    non_zero_count = static_cast<size_t>(std::count_if(weight_data.begin(), weight_data.end(),
+                                                        [](float value) { return value != 0.0f; }));
+  } else if (utils::HasRawData(*weight_tensor_proto)) {
+    non_zero_count = CountNonZeroRawFloats(weight_tensor_proto->raw_data());
+  } else {
+    const auto& float_data = weight_tensor_proto->float_data();
+    non_zero_count = static_cast<size_t>(std::count_if(float_data.begin(), float_data.end(),
+                                                        [](float value) { return value != 0.0f; }));
+  }
+
+  return static_cast<float>(non_zero_count) <= density_threshold * static_cast<float>(weight_size);
+}
+
+}  // namespace
+
+Status SparseWeightGemmTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                              const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const bool is_gemm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {7, 9, 11, 13});
+    if (!is_gemm && !graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+      continue;
+    }
+
+    const auto& input_defs = node.InputDefs();
+
+    if (is_gemm) {
+      // A transposed left hand side is not supported by the sparse kernel.
+      const auto* trans_a_attr = graph_utils::GetNodeAttribute(node, "transA");
+      if (trans_a_attr != nullptr && trans_a_attr->i() != 0) {
+        continue;
+      }
+    } else {
+      // MatMul promotes a 1-D A to a matrix and removes the dimension from the output, so require the rank of A
+      // to be known. The rank of B is checked below.
+      const auto* a_shape = input_defs[0]->Shape();
+      if (a_shape == nullptr || a_shape->dim_size() < 2) {
+        continue;
+      }
+    }
+
+    if (!IsSparseWeight(graph, *input_defs[1], density_threshold_)) {
+      continue;
+    }
+
+    Node& sparse_gemm = graph.AddNode(graph.GenerateNodeName(node.Name() + "_sparse_weight"),
+                                      "SparseWeightGemm",
+                                      "SparseWeightGemm for " + node.OpType() + " " + node.Name(),
+                                      node.MutableInputDefs(), {}, nullptr, kMSDomain);
+
+    if (is_gemm) {
+      for (const char* attr_name : {"transB", "alpha", "beta"}) {
+        const auto* attr = graph_utils::GetNodeAttribute(node, attr_name);
+        if (attr != nullptr) {
+          sparse_gemm.AddAttributeProto(*attr);
+        }
+      }
+    }
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    sparse_gemm.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {node}, sparse_gemm);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
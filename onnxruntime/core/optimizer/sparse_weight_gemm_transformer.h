@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SparseWeightGemmTransformer
+
+Replaces MatMul and Gemm nodes whose B input is a constant float matrix with a small ratio of non-zero
+elements (e.g. a pruned model) by com.microsoft.SparseWeightGemm. That kernel packs the non-zero
+elements at session initialization and skips the zero elements during multiplication.
+*/
+class SparseWeightGemmTransformer : public GraphTransformer {
+ public:
+  SparseWeightGemmTransformer(float density_threshold,
+                              const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SparseWeightGemmTransformer", compatible_execution_providers),
+        density_threshold_(density_threshold) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  float density_threshold_;
+};
+
+}  // namespace onnxruntime
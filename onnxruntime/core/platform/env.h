@@ -186,6 +186,14 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /**
+   * Hints that the given range of mapped memory will be accessed in random order, so the pages around an accessed
+   * page don't need to be read ahead. The default implementation does nothing.
+   * @param addr The start of the range.
+   * @param length The length in bytes of the range.
+   */
+  virtual void AdviseRandomAccess(const void* /*addr*/, size_t /*length*/) const {}
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -455,6 +455,17 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  void AdviseRandomAccess(const void* addr, size_t length) const override {
+    if (addr == nullptr || length == 0) {
+      return;
+    }
+
+    static const long page_size = sysconf(_SC_PAGESIZE);
+    const uintptr_t offset_to_page = reinterpret_cast<uintptr_t>(addr) % static_cast<uintptr_t>(page_size);
+    // the hint is best effort, a failure leaves the default read ahead in place
+    madvise(const_cast<char*>(static_cast<const char*>(addr)) - offset_to_page, length + offset_to_page, MADV_RANDOM);
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetSystemError();
     std::ostringstream oss;
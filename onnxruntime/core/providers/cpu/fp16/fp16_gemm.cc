@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// This file contains implementation of fp16 MatMul and Gemm operators.
+//
+
+#include "core/common/safeint.h"
+#include "core/framework/float16.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/gemm_helper.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+
+/**
+ * @brief MatMul Operator for FP16 tensors
+ *
+ * fp16 is used as the storage format: MLAS reads the fp16 inputs directly and,
+ * on CPUs without fp16 arithmetic, widens them to fp32 inside the GEMM kernel.
+ * So no fp32 copy of the weights or activations is ever materialized.
+ *
+ * These kernels are only registered when MlasHalfGemmAccelerationSupported()
+ * reports an optimized MLAS half precision GEMM for the current CPU.
+ */
+class MatMulFp16 final : public OpKernel {
+ public:
+  MatMulFp16(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+Status MatMulFp16::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const Tensor* a = context->Input<Tensor>(0);
+  const Tensor* b = context->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = context->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+  auto* y_data = y->MutableData<MLFloat16>();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  if (K == 0) {
+    std::fill_n(y_data, y->Shape().Size(), MLFloat16(static_cast<uint16_t>(0)));
+    return Status::OK();
+  }
+
+  const size_t max_len = helper.OutputOffsets().size();
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+
+/**
+ * @brief Gemm Operator for FP16 tensors
+ *
+ * Y = alpha * op(A) * op(B) + beta * C
+ *
+ * MLAS half precision GEMM takes row major A and B, so a transposed constant B
+ * is transposed once in PrePack, and transposed inputs that are not constant
+ * are transposed into scratch buffers. When alpha and beta are both 1 and C
+ * is a row vector, C is fused into the GEMM as the bias; otherwise alpha and
+ * beta are applied to the GEMM result in fp32.
+ */
+class GemmFp16 final : public OpKernel {
+ public:
+  GemmFp16(const OpKernelInfo& info) : OpKernel(info) {
+    int64_t temp;
+    ORT_ENFORCE(info.GetAttr<int64_t>("transA", &temp).IsOK());
+    trans_A_ = temp != 0;
+
+    ORT_ENFORCE(info.GetAttr<int64_t>("transB", &temp).IsOK());
+    trans_B_ = temp != 0;
+
+    ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
+    ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  bool trans_A_;
+  bool trans_B_;
+  float alpha_;
+  float beta_;
+
+  // B transposed into K x N when transB is set and B is a constant initializer.
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
+Status GemmFp16::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                         /*out*/ bool& is_packed,
+                         /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only a transposed matrix B needs packing, MLAS reads row major B in place
+  if (input_idx != 1 || !trans_B_) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  const size_t N = static_cast<size_t>(shape[0]);
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t packed_b_size = SafeInt<size_t>(N) * K * sizeof(MLFloat16);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasTranspose(tensor.Data<MLFloat16>(), static_cast<MLFloat16*>(packed_b_data), N, K);
+  b_shape_ = shape;
+  is_packed = true;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  return Status::OK();
+}
+
+Status GemmFp16::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                           int input_idx,
+                                           /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status GemmFp16::Compute(OpKernelContext* context) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const Tensor* A = context->Input<Tensor>(0);
+  const Tensor* B = packed_b_ ? nullptr : context->Input<Tensor>(1);
+  const Tensor* C = context->Input<Tensor>(2);
+  const auto& b_shape = B ? B->Shape() : b_shape_;
+
+  // Bias could be missing. Treat as scalar 0 if that is the case.
+  GemmHelper helper(A->Shape(), trans_A_, b_shape, trans_B_,
+                    C != nullptr ? C->Shape() : TensorShape({}));
+  if (!helper.State().IsOK())
+    return helper.State();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  Tensor* Y = context->Output(0, {helper.M(), helper.N()});
+
+  // if input is empty tensor, return as nothing need to be calculated and we've set the shape for the output
+  if (M == 0 || N == 0)
+    return Status::OK();
+
+  auto* y_data = Y->MutableData<MLFloat16>();
+  const MLFloat16* c_data = (C != nullptr && beta_ != 0.0f) ? C->Data<MLFloat16>() : nullptr;
+
+  // Fuse C as the bias of the GEMM when it is a row vector that needs no scaling.
+  const bool fuse_bias = c_data != nullptr && alpha_ == 1.0f && beta_ == 1.0f &&
+                         static_cast<size_t>(C->Shape().Size()) == N &&
+                         (C->Shape().NumDimensions() < 2 || C->Shape()[0] == 1);
+
+  if (K == 0) {
+    std::fill_n(y_data, M * N, MLFloat16(static_cast<uint16_t>(0)));
+  } else {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+    const MLFloat16* a_data = A->Data<MLFloat16>();
+    BufferUniquePtr a_buffer;
+    if (trans_A_) {
+      auto* a_transposed = static_cast<MLFloat16*>(alloc->Alloc(SafeInt<size_t>(sizeof(MLFloat16)) * M * K));
+      a_buffer = BufferUniquePtr(a_transposed, BufferDeleter(alloc));
+      MlasTranspose(a_data, a_transposed, K, M);
+      a_data = a_transposed;
+    }
+
+    const MLFloat16* b_data = packed_b_ ? static_cast<const MLFloat16*>(packed_b_.get()) : B->Data<MLFloat16>();
+    BufferUniquePtr b_buffer;
+    if (trans_B_ && !packed_b_) {
+      auto* b_transposed = static_cast<MLFloat16*>(alloc->Alloc(SafeInt<size_t>(sizeof(MLFloat16)) * K * N));
+      b_buffer = BufferUniquePtr(b_transposed, BufferDeleter(alloc));
+      MlasTranspose(b_data, b_transposed, N, K);
+      b_data = b_transposed;
+    }
+
+    MLAS_HALF_GEMM_DATA_PARAMS gemm_params;
+    gemm_params.A = a_data;
+    gemm_params.lda = K;
+    gemm_params.B = b_data;
+    gemm_params.ldb = N;
+    gemm_params.C = y_data;
+    gemm_params.ldc = N;
+    gemm_params.Bias = fuse_bias ? c_data : nullptr;
+    MlasHalfGemmBatch(M, N, K, 1, &gemm_params, thread_pool);
+
+    if (fuse_bias || (alpha_ == 1.0f && c_data == nullptr)) {
+      return Status::OK();
+    }
+  }
+
+  // Y = alpha * Y + beta * C, with C broadcast to (M, N) as validated by GemmHelper.
+  const TensorShape* c_shape = c_data != nullptr ? &C->Shape() : nullptr;
+  for (size_t m = 0; m < M; m++) {
+    MLFloat16* y_row = y_data + m * N;
+    for (size_t n = 0; n < N; n++) {
+      float value = alpha_ * y_row[n].ToFloat();
+      if (c_shape != nullptr) {
+        size_t c_index;
+        if (c_shape->Size() == 1) {
+          // C is (), (1,) or (1, 1)
+          c_index = 0;
+        } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+          // C is (N,) or (1, N)
+          c_index = n;
+        } else if ((*c_shape)[1] == 1) {
+          // C is (M, 1)
+          c_index = m;
+        } else {
+          // C is (M, N)
+          c_index = m * N + n;
+        }
+        value += beta_ * c_data[c_index].ToFloat();
+      }
+      y_row[n] = MLFloat16(value);
+    }
+  }
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMulFp16);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMulFp16);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    Gemm,
+    11,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    GemmFp16);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Gemm,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    GemmFp16);
+
+}  // namespace onnxruntime
@@ -25,6 +25,9 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -140,6 +143,230 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Float values are selected with a radix select on their bits instead of nth_element on indirect comparisons.
+template <class Comparator>
+constexpr bool kUseRadixSelect = std::is_same_v<Comparator, GreaterValueCmp<float>> ||
+                                 std::is_same_v<Comparator, LesserValueCmp<float>>;
+
+// Returns whether to select the top k of n values with a heap rather than nth_element or the radix select.
+// from testing various batch sizes relative to k, the following appears to work well as a selector.
+// tested with following combinations
+//   batch_size = [ 8, 16, 32, 64, 128, 256, 512, 1024, 2048 ]
+//            k = [ 1, 2, 4, 6, 8, 16, 24, 32, 48, 64, 128 ]
+// the radix select, used for contiguous float values, is faster than the heap once k is above about sqrt(n).
+template <class Comparator>
+static bool UsePriorityQueue(const unsigned k, int64_t n, bool contiguous) {
+  const double max_log_ratio = kUseRadixSelect<Comparator> && contiguous ? 0.5 : 0.725;
+  return k != 1 && (k < 4 || (std::log2(k) / std::log2(n)) < max_log_ratio);
+}
+
+// Maps a float to an unsigned key with the same ordering. -0.0f is mapped to the key of 0.0f as the comparators
+// treat them as equal.
+static inline uint32_t OrderedFloatKey(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (bits == 0x80000000u) {
+    bits = 0;
+  }
+  return (bits & 0x80000000u) != 0 ? ~bits : (bits | 0x80000000u);
+}
+
+// Selects the indices of the top k values of input_data[begin, end) with a most significant digit first radix
+// select. Each pass builds a histogram of one digit of the remaining candidates, selects the candidates in the
+// buckets before the bucket holding the k-th value and keeps only that bucket as the candidates for the next digit.
+// The candidates stay in index order, so ties in the last bucket go to the lower index as with the comparators.
+// The selected indices are not sorted.
+template <bool Largest>
+static void RadixSelectTopK(const float* input_data, int64_t begin, int64_t end, const unsigned k,
+                            int64_t* selected, std::vector<int64_t>& candidates) {
+  constexpr int kDigitBits[] = {11, 11, 10};
+  constexpr int kDigitShifts[] = {21, 10, 0};
+  uint32_t histogram[1 << 11];
+
+  // the best value has the smallest key
+  auto key_of = [input_data](int64_t idx) {
+    const uint32_t key = OrderedFloatKey(input_data[idx]);
+    return Largest ? ~key : key;
+  };
+
+  size_t num_selected = 0;
+  size_t remaining = k;
+  bool first_pass = true;
+  candidates.clear();
+
+  for (int d = 0; d < 3 && remaining > 0; ++d) {
+    const uint32_t digit_mask = (1u << kDigitBits[d]) - 1;
+    const int shift = kDigitShifts[d];
+    std::fill_n(histogram, digit_mask + 1, 0u);
+
+    if (first_pass) {
+      for (int64_t idx = begin; idx < end; ++idx) {
+        ++histogram[(key_of(idx) >> shift) & digit_mask];
+      }
+    } else {
+      for (int64_t idx : candidates) {
+        ++histogram[(key_of(idx) >> shift) & digit_mask];
+      }
+    }
+
+    uint32_t pivot = 0;
+    size_t before_pivot = 0;
+    while (before_pivot + histogram[pivot] < remaining) {
+      before_pivot += histogram[pivot];
+      ++pivot;
+    }
+
+    // everything before the pivot bucket is selected, and the pivot bucket is narrowed down by the next digit
+    size_t num_candidates = 0;
+    auto partition = [&](int64_t idx) {
+      const uint32_t digit = (key_of(idx) >> shift) & digit_mask;
+      if (digit < pivot) {
+        selected[num_selected++] = idx;
+      } else if (digit == pivot) {
+        candidates[num_candidates++] = idx;
+      }
+    };
+
+    if (first_pass) {
+      candidates.resize(histogram[pivot]);
+      for (int64_t idx = begin; idx < end; ++idx) {
+        partition(idx);
+      }
+      first_pass = false;
+    } else {
+      // compacting in place is safe as num_candidates never passes the element being read
+      for (size_t i = 0, n = candidates.size(); i < n; ++i) {
+        partition(candidates[i]);
+      }
+      candidates.resize(num_candidates);
+    }
+
+    remaining -= before_pivot;
+    if (remaining == candidates.size()) {
+      break;
+    }
+  }
+
+  // the remaining candidates are either all needed or all have the same value
+  for (size_t i = 0; i < remaining; ++i) {
+    selected[num_selected++] = candidates[i];
+  }
+}
+
+// Selects the indices of the top k values of the contiguous range input_data[begin, end) into 'selected'.
+// The selected indices are sorted if sort_top_k is true.
+template <class Comparator>
+static void SelectTopKOfRange(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                              int64_t begin, int64_t end, const unsigned k, bool sort_top_k,
+                              int64_t* selected, std::vector<int64_t>& scratch) {
+  const int64_t n = end - begin;
+
+  if (k == 1) {
+    auto best = input_data[begin];
+    int64_t best_idx = begin;
+    for (int64_t l = begin + 1; l < end; ++l) {
+      if (comparer.CompareValueOnly(input_data[l], best)) {
+        best = input_data[l];
+        best_idx = l;
+      }
+    }
+    selected[0] = best_idx;
+    return;
+  }
+
+  if (UsePriorityQueue<Comparator>(k, n, true)) {
+    // same heap as the priority queue path in FindTopKElements. the values are checked against the current worst
+    // of the top k a block at a time, which the compiler can vectorize, as most blocks have nothing to insert.
+    constexpr int64_t kFilterBlockSize = 16;
+
+    int64_t l = begin;
+    for (; l < begin + k; ++l) {
+      selected[k - (l - begin) - 1] = l;
+      HeapifyIthPosition(selected, onnxruntime::narrow<size_t>(k - (l - begin) - 1), k, comparer);
+    }
+
+    auto top = input_data[selected[0]];
+    auto insert = [&](int64_t idx) {
+      // if the current value is equal to the top of the heap it won't replace it as the index will be higher.
+      if (comparer.CompareValueOnly(input_data[idx], top)) {
+        selected[0] = idx;
+        HeapifyIthPosition(selected, 0, k, comparer);
+        top = input_data[selected[0]];
+      }
+    };
+
+    for (; l + kFilterBlockSize <= end; l += kFilterBlockSize) {
+      bool any_better = false;
+      for (int64_t b = 0; b < kFilterBlockSize; ++b) {
+        any_better |= comparer.CompareValueOnly(input_data[l + b], top);
+      }
+      if (any_better) {
+        for (int64_t b = 0; b < kFilterBlockSize; ++b) {
+          insert(l + b);
+        }
+      }
+    }
+    for (; l < end; ++l) {
+      insert(l);
+    }
+  } else if constexpr (kUseRadixSelect<Comparator>) {
+    RadixSelectTopK<std::is_same_v<Comparator, GreaterValueCmp<float>>>(input_data, begin, end, k, selected, scratch);
+  } else {
+    scratch.resize(onnxruntime::narrow<size_t>(n));
+    std::iota(scratch.begin(), scratch.end(), begin);
+    std::nth_element(scratch.begin(), scratch.begin() + (k - 1), scratch.end(), comparer);
+    std::copy_n(scratch.begin(), k, selected);
+  }
+
+  if (sort_top_k) {
+    std::sort(selected, selected + k, comparer);
+  }
+}
+
+// Rows with at least two chunks of this many elements are split across threads when there are fewer rows than
+// threads, e.g. the logits of a single sequence over a large vocabulary.
+static constexpr int64_t kSplitRowMinChunkSize = 16 * 1024;
+
+// Finds the top k of each contiguous row by splitting the row into chunks that each select their own top k in
+// parallel. As the comparators are a strict total order, the top k of the row are in the union of the top k of its
+// chunks, which is then reduced to the final top k of the row.
+template <class Comparator>
+static void FindTopKElementsSplitRows(const typename Comparator::DataType* input_data,
+                                      typename Comparator::DataType* values_data, int64_t* indices_data,
+                                      int64_t rows, int64_t cols, int64_t chunks_per_row, const unsigned k,
+                                      bool sorted, concurrency::ThreadPool* threadpool) {
+  const Comparator comparer(input_data);
+  std::vector<int64_t> candidates(SafeInt<size_t>(rows) * chunks_per_row * k);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<ptrdiff_t>(rows * chunks_per_row),
+      [&](std::ptrdiff_t chunk) {
+        const int64_t row = chunk / chunks_per_row;
+        auto work = concurrency::ThreadPool::PartitionWork(chunk % chunks_per_row, chunks_per_row, cols);
+        std::vector<int64_t> scratch;
+        SelectTopKOfRange(comparer, input_data, row * cols + work.start, row * cols + work.end, k, false,
+                          candidates.data() + chunk * k, scratch);
+      });
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      threadpool, onnxruntime::narrow<ptrdiff_t>(rows),
+      [&](std::ptrdiff_t row) {
+        auto row_candidates_begin = candidates.begin() + row * chunks_per_row * k;
+        auto row_candidates_end = row_candidates_begin + chunks_per_row * k;
+        std::nth_element(row_candidates_begin, row_candidates_begin + (k - 1), row_candidates_end, comparer);
+        if (sorted) {
+          std::sort(row_candidates_begin, row_candidates_begin + k, comparer);
+        }
+
+        const auto row_offset = row * cols;
+        for (unsigned l = 0; l < k; ++l) {
+          const int64_t idx = row_candidates_begin[l];
+          values_data[row * k + l] = input_data[idx];
+          indices_data[row * k + l] = idx - row_offset;
+        }
+      });
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -165,6 +392,18 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   const int64_t block_slice = reduced_cols / k;
 
   int64_t tp_threads = concurrency::ThreadPool::DegreeOfParallelism(threadpool);
+
+  // a few long rows would leave most of the threads idle, so split the rows themselves across the threads instead.
+  if (block_slice == 1 && rows < tp_threads) {
+    const int64_t min_chunk_size = std::max(kSplitRowMinChunkSize, static_cast<int64_t>(4) * k);
+    const int64_t chunks_per_row = std::min((tp_threads + rows - 1) / rows, cols / min_chunk_size);
+    if (chunks_per_row > 1) {
+      FindTopKElementsSplitRows<Comparator>(input_data, values_data, indices_data, rows, cols, chunks_per_row, k,
+                                            sorted, threadpool);
+      return;
+    }
+  }
+
   int64_t num_threads = std::min(tp_threads, rows);  // split on rows so can't have more threads than rows
 
   // rough attempt to make sure there's enough work for each thread. if there's insufficient work the usage of
@@ -173,11 +412,7 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
   int64_t threads_needed = static_cast<int64_t>(std::floor(input_shape.Size() * k / (128 * 1024)));
   num_threads = std::max(std::min(threads_needed, num_threads), static_cast<int64_t>(1));
 
-  // from testing various batch sizes relative to k, the following appears to work well as a selector.
-  // tested with following combinations
-  //   batch_size = [ 8, 16, 32, 64, 128, 256, 512, 1024, 2048 ]
-  //            k = [ 1, 2, 4, 6, 8, 16, 24, 32, 48, 64, 128 ]
-  bool use_priority_queue = k != 1 && (k < 4 || (std::log2(k) / std::log2(num_blocks)) < 0.725);
+  bool use_priority_queue = UsePriorityQueue<Comparator>(k, num_blocks, block_slice == 1);
 
   std::function<void(std::ptrdiff_t batch)> find_top_k;
 
@@ -295,11 +530,17 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
           // we re-use a single data_holder for performance. avoids allocating memory on each iteration.
           // the call to SelectTopK overwrites any existing data so we don't need to clear on each iteration.
           std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(num_blocks));
+          std::vector<int64_t> radix_candidates;
 
           for (auto i = work.start; i < work.end; ++i) {
             auto row_offset = i * cols;
             for (int64_t j = 0; j < block_slice; ++j) {
-              SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              if (kUseRadixSelect<Comparator> && block_slice == 1) {
+                SelectTopKOfRange(comparer, input_data, row_offset, row_offset + num_blocks, k, sorted,
+                                  data_holder.data(), radix_candidates);
+              } else {
+                SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              }
 
               // Insert the top 'k' (largest or smallest) elements into the final output buffers
               for (int64_t l = 0; l < k; ++l) {
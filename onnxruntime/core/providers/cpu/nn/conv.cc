@@ -153,20 +153,107 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter of 2D convolutions
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 4) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(shape, kernel_shape));
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+  if (kernel_shape.size() != 2 || dilations.size() != 2 || strides.size() != 2 ||
+      shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = narrow<size_t>(shape[0]) / group_count;
+  const size_t input_channels = narrow<size_t>(shape[1]);
+
+  // The transform size depends on the spatial size of the input when it is
+  // known from the graph.
+  int64_t input_dims[2];
+  const int64_t* input_shape = nullptr;
+  const auto* x_shape = Node().InputDefs()[0]->Shape();
+  if (x_shape != nullptr && x_shape->dim_size() == 4 &&
+      x_shape->dim(2).has_dim_value() && x_shape->dim(3).has_dim_value()) {
+    input_dims[0] = x_shape->dim(2).dim_value();
+    input_dims[1] = x_shape->dim(3).dim_value();
+    input_shape = input_dims;
+  }
+
+  const size_t tile_size = MlasConvWinogradGetOutputTileSize(2, input_channels, filter_count, input_shape,
+                                                             kernel_shape.data(), dilations.data(), strides.data());
+  if (tile_size == 0) {
+    return Status::OK();
+  }
+
+  const size_t packed_W_size = MlasConvWinogradPackWSize(tile_size, group_count, filter_count, input_channels);
+  auto* packed_W = alloc->Alloc(packed_W_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_W, 0, packed_W_size);
+
+  packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(std::move(alloc)));
+  MlasConvWinogradPackW(tile_size, group_count, filter_count, input_channels, tensor.Data<float>(), packed_W);
+
+  winograd_tile_size_ = tile_size;
+  W_shape_ = shape;
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -233,13 +320,19 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     Beta,
                     thread_pool);
 
+    // The prepacked filter is only produced for convolutions supported by
+    // the Winograd algorithm.
+    if (packed_W_buffer_) {
+      MlasConvWinogradPrepare(&Parameters, winograd_tile_size_, &WorkingBufferSize, thread_pool);
+    }
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
 
     MlasConv(&Parameters,
              Xdata,
-             W->Data<float>(),
+             W ? W->Data<float>() : static_cast<const float*>(packed_W_buffer_.get()),
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata,
@@ -28,12 +28,27 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // Filter transformed for the Winograd algorithm by PrePack, used for 3x3
+  // convolutions with unit stride and dilation.
+  BufferUniquePtr packed_W_buffer_;
+  size_t winograd_tile_size_{0};
+  TensorShape W_shape_;
 };
 
 }  // namespace onnxruntime
@@ -26,6 +26,8 @@ class MatMulInteger final : public MatMulIntegerBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+  int GetAZeroPointIdx() const override { return IN_A_ZERO_POINT; }
+  int GetBZeroPointIdx() const override { return IN_B_ZERO_POINT; }
 };
 
 ONNX_OPERATOR_TYPED_KERNEL_EX(
@@ -116,6 +118,7 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
     gemm_params.PerColumnZeroPoints = is_b_zp_per_column;
     gemm_params.ldc = gemm_shape.N;
     gemm_params.BIsPacked = bool(packed_b_);
+    gemm_params.BIsFolded = b_is_folded_;
     gemm_params.A = a_data + helper.LeftOffsets()[batch];
     gemm_params.B = b_data + helper.RightOffsets()[batch];
     gemm_params.C = y_data + helper.OutputOffsets()[batch];
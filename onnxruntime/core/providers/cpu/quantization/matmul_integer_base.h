@@ -42,8 +42,35 @@ class MatMulIntegerBase : public OpKernel {
         std::swap(K, N);
         b_data = quantization::TransPoseInputData(b_data, b_trans_buffer, alloc, N, K);
       }
-      const size_t packed_b_size = MlasGemmPackBSize(N, K, a_is_signed, b_is_signed_);
+
+      // Fold the constant zero points of B, and of A when known, together with a
+      // constant int32 bias into the packed buffer so that the kernel does not have
+      // to recompute these corrections on every run.
+      const Tensor* b_zp_tensor = nullptr;
+      const Tensor* a_zp_tensor = nullptr;
+      const Tensor* bias_tensor = nullptr;
+      b_is_folded_ = GetBZeroPointIdx() >= 0 &&
+                     TryGetOptionalConstantInput(GetBZeroPointIdx(), b_zp_tensor) &&
+                     (b_zp_tensor == nullptr || b_zp_tensor->Shape().Size() == 1 ||
+                      (b_zp_tensor->Shape().NumDimensions() <= 2 &&
+                       b_zp_tensor->Shape().Size() == static_cast<int64_t>(N)));
+      bias_is_folded_ = b_is_folded_ && GetBiasIdx() >= 0 &&
+                        TryGetOptionalConstantInput(GetBiasIdx(), bias_tensor) &&
+                        bias_tensor != nullptr && bias_tensor->IsDataType<int32_t>() &&
+                        bias_tensor->Shape().Size() == static_cast<int64_t>(N) &&
+                        bias_tensor->Shape()[bias_tensor->Shape().NumDimensions() - 1] == static_cast<int64_t>(N);
+      if (b_is_folded_ && GetAZeroPointIdx() >= 0) {
+        // A non-constant zero point of A is reconciled by the kernel at runtime.
+        if (TryGetOptionalConstantInput(GetAZeroPointIdx(), a_zp_tensor) &&
+            a_zp_tensor != nullptr && a_zp_tensor->Shape().Size() != 1) {
+          a_zp_tensor = nullptr;
+        }
+      }
+
+      const size_t packed_b_size = b_is_folded_ ? MlasGemmPackBFoldedSize(N, K, a_is_signed, b_is_signed_)
+                                                : MlasGemmPackBSize(N, K, a_is_signed, b_is_signed_);
       if (packed_b_size == 0) {
+        b_is_folded_ = bias_is_folded_ = false;
         return Status::OK();
       }
 
@@ -55,7 +82,19 @@ class MatMulIntegerBase : public OpKernel {
       memset(packed_b_data, 0, packed_b_size);
 
       packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(std::move(alloc)));
-      MlasGemmPackB(N, K, b_data, N, a_is_signed, b_is_signed_, packed_b_data);
+      if (b_is_folded_) {
+        const uint8_t b_default_zp = 0;
+        const auto* b_zp_data = b_zp_tensor != nullptr ? static_cast<const uint8_t*>(b_zp_tensor->DataRaw())
+                                                       : &b_default_zp;
+        const bool b_zp_per_column = b_zp_tensor != nullptr && b_zp_tensor->Shape().Size() != 1;
+        const auto* a_zp_data = a_zp_tensor != nullptr ? static_cast<const uint8_t*>(a_zp_tensor->DataRaw())
+                                                       : nullptr;
+        const int32_t* bias_data = bias_is_folded_ ? bias_tensor->Data<int32_t>() : nullptr;
+        MlasGemmPackBFolded(N, K, b_data, N, a_is_signed, b_is_signed_, b_zp_data, b_zp_per_column,
+                            a_zp_data, bias_data, packed_b_data);
+      } else {
+        MlasGemmPackB(N, K, b_data, N, a_is_signed, b_is_signed_, packed_b_data);
+      }
 
       bool share_prepacked_weights = (prepacked_weights != nullptr);
       if (share_prepacked_weights) {
@@ -88,10 +127,28 @@ class MatMulIntegerBase : public OpKernel {
   virtual int GetAIdx() const { return 0; }
   virtual int GetBIdx() const = 0;
 
+  /**
+   * @return input index of the zero point of Matrix A or B, or of the int32 bias
+   *         added to the output, -1 if the operator has no such input
+   */
+  virtual int GetAZeroPointIdx() const { return -1; }
+  virtual int GetBZeroPointIdx() const { return -1; }
+  virtual int GetBiasIdx() const { return -1; }
+
   virtual bool IsBTransposed() const {
     return false;
   }
 
+  // Returns true if the optional input is either missing or a constant initializer.
+  bool TryGetOptionalConstantInput(int input_idx, const Tensor*& tensor) const {
+    tensor = nullptr;
+    const auto& input_defs = Node().InputDefs();
+    if (static_cast<size_t>(input_idx) >= input_defs.size() || !input_defs[input_idx]->Exists()) {
+      return true;
+    }
+    return Info().TryGetConstantInput(input_idx, &tensor);
+  }
+
   // Check if quantization parameter of B is supported.
   // It should be in one of the formats below:
   // 1. Scalar
@@ -128,6 +185,9 @@ class MatMulIntegerBase : public OpKernel {
   }
 
   bool b_is_signed_{true};
+  // packed_b_ also holds the zero point corrections of B and optionally the bias
+  bool b_is_folded_{false};
+  bool bias_is_folded_{false};
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
 };
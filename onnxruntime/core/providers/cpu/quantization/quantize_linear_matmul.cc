@@ -127,6 +127,7 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
     gemm_params[i].B = b_data + helper.RightOffsets()[i];
     gemm_params[i].ldb = gemm_shape.N;
     gemm_params[i].BIsPacked = bool(packed_b_);
+    gemm_params[i].BIsFolded = b_is_folded_;
     gemm_params[i].ZeroPointB = b_zp_data + helper.RightZeroPointOffsets()[i];
 
     gemm_params[i].C = gemm_output + (gemm_shape.M * gemm_shape.N * i);
@@ -35,6 +35,14 @@ class QLinearMatMul : public MatMulIntegerBase {
   int GetBIdx() const override {
     return IN_B;
   }
+
+  int GetAZeroPointIdx() const override {
+    return IN_A_ZERO_POINT;
+  }
+
+  int GetBZeroPointIdx() const override {
+    return IN_B_ZERO_POINT;
+  }
 };
 
 }  // namespace onnxruntime
\ No newline at end of file
@@ -14,7 +14,10 @@
 #include "core/util/math_cpuonly.h"
 #include "core/platform/threadpool.h"
 #include "core/common/safeint.h"
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -45,6 +48,54 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+/* Reduces the n_rows contiguous rows of size N with f_row(p, size), which returns a partial result that can be
+   combined with +, and stores f_final(total) for every row. Rows are the parallel unit when there are enough
+   of them. When there are fewer rows than threads and the rows are long, every row is also split into blocks
+   so the reduced dimension is parallelized as well, and the partial results are combined afterwards. */
+template <typename T, typename FROW, typename FFINAL>
+void ParallelReduceRowsKR(const T* data, T* out, int64_t n_rows, int64_t N, concurrency::ThreadPool* tp,
+                          FROW f_row, FFINAL f_final) {
+  // smaller blocks don't amortize the extra pass combining the partial results
+  constexpr int64_t min_block_size = 16384;
+  const int64_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  int64_t n_blocks = 1;
+  if (n_rows < dop && N >= 2 * min_block_size) {
+    n_blocks = std::min((dop + n_rows - 1) / n_rows, N / min_block_size);
+  }
+
+  if (n_blocks <= 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(n_rows), ParallelReduceFastCost(1, N, sizeof(T), 6),
+        [data, out, N, &f_row, &f_final](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t d = first; d < last; ++d) {
+            out[d] = f_final(f_row(data + d * N, N));
+          }
+        });
+    return;
+  }
+
+  const int64_t block_size = (N + n_blocks - 1) / n_blocks;
+  std::vector<T> partials(SafeInt<size_t>(n_rows) * n_blocks);
+  T* partial = partials.data();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(n_rows * n_blocks), ParallelReduceFastCost(1, block_size, sizeof(T), 6),
+      [data, partial, N, n_blocks, block_size, &f_row](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          int64_t start = (i % n_blocks) * block_size;
+          int64_t size = std::min(block_size, N - start);
+          partial[i] = size > 0 ? f_row(data + (i / n_blocks) * N + start, size) : static_cast<T>(0);
+        }
+      });
+
+  for (int64_t d = 0; d < n_rows; ++d, partial += n_blocks) {
+    T total = partial[0];
+    for (int64_t b = 1; b < n_blocks; ++b) {
+      total += partial[b];
+    }
+    out[d] = f_final(total);
+  }
+}
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -224,16 +275,10 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
-    const T* data = input.Data<T>();
-    T* out = output.MutableData<T>();
-    int64_t stridei = fast_shape[1];
-    concurrency::ThreadPool::TryParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
-        [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
-          for (ptrdiff_t d = first; d < last; ++d) {
-            out[d] = aggall(data + d * stridei, stridei);
-          }
-        });
+    ParallelReduceRowsKR<T>(
+        input.Data<T>(), output.MutableData<T>(), fast_shape[0], fast_shape[1], tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](T v) -> T { return v; });
   }
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -282,14 +327,113 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
   }
 };
 
+/* Fast reductions shared by the aggregators computing post(sum(pre(x))) over the reduced values x.
+   DERIVED provides:
+   * static T RowSum(const T* p, int64_t size): sum(pre(p[i])),
+   * static void AddRow(T* acc, const T* p, int64_t size): acc[i] += pre(p[i]),
+   * static T Finalize(T acc): post(acc).
+   Both are written with Eigen array expressions so the inner loops are vectorized. */
+template <typename T, typename DERIVED>
+class ReduceAggregatorMappedSum : public ReduceAggregator<T, T> {
+ public:
+  inline ReduceAggregatorMappedSum(int64_t N, const T& init) : ReduceAggregator<T, T>(N, init) {}
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ParallelReduceRowsKR<T>(
+        input.Data<T>(), output.MutableData<T>(), fast_shape[0], fast_shape[1], tp,
+        [](const T* p, int64_t size) -> T { return DERIVED::RowSum(p, size); },
+        [](T v) -> T { return DERIVED::Finalize(v); });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    int64_t n_rows = fast_shape[0];
+    int64_t N = fast_shape[1];
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+          std::fill(out + begin, out + end, static_cast<T>(0));
+          for (int64_t row = 0; row < n_rows; ++row) {
+            DERIVED::AddRow(out + begin, data + row * N + begin, end - begin);
+          }
+          for (ptrdiff_t j = begin; j < end; ++j) {
+            out[j] = DERIVED::Finalize(out[j]);
+          }
+        });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t n_red = fast_shape[1];
+    int64_t strideo = fast_shape[2];
+    int64_t stridei = n_red * strideo;
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 6),
+        [data, out, n_red, stridei, strideo](ptrdiff_t begin, ptrdiff_t end) {
+          for (ptrdiff_t d = begin; d < end; ++d) {
+            T* acc = out + d * strideo;
+            const T* p = data + d * stridei;
+            std::fill(acc, acc + strideo, static_cast<T>(0));
+            for (int64_t r = 0; r < n_red; ++r, p += strideo) {
+              DERIVED::AddRow(acc, p, strideo);
+            }
+            for (int64_t j = 0; j < strideo; ++j) {
+              acc[j] = DERIVED::Finalize(acc[j]);
+            }
+          }
+        });
+  }
+
+  static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceRKR(
+        input, fast_shape, output, tp,
+        [=](const T*) -> T { return 0; },
+        [=](T& value, const T* p, int64_t size) {
+          value += DERIVED::RowSum(p, size);
+        });
+    T* out = output.MutableData<T>();
+    T* end = out + fast_shape[1];
+    for (; out != end; ++out) {
+      *out = DERIVED::Finalize(*out);
+    }
+  }
+};
+
+// TVAL is the type aggall accumulates and returns, so a mixed precision caller like ReduceAllL2 can sum the squares
+// in a wider type. The reduction kernels and the fast reductions always use T.
 template <typename T, typename TVAL = T>
-class ReduceAggregatorSumSquare : public ReduceAggregator<T, TVAL> {
+class ReduceAggregatorSumSquare : public ReduceAggregatorMappedSum<T, ReduceAggregatorSumSquare<T, TVAL>> {
  public:
-  inline ReduceAggregatorSumSquare(int64_t N, const T&) : ReduceAggregator<T, TVAL>(N, 0) {}
+  inline ReduceAggregatorSumSquare(int64_t N, const T&)
+      : ReduceAggregatorMappedSum<T, ReduceAggregatorSumSquare<T, TVAL>>(N, 0) {}
   inline TVAL aggall(const T* from_data) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).squaredNorm();
+    if constexpr (std::is_same<T, TVAL>::value) {
+      return RowSum(from_data, this->N_);
+    } else {
+      return ConstEigenVectorArrayMap<T>(from_data, this->N_).template cast<TVAL>().square().sum();
+    }
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
+
+  static T RowSum(const T* p, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(p, onnxruntime::narrow<size_t>(size)).squaredNorm();
+  }
+  static void AddRow(T* acc, const T* p, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size).square();
+  }
+  static T Finalize(T acc) { return acc; }
 };
 
 template <typename T>
@@ -630,35 +774,59 @@ class ReduceAggregatorProd : public ReduceAggregator<T, T> {
 };
 
 template <typename T>
-class ReduceAggregatorL1 : public ReduceAggregator<T, T> {
+class ReduceAggregatorL1 : public ReduceAggregatorMappedSum<T, ReduceAggregatorL1<T>> {
  public:
-  inline ReduceAggregatorL1(int64_t N, const T&) : ReduceAggregator<T, T>(N, 0) {}
+  inline ReduceAggregatorL1(int64_t N, const T&) : ReduceAggregatorMappedSum<T, ReduceAggregatorL1<T>>(N, 0) {}
   inline T aggall(const T* from_data) {
-    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).cwiseAbs().sum();
+    return RowSum(from_data, this->N_);
   }
   inline void update(const T& v) { this->accumulator_ += v > 0 ? v : -v; }
+
+  static T RowSum(const T* p, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(p, onnxruntime::narrow<size_t>(size)).cwiseAbs().sum();
+  }
+  static void AddRow(T* acc, const T* p, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size).abs();
+  }
+  static T Finalize(T acc) { return acc; }
 };
 
 template <typename T>
-class ReduceAggregatorL2 : public ReduceAggregator<T, T> {
+class ReduceAggregatorL2 : public ReduceAggregatorMappedSum<T, ReduceAggregatorL2<T>> {
  public:
-  inline ReduceAggregatorL2(int64_t N, const T&) : ReduceAggregator<T, T>(N, 0) {}
+  inline ReduceAggregatorL2(int64_t N, const T&) : ReduceAggregatorMappedSum<T, ReduceAggregatorL2<T>>(N, 0) {}
   inline T aggall(const T* from_data) {
     return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).norm();
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
   inline T get_value() { return reduce_sqrt<T>(this->accumulator_); }
+
+  static T RowSum(const T* p, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(p, onnxruntime::narrow<size_t>(size)).squaredNorm();
+  }
+  static void AddRow(T* acc, const T* p, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size).square();
+  }
+  static T Finalize(T acc) { return reduce_sqrt<T>(acc); }
 };
 
 template <typename T>
-class ReduceAggregatorLogSum : public ReduceAggregator<T, T> {
+class ReduceAggregatorLogSum : public ReduceAggregatorMappedSum<T, ReduceAggregatorLogSum<T>> {
  public:
-  inline ReduceAggregatorLogSum(int64_t N, const T&) : ReduceAggregator<T, T>(N, 0) {}
+  inline ReduceAggregatorLogSum(int64_t N, const T&) : ReduceAggregatorMappedSum<T, ReduceAggregatorLogSum<T>>(N, 0) {}
   inline T aggall(const T* from_data) {
-    return reduce_log<T>(Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(from_data, onnxruntime::narrow<size_t>(this->N_)).sum());
+    return reduce_log<T>(RowSum(from_data, this->N_));
   }
   inline void update(const T& v) { this->accumulator_ += v; }
   inline T get_value() { return reduce_log<T>(this->accumulator_); }
+
+  static T RowSum(const T* p, int64_t size) {
+    return Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(p, onnxruntime::narrow<size_t>(size)).sum();
+  }
+  static void AddRow(T* acc, const T* p, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(p, size);
+  }
+  static T Finalize(T acc) { return reduce_log<T>(acc); }
 };
 
 template <typename T>
@@ -678,10 +846,142 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
     return get_value();
   }
   inline void update0(const T& v) {
-    max_ = (reduce_isinf(v) || reduce_isnan(v) || v < max_) ? max_ : v;
+    max_ = UpdateMax(max_, v);
   }
   inline void update(const T& v) { this->accumulator_ += reduce_exp(v - max_); }
   inline T get_value() { return reduce_log<T>(this->accumulator_) + max_; }
+
+  // Fast reduction. Every output takes one pass for the maximum (the same one update0 computes) and a second
+  // pass summing the shifted exponentials, vectorized with Eigen for floating point types.
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t N = fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, N, sizeof(T), 8),
+        [data, out, N](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t d = first; d < last; ++d) {
+            const T* p = data + d * N;
+            T max = RowMax(InitMax(p[0]), p, N);
+            out[d] = reduce_log<T>(RowSumExp(p, N, max)) + max;
+          }
+        });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    int64_t n_rows = fast_shape[0];
+    int64_t N = fast_shape[1];
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 8),
+        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+          ReduceColumns(data + begin, n_rows, N, end - begin, out + begin);
+        });
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t n_red = fast_shape[1];
+    int64_t strideo = fast_shape[2];
+    int64_t stridei = n_red * strideo;
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(fast_shape[1], fast_shape[2], sizeof(T), 8),
+        [data, out, n_red, stridei, strideo](ptrdiff_t begin, ptrdiff_t end) {
+          for (ptrdiff_t d = begin; d < end; ++d) {
+            ReduceColumns(data + d * stridei, n_red, strideo, strideo, out + d * strideo);
+          }
+        });
+  }
+
+  static void FastReduceRKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t d0 = fast_shape[0];
+    int64_t d2 = fast_shape[2];
+    int64_t inc = d2 * fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<ptrdiff_t>(fast_shape[1]), ParallelReduceFastCost(fast_shape[1], d0 * d2, sizeof(T), 8),
+        [data, out, d0, d2, inc](ptrdiff_t begin, ptrdiff_t last) {
+          for (ptrdiff_t d = begin; d < last; ++d) {
+            const T* p = data + d * d2;
+            T max = InitMax(p[0]);
+            for (int64_t i = 0; i < d0; ++i) {
+              max = RowMax(max, p + i * inc, d2);
+            }
+            T sum = 0;
+            for (int64_t i = 0; i < d0; ++i) {
+              sum += RowSumExp(p + i * inc, d2, max);
+            }
+            out[d] = reduce_log<T>(sum) + max;
+          }
+        });
+  }
+
+ protected:
+  static inline T InitMax(const T& v) { return reduce_isinf(v) ? static_cast<T>(0) : v; }
+  static inline T UpdateMax(const T& max, const T& v) {
+    return (reduce_isinf(v) || reduce_isnan(v) || v < max) ? max : v;
+  }
+
+  static T RowMax(T max, const T* p, int64_t size) {
+    for (int64_t i = 0; i < size; ++i) {
+      max = UpdateMax(max, p[i]);
+    }
+    return max;
+  }
+
+  static T RowSumExp(const T* p, int64_t size, T max) {
+    if constexpr (std::is_floating_point<T>::value) {
+      return (ConstEigenVectorArrayMap<T>(p, size) - max).exp().sum();
+    } else {
+      T sum = 0;
+      for (int64_t i = 0; i < size; ++i) {
+        sum += reduce_exp(p[i] - max);
+      }
+      return sum;
+    }
+  }
+
+  // Reduces n_rows rows of n_cols contiguous values, rows being row_stride apart, into out[0:n_cols].
+  static void ReduceColumns(const T* p, int64_t n_rows, int64_t row_stride, int64_t n_cols, T* out) {
+    std::vector<T> max(onnxruntime::narrow<size_t>(n_cols));
+    for (int64_t j = 0; j < n_cols; ++j) {
+      max[j] = InitMax(p[j]);
+    }
+    for (int64_t row = 0; row < n_rows; ++row) {
+      const T* r = p + row * row_stride;
+      for (int64_t j = 0; j < n_cols; ++j) {
+        max[j] = UpdateMax(max[j], r[j]);
+      }
+    }
+
+    std::fill(out, out + n_cols, static_cast<T>(0));
+    for (int64_t row = 0; row < n_rows; ++row) {
+      const T* r = p + row * row_stride;
+      if constexpr (std::is_floating_point<T>::value) {
+        EigenVectorArrayMap<T>(out, n_cols) +=
+            (ConstEigenVectorArrayMap<T>(r, n_cols) - ConstEigenVectorArrayMap<T>(max.data(), n_cols)).exp();
+      } else {
+        for (int64_t j = 0; j < n_cols; ++j) {
+          out[j] += reduce_exp(r[j] - max[j]);
+        }
+      }
+    }
+
+    for (int64_t j = 0; j < n_cols; ++j) {
+      out[j] = reduce_log<T>(out[j]) + max[j];
+    }
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
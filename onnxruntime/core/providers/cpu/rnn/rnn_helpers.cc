@@ -305,6 +305,11 @@ void ComputeGemm(const int M,
   gemm_params.ldb = static_cast<size_t>(N);
   gemm_params.ZeroPointB = &b_zero_point;
   gemm_params.BIsPacked = weights.is_prepacked_;
+  gemm_params.BIsFolded = weights.is_folded_;
+  if (weights.quant_para_->is_zero_point_per_column && weights.quant_para_->zero_point != nullptr) {
+    gemm_params.ZeroPointB = weights.quant_para_->zero_point;
+    gemm_params.PerColumnZeroPoints = true;
+  }
   gemm_params.C = C_buffer;
   gemm_params.ldc = ld_C_buffer;
   gemm_params.OutputProcessor = &output_processor;
@@ -44,6 +44,20 @@ inline Direction MakeDirection(const std::string& direction) {
             "'. Must be one of 'forward', 'reverse', or 'bidirectional'.");
 }
 
+/** Whether the two directions of a bidirectional RNN should run at the same time on the thread pool.
+The pool doesn't support nested parallel sections, so each direction then runs on one thread without using the
+pool itself. That only pays off when a time step is too small to be split well across the pool, like the small
+batches of streaming speech models. Otherwise the directions run one after the other, each using the whole pool.
+@param num_gates Number of gates sharing the recurrent GEMM of a step, e.g. 4 for LSTM.
+*/
+inline bool RunDirectionsConcurrently(concurrency::ThreadPool* thread_pool, int batch_size, int hidden_size,
+                                      int num_gates) {
+  // multiply-adds of the recurrent GEMM of one step below which the step isn't worth splitting across threads
+  constexpr int64_t kMaxConcurrentStepComplexity = 1 << 20;
+  return concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 &&
+         static_cast<int64_t>(batch_size) * num_gates * hidden_size * hidden_size < kMaxConcurrentStepComplexity;
+}
+
 /** Allocate a unique_ptr using allocator_, and return a span to the allocated memory so usage is safe
 @param allocator IAllocator to use for the allocation.
 @param size Allocation size. Number of elements of type TAlloc, or total size if TAlloc is 'void'.
@@ -167,21 +181,26 @@ struct PackedWeights {
   size_t buffer_size_;
   size_t weights_size_;
   TensorShape shape_;
+  // buffer_ also holds the zero point corrections of the quantized weights
+  bool is_folded_{false};
 };
 
 struct QuantizationParameter {
   QuantizationParameter(const float* scale,
                         const uint8_t* zero_point,
                         bool is_signed,
-                        size_t scale_size) : scale(scale),
-                                             zero_point(zero_point),
-                                             is_signed(is_signed),
-                                             scale_size(scale_size) {}
+                        size_t scale_size,
+                        bool is_zero_point_per_column = false) : scale(scale),
+                                                                 zero_point(zero_point),
+                                                                 is_signed(is_signed),
+                                                                 scale_size(scale_size),
+                                                                 is_zero_point_per_column(is_zero_point_per_column) {}
 
   const float* scale;
   const uint8_t* zero_point;
   bool is_signed;
   size_t scale_size;
+  bool is_zero_point_per_column;
 };
 
 template <typename T>
@@ -205,9 +224,11 @@ struct GemmWeights {
 
     if (packed_weights.buffer_) {
       is_prepacked_ = true;
+      is_folded_ = packed_weights.is_folded_;
       buffer_ = static_cast<uint8_t*>(packed_weights.buffer_.get()) + packed_weights.weights_size_ * idx;
     } else {
       is_prepacked_ = false;
+      is_folded_ = false;
       buffer_ = weights_data + weights_size * idx;
       weights_size_ = weights_size;
     }
@@ -223,6 +244,7 @@ struct GemmWeights {
   }
 
   bool is_prepacked_{false};
+  bool is_folded_{false};
   const void* buffer_{nullptr};
   size_t weights_size_{0};
   QuantizationParameter* quant_para_{nullptr};
@@ -75,6 +75,9 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  fused_gates_ = !use_peepholes_ && !input_forget_ &&
+                 activation_f_.func == deepcpu::sigmoid && activation_g_.func == deepcpu::tanh;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -103,10 +106,11 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WR_ = Allocate(allocator_, hidden_size_ * 4, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -325,6 +329,13 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     // after the first step this will switch to the output from the previous step
     auto previous_state = batched_hidden_state_one_step.begin() + seq_start * hidden_size_;
 
+    // once all the sequences of these rows are done the remaining steps only zero the outputs, so skip the GEMM and
+    // the gates from the longest sequence of the rows instead of the longest of the batch.
+    // training keeps computing them as the gradient reads the iofc values of every step.
+    const int rows_max_sequence_length =
+        *std::max_element(sequence_lengths.begin() + seq_start,
+                          sequence_lengths.begin() + seq_start + num_seq_to_compute_adjusted);
+
     // run through steps sequentially
     for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
@@ -333,16 +344,19 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
       span_T_iter step_out_IOFC = output_iofc.begin() + (step * batch_size_ + seq_start) * hidden_size_x4;
 
+      const bool rows_active = training_mode_ || step < rows_max_sequence_length;
+
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
       // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
-                  recurrent_weights,                                                          // R[iofc]
-                  beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4,
-                  quantized_input_or_a_.data() + (seq_start * hidden_size_),
-                  quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
-                  ttp);
+      if (rows_active)
+        ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
+                    gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
+                    recurrent_weights,                                                          // R[iofc]
+                    beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4,
+                    quantized_input_or_a_.data() + (seq_start * hidden_size_),
+                    quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
+                    ttp);
 
       DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
 
@@ -363,9 +377,10 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
       span_T_iter batched_cell_states_end = all_cell_states.end();
 
       span_T_iter step_out_IOFC_end = step_out_IOFC + num_seq_to_compute_adjusted * hidden_size_x4;
-      GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
-                       batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
-                       num_seq_to_compute_adjusted, output_sequence, batched_cell_states, batched_cell_states_end);
+      if (rows_active)
+        GateComputations(step_out_IOFC, step_out_IOFC_end, c_prev, C_prev_end, c_prev_clipped, C_prev_clipped_end,
+                         batched_output, batched_output_end, sequence_lengths, min_sequence_length, step, seq_start,
+                         num_seq_to_compute_adjusted, output_sequence, batched_cell_states, batched_cell_states_end);
 
       // copy last row to final_cell_state
       for (int lrow = seq_start; lrow < seq_start + num_seq_to_compute_adjusted; ++lrow) {
@@ -497,39 +512,48 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
-    // Input Gate
-    if (use_peepholes_) {
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
-                                   hidden_size_);
-    }
-
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
-
-    // Forget Gate
-    if (input_forget_) {
-      for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+    if (fused_gates_) {
+      // i, o and f are next to each other and the bias has the layout of a row, so this takes three passes over
+      // the row instead of eight
+      const float* pB = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, hidden_size_x4) : nullptr;
+      clip_with_bias_ptr_(clip_, pB, pi, hidden_size_x4);
+      MlasComputeLogistic(pi, pi, static_cast<size_t>(3) * hidden_size_);
+      MlasComputeTanh(pc, pc, hidden_size_);
     } else {
+      // Input Gate
       if (use_peepholes_) {
-        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_), pf,
-                                     hidden_size_);
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_),
+                                     pi, hidden_size_);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
-      activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    }
+      const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
+      activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
 
-    // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
+      // Forget Gate
+      if (input_forget_) {
+        for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+      } else {
+        if (use_peepholes_) {
+          deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_),
+                                       pf, hidden_size_);
+        }
+
+        const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
+        clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
+        activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      }
 
-    // Block Gate
-    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
-    activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+      // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
 
-    // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
+      // Block Gate
+      const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
+      activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+
+      // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
+    }
 
     // C_current. use previous C value as input, and update in-place
     float* pC_cur = pCprev_hidden_size;
@@ -553,16 +577,18 @@ void UniDirectionalLstm<T>::GateComputations(
       }
     }
 
-    // Output Gate
-    if (use_peepholes_)
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_), po,
-                                   hidden_size_);
-
-    // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("o" + row_str, po, 1, hidden_size_);
+    // Output Gate. already calculated with the other gates when they are fused, the peephole needs Ct otherwise
+    if (!fused_gates_) {
+      if (use_peepholes_)
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_),
+                                     po, hidden_size_);
+
+      // calculate 'ot'
+      const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
+      activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      // DumpMatrix("o" + row_str, po, 1, hidden_size_);
+    }
 
     // calculate 'Ht'
     float* pH =
@@ -91,6 +91,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // true for the default sigmoid/tanh gates without peepholes or coupled input and forget gates. the bias, clip
+  // and activations of all the gates of a row are then applied with one call each.
+  bool fused_gates_ = false;
+
   int num_threads_ = -1;
 
   // output_iofc_ptr_ and output_iofc_ are not used when training_mode_ is true.
@@ -106,9 +110,11 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_prev_, batched_internal_memory_prev_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
+  // the bias of the four gates in the [iofc] order of a row of output_iofc_. bias_WRi_ etc. are views into it.
+  IAllocatorUniquePtr<T> bias_WR_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
+  gsl::span<T> bias_WR_;
   gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
 
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/pad.h"
 
+#include <algorithm>
+
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -142,46 +144,6 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 using PadsVector = PadBase::PadsVector;
 
-// This is the general padding method to n-dimensionally do edge or reflection padding (based on the inputDelta values)
-template <typename T>
-static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch,
-                    size_t block_size, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    for (size_t i = 0; i < block_size; i++) {
-      *output++ = *input;
-      input += input_delta;
-    }
-    input += input_pitch;
-  }
-}
-
-// These are optimizations of PadAxis. The inner loop is removed since the innermost axis has a blockSize of 1,
-// and inputPitch and inputDelta are just a single value added each iteration.
-template <typename T>
-static void PadInnermostAxis(T* output, T* input, ptrdiff_t input_delta, size_t block_count) {
-  for (size_t block_index = 0; block_index < block_count; block_index++) {
-    *output++ = *input;
-    input += input_delta;
-  }
-}
-
-// For constant padding, there is no input, just a size to write the constant to
-template <typename T>
-static void PadAxisConstant(T* output, T constant, size_t size) {
-  if (size == 1) {
-    *output = constant;
-  } else if (size == 2) {
-    *output = constant;
-    *(output + 1) = constant;
-  } else {
-    // This would be faster with SSE instructions.
-    // That would mean to have an implementation for each type (uint8, uint32, uint64).
-    T* end = output + size;
-    for (; output != end;)
-      *output++ = constant;
-  }
-}
-
 Status PadBase::HandleDimValueZero(const Mode& mode, const TensorShape& input_shape, TensorShape& output_shape) {
   switch (mode) {
     case Mode::Constant: {
@@ -338,131 +300,123 @@ static Status PadImpl(OpKernelContext* ctx,
     return PadInputWithDimValueOfZero(ctx, mode, orig_input_shape, output_dims, value);
   }
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<T> input(input_tensor, input_shape, input_starts, input_extents, {});
-
   // output_shape need to keep original.
   TensorShape output_shape(output_dims);
   auto& output_tensor = *ctx->Output(0, output_shape);
-  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
 
-  TensorPitches output_pitches(reshaped_output_dims);
-  size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
+  const auto* input = reinterpret_cast<const T*>(input_tensor.DataRaw());
+  auto* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
 
-  // Initial skip, sum up the begin padding on each axis
-  for (size_t i = 0; i < new_dims_count; i++)
-    alignSkip += SafeInt<size_t>(reshaped_pad[i]) * output_pitches[i];
+  // negative pads may have sliced away all of the input
+  if (std::any_of(input_extents.cbegin(), input_extents.cend(), [](int64_t extent) { return extent <= 0; })) {
+    ORT_RETURN_IF_NOT(mode == Mode::Constant, "Cannot use 'edge' or 'reflect' mode when the negative pads remove ",
+                      "all the data of a dimension. Input shape:", orig_input_shape);
+    std::fill_n(output, output_shape.Size(), value);
+    return Status::OK();
+  }
 
-  ExtentAxisCounters input_counters(input_extents);
+  // Maps a coordinate of a padded axis to the coordinate in the input extent of that axis, or -1 for constant padding.
+  // Reflect folds coordinates more than one extent away back into the input, like numpy.
+  auto map_coordinate = [mode](int64_t x, int64_t extent) -> int64_t {
+    if (x >= 0 && x < extent) {
+      return x;
+    }
 
-  switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, onnxruntime::narrow<size_t>(prePad));
-          PadAxisConstant(output, value, onnxruntime::narrow<size_t>(postPad));
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, SafeInt<std::ptrdiff_t>(prePad) * inner_pitch);
-          PadAxisConstant(output, value, SafeInt<ptrdiff_t>(postPad) * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
+    switch (mode) {
+      case Mode::Constant:
+        return -1;
+      case Mode::Edge:
+        return x < 0 ? 0 : extent - 1;
+      default: {
+        if (extent == 1) {
+          return 0;
         }
+        const int64_t period = 2 * (extent - 1);
+        x = (x < 0 ? -x : x) % period;
+        return x < extent ? x : period - x;
       }
-      break;
+    }
+  };
+
+  // Every row of the innermost (flattened) output axis is either all padding or one input row with padding on each
+  // side, so the rows can be written independently and in parallel.
+  TensorPitches input_pitches(reshaped_input_dims);
+  const int64_t row_size = reshaped_output_dims[inner_axis];
+  const int64_t row_extent = input_extents[inner_axis];
+  const int64_t row_pre_pad = reshaped_pad[inner_axis];
+  const int64_t row_post_pad = reshaped_pad[inner_axis + new_dims_count];
+  // edge and reflect padding of the innermost axis copies blocks of the trailing dims that were flattened into it
+  const auto block_size = onnxruntime::narrow<int64_t>(inner_no_pad_size);
+  const int64_t num_blocks = row_extent / block_size;
+
+  auto pad_row = [&](T* out_row, const T* in_row) {
+    std::copy_n(in_row, row_extent, out_row + row_pre_pad);
+    if (mode == Mode::Constant) {
+      std::fill_n(out_row, row_pre_pad, value);
+      std::fill_n(out_row + row_pre_pad + row_extent, row_post_pad, value);
+      return;
+    }
 
-    case Mode::Edge:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadAxisConstant(axisStart - prePad, *axisStart, onnxruntime::narrow<size_t>(prePad));
-            PadAxisConstant(output, *(output - 1), onnxruntime::narrow<size_t>(postPad));
-          } else {
-            // When inner_most axis(es) do not need pad, above PadAxisConstant() do not fit for Edge mode.
-            // Also general loop below after handling first pad axis with non-pad axis works fine.
-            PadAxis(axisStart - prePad, axisStart, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis]));
-            PadAxis(output, output - inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-          }
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart, 1, -inner_pitch, inner_pitch, onnxruntime::narrow<size_t>(prePad));
-          PadAxis(output, output - inner_pitch, 1, -inner_pitch, inner_pitch, onnxruntime::narrow<size_t>(postPad));
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
+    const int64_t pre_pad_blocks = row_pre_pad / block_size;
+    for (int64_t b = 0; b < pre_pad_blocks; ++b) {
+      const int64_t x = map_coordinate(b - pre_pad_blocks, num_blocks);
+      std::copy_n(in_row + x * block_size, block_size, out_row + b * block_size);
+    }
+
+    T* post_pad_start = out_row + row_pre_pad + row_extent;
+    for (int64_t b = 0, end = row_post_pad / block_size; b < end; ++b) {
+      const int64_t x = map_coordinate(num_blocks + b, num_blocks);
+      std::copy_n(in_row + x * block_size, block_size, post_pad_start + b * block_size);
+    }
+  };
+
+  auto pad_rows = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    // output coordinates of the first row in the outer axes
+    TensorShapeVector row_index(inner_axis, 0);
+    int64_t remaining = first;
+    for (size_t d = inner_axis; d-- > 0;) {
+      row_index[d] = remaining % reshaped_output_dims[d];
+      remaining /= reshaped_output_dims[d];
+    }
+
+    for (std::ptrdiff_t row = first; row < last; ++row) {
+      T* out_row = output + row * row_size;
+
+      bool is_padding = false;
+      int64_t input_offset = input_starts[inner_axis];
+      for (size_t d = 0; d < inner_axis; ++d) {
+        const int64_t x = map_coordinate(row_index[d] - reshaped_pad[d], input_extents[d]);
+        if (x < 0) {
+          is_padding = true;
+          break;
         }
+        input_offset += (x + input_starts[d]) * input_pitches[d];
       }
-      break;
 
-    case Mode::Reflect:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          if (inner_no_pad_size == 1) {
-            PadInnermostAxis(axisStart - prePad, axisStart + prePad, -1 /* inputDelta */, onnxruntime::narrow<size_t>(prePad));
-            PadInnermostAxis(output, output - 2, -1 /* inputDelta */, onnxruntime::narrow<size_t>(postPad));
-          } else {
-            // When inner_most axis(es) do not need pad, Above PadInnermostAxis() do not fit for Reflect mode.
-            PadAxis(axisStart - prePad, axisStart + prePad, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis]));
-            PadAxis(output, output - 2 * inner_no_pad_size, 1, -ptrdiff_t(inner_no_pad_size * 2), inner_no_pad_size, onnxruntime::narrow<size_t>(pads[inner_axis + data_rank]));
-          }
-          output += postPad;
-          alignSkip = onnxruntime::narrow<size_t>(prePad);
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = onnxruntime::narrow<std::ptrdiff_t>(output_pitches[input_counters.Axis()]);
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxis(axisStart - prePad * inner_pitch, axisStart + prePad * inner_pitch, 1, -inner_pitch * 2,
-                  inner_pitch, onnxruntime::narrow<size_t>(prePad));
-          PadAxis(output, output - 2 * inner_pitch, 1, -inner_pitch * 2, inner_pitch, onnxruntime::narrow<size_t>(postPad));
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * SafeInt<size_t>(prePad);
+      if (is_padding) {
+        std::fill_n(out_row, row_size, value);
+      } else {
+        pad_row(out_row, input + input_offset);
+      }
+
+      for (size_t d = inner_axis; d-- > 0;) {
+        if (++row_index[d] < reshaped_output_dims[d]) {
+          break;
         }
+        row_index[d] = 0;
       }
-      break;
-  }
+    }
+  };
+
+  const std::ptrdiff_t num_rows = onnxruntime::narrow<std::ptrdiff_t>(output_shape.Size() / row_size);
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{static_cast<double>(row_extent * sizeof(T)), static_cast<double>(row_size * sizeof(T)),
+                   static_cast<double>(inner_axis + 1)},
+      pad_rows);
 
   return Status::OK();
 }
@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -137,20 +140,13 @@ Status PrepareForCompute(OpKernelContext* context, Prepare<TData>& p) {
 
   const auto* src_base = input_tensor->Data<TData>();
   auto* dst_base = output_tensor->MutableData<TData>();
-  const bool is_string_type = input_tensor->IsDataTypeString();
 
   auto last_indice_dimension = indice_shape[indice_shape.NumDimensions() - 1];
 
   // Re-use input for output. If input/output Tensor* are the same, do not copy.
   if (src_base != dst_base) {
-    if (is_string_type) {
-      const auto* str_begin = input_tensor->Data<std::string>();
-      const std::string* str_end = str_begin + input_shape.Size();
-      auto* dst = output_tensor->MutableData<std::string>();
-      std::copy(str_begin, str_end, dst);
-    } else {
-      memcpy((void*)dst_base, (const void*)src_base, input_tensor->SizeInBytes());
-    }
+    ParallelCopy(context->GetOperatorThreadPool(), dst_base, src_base,
+                 onnxruntime::narrow<std::ptrdiff_t>(input_shape.Size()));
   }
 
   std::vector<int64_t> element_counts(onnxruntime::narrow<size_t>(last_indice_dimension), 0LL);  // Number of elements for each input dimension
@@ -350,59 +346,126 @@ struct Func_Max_ND<BFloat16> {
   }
 };
 
+// reductions updating fewer elements than this in total are applied on the calling thread.
+constexpr uint64_t kMinParallelReductionElements = 16384;
+// updates with at least this many elements per thread are split by element rather than by output row.
+constexpr uint64_t kMinReductionBlockElements = 1024;
+
 template <typename TData>
 struct ScatterNDDispatchTarget {
   Status operator()(OpKernelContext* context, concurrency::ThreadPool* tp, ScatterND::Reduction reduction) const {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
-    auto lambda = [&](int64_t i) {
+    // applies elements [first, first + count) of update i
+    auto apply_update = [&](int64_t i, uint64_t first, uint64_t count) {
+      auto* output = prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)] + first;
+      const auto* update = prepare.input_base + i * prepare.element_to_copy + first;
       switch (reduction) {
         case ScatterND::Reduction::Add: {
           auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(output, update, count);
         } break;
         case ScatterND::Reduction::Mul: {
           auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(output, update, count);
         } break;
         case ScatterND::Reduction::Min: {
           auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(output, update, count);
         } break;
         case ScatterND::Reduction::Max: {
           auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(output, update, count);
         } break;
         default:
         case ScatterND::Reduction::None: {
           auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
+          func(output, update, count);
         } break;
       }
     };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+
+    const auto num_updates = static_cast<std::ptrdiff_t>(prepare.element_offsets.size());
+    if (reduction == ScatterND::Reduction::None) {
+      // the result of duplicate indices is undefined without a reduction, so the updates can be applied in parallel
+      concurrency::ThreadPool::TryParallelFor(
+          tp, num_updates, static_cast<double>(prepare.element_to_copy),
+          [&apply_update, &prepare](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = first; i < last; ++i) {
+              apply_update(i, 0, prepare.element_to_copy);
+            }
+          });
+      return Status::OK();
+    }
+
+    // updates with duplicate indices reduce into the same elements, so the updates of an output element must be
+    // applied in order.
+    const uint64_t element_to_copy = prepare.element_to_copy;
+    const std::ptrdiff_t dop = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    if (dop <= 1 || static_cast<uint64_t>(num_updates) * element_to_copy < kMinParallelReductionElements) {
+      for (std::ptrdiff_t i = 0; i < num_updates; ++i) {
+        apply_update(i, 0, element_to_copy);
+      }
+    } else if (element_to_copy >= static_cast<uint64_t>(dop) * kMinReductionBlockElements) {
+      // long updates: split the elements of every update across threads.
+      concurrency::ThreadPool::TryParallelFor(
+          tp, onnxruntime::narrow<std::ptrdiff_t>(element_to_copy), static_cast<double>(num_updates),
+          [&apply_update, num_updates](ptrdiff_t first, ptrdiff_t last) {
+            for (ptrdiff_t i = 0; i < num_updates; ++i) {
+              apply_update(i, static_cast<uint64_t>(first), static_cast<uint64_t>(last - first));
+            }
+          });
+    } else {
+      // short updates: every thread owns a contiguous range of output rows and applies the updates of its rows in
+      // order, so no two threads write the same row. the updates are bucketed by owner with a counting sort that
+      // keeps their order.
+      const uint64_t num_rows = static_cast<uint64_t>(context->Input<Tensor>(0)->Shape().Size()) / element_to_copy;
+      const std::ptrdiff_t num_blocks = static_cast<std::ptrdiff_t>(std::min<uint64_t>(dop, num_rows));
+      auto block_of = [&prepare, element_to_copy, num_rows, num_blocks](std::ptrdiff_t i) {
+        const uint64_t row = prepare.element_offsets[static_cast<size_t>(i)] / element_to_copy;
+        return static_cast<std::ptrdiff_t>(row * static_cast<uint64_t>(num_blocks) / num_rows);
+      };
+
+      // the updates are counted and bucketed in num_blocks chunks as well.
+      auto chunk_begin = [num_updates, num_blocks](std::ptrdiff_t c) { return num_updates * c / num_blocks; };
+      std::vector<uint64_t> positions(static_cast<size_t>(num_blocks * num_blocks), 0);
+      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t c) {
+        uint64_t* counts = positions.data() + c * num_blocks;
+        for (std::ptrdiff_t i = chunk_begin(c), end = chunk_begin(c + 1); i < end; ++i) {
+          ++counts[block_of(i)];
+        }
+      });
+
+      // positions[c * num_blocks + b] becomes where chunk c writes its first update of block b.
+      std::vector<uint64_t> block_starts(static_cast<size_t>(num_blocks) + 1);
+      uint64_t position = 0;
+      for (std::ptrdiff_t b = 0; b < num_blocks; ++b) {
+        block_starts[static_cast<size_t>(b)] = position;
+        for (std::ptrdiff_t c = 0; c < num_blocks; ++c) {
+          uint64_t& count = positions[static_cast<size_t>(c * num_blocks + b)];
+          const uint64_t next = position + count;
+          count = position;
+          position = next;
+        }
+      }
+      block_starts[static_cast<size_t>(num_blocks)] = position;
+
+      std::vector<std::ptrdiff_t> order(static_cast<size_t>(num_updates));
+      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t c) {
+        uint64_t* chunk_positions = positions.data() + c * num_blocks;
+        for (std::ptrdiff_t i = chunk_begin(c), end = chunk_begin(c + 1); i < end; ++i) {
+          order[static_cast<size_t>(chunk_positions[block_of(i)]++)] = i;
+        }
+      });
+
+      concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t b) {
+        for (uint64_t k = block_starts[static_cast<size_t>(b)], end = block_starts[static_cast<size_t>(b) + 1];
+             k < end; ++k) {
+          apply_update(order[static_cast<size_t>(k)], 0, element_to_copy);
+        }
+      });
+    }
     return Status::OK();
   }
 };
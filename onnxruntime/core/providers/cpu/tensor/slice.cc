@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -235,30 +236,29 @@ static Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
-  T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-  const auto* output_end = output + output_tensor.Shape().Size();
-
-  auto create_output = [&output, &output_end](SliceIterator<T>& slice_input_iterator) {
-    while (output < output_end) {
-      output = slice_input_iterator.CopyContiguousInnermostAxes(output);
-    }
-
-    ORT_ENFORCE(output == output_end);
-  };
-
-  if (compute_metadata.p_flattened_input_dims_) {
-    // If we were able to coalesce the input and output shapes, use the new shapes.
-    auto input_iterator2 =
-        SliceIterator<T>(input_tensor, TensorShape(compute_metadata.flattened_input_dims_), compute_metadata.starts_,
-                         compute_metadata.flattened_output_dims_, compute_metadata.steps_);
-    create_output(input_iterator2);
-  } else {
-    auto input_iterator2 = SliceIterator<T>(input_tensor, compute_metadata.starts_, compute_metadata.output_dims_,
-                                            compute_metadata.steps_);
-    create_output(input_iterator2);
+  // Slice is a strided copy: element i of the output is read from input[sum((starts[d] + i[d] * steps[d]) * pitch[d])].
+  // Use the coalesced shapes if there are any, so the copy has fewer and longer contiguous spans.
+  const bool flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+  gsl::span<const int64_t> input_dims = flattened ? gsl::span<const int64_t>(compute_metadata.flattened_input_dims_)
+                                                  : compute_metadata.input_dimensions_;
+  const TensorShapeVector& copy_dims = flattened ? compute_metadata.flattened_output_dims_
+                                                 : compute_metadata.output_dims_;
+
+  TensorPitches input_pitches(input_dims);
+  TensorPitches output_pitches(copy_dims);
+  TensorShapeVector src_strides(copy_dims.size());
+  std::ptrdiff_t src_offset = 0;
+  for (size_t i = 0; i < copy_dims.size(); ++i) {
+    src_offset += narrow<std::ptrdiff_t>(compute_metadata.starts_[i] * input_pitches[i]);
+    src_strides[i] = compute_metadata.steps_[i] * input_pitches[i];
   }
 
+  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
+  StridedCopy<T>(ctx->GetOperatorThreadPool(),
+                 reinterpret_cast<T*>(output_tensor.MutableDataRaw()), output_pitches,
+                 TensorShape(copy_dims),
+                 reinterpret_cast<const T*>(input_tensor.DataRaw()) + src_offset, src_strides);
+
   return Status::OK();
 }
 
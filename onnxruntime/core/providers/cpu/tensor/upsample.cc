@@ -873,49 +873,81 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Computes the taps of one axis. roi_start and roi_end are the roi values of the axis.
+static void SetupBicubicAxis(int64_t input_size, int64_t output_size, float scale, float roi_start, float roi_end,
+                             float cubic_coeff_a, bool exclude_outside,
+                             const GetOriginalCoordinateFunc& get_original_coordinate,
+                             BicubicAxisParams& p) {
+  const auto num_taps = narrow<size_t>(output_size) * CubicModeGridLength;
+  p.index.resize(num_taps);
+  p.weight.resize(num_taps);
+  p.out_of_bound.resize(narrow<size_t>(output_size));
+
+  for (int64_t o = 0; o < output_size; ++o) {
+    float in = scale == 1 ? static_cast<float>(o)
+                          : get_original_coordinate(static_cast<float>(o), scale,
+                                                    static_cast<float>(output_size),
+                                                    static_cast<float>(input_size),
+                                                    roi_start, roi_end);
+    p.out_of_bound[narrow<size_t>(o)] = in < 0 || in > static_cast<float>(input_size - 1);
+
+    auto in_int = static_cast<int64_t>(std::floor(in));
+    auto coeffs = GetCubicCoeffs(in - in_int, cubic_coeff_a);
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0;
+      for (int64_t i = 0, val = in_int - 1; val <= in_int + 2; val++, i++) {
+        if (val < 0 || val >= input_size) {
+          coeffs[narrow<size_t>(i)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(i)];
+      }
+    }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
+    int64_t* index = p.index.data() + o * CubicModeGridLength;
+    float* weight = p.weight.data() + o * CubicModeGridLength;
+    for (int64_t i = 0, val = in_int - 1; val <= in_int + 2; val++, i++) {
+      index[i] = std::max(static_cast<int64_t>(0), std::min(val, input_size - 1));
+      weight[i] = coeffs[narrow<size_t>(i)] / coeff_sum;
+    }
   }
+}
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+template <typename T>
+std::shared_ptr<const BicubicParams> Upsample<T>::GetBicubicParams(int64_t input_height, int64_t input_width,
+                                                                   int64_t output_height, int64_t output_width,
+                                                                   float height_scale, float width_scale,
+                                                                   const std::vector<float>& roi) const {
+  std::lock_guard<OrtMutex> lock(bicubic_params_mutex_);
+  if (bicubic_params_ &&
+      bicubic_params_->Matches(input_height, input_width, output_height, output_width,
+                               height_scale, width_scale, roi)) {
+    return bicubic_params_;
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  auto params = std::make_shared<BicubicParams>();
+  params->input_height = input_height;
+  params->input_width = input_width;
+  params->output_height = output_height;
+  params->output_width = output_width;
+  params->height_scale = height_scale;
+  params->width_scale = width_scale;
+  params->roi = roi;
+
+  SetupBicubicAxis(input_height, output_height, height_scale, roi[roi.size() / 2 - 2], roi[roi.size() - 2],
+                   cubic_coeff_a_, exclude_outside_, get_original_coordinate_, params->y);
+  SetupBicubicAxis(input_width, output_width, width_scale, roi[roi.size() / 2 - 1], roi[roi.size() - 1],
+                   cubic_coeff_a_, exclude_outside_, get_original_coordinate_, params->x);
+
+  bicubic_params_ = std::move(params);
+  return bicubic_params_;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+// Separable bicubic interpolation of NCHW data. The rows of all the images and channels are split across the
+// threads. Each thread interpolates the input rows horizontally once and keeps the last CubicModeGridLength of them,
+// so consecutive output rows reuse them, then every output row is a 4-tap weighted sum of whole rows.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -923,147 +955,82 @@ void ResizeBiCubic(int64_t batch_size,
                    int64_t input_width,
                    int64_t output_height,
                    int64_t output_width,
-                   float height_scale,
-                   float width_scale,
-                   float cubic_coeff_a,
                    bool use_extrapolation,
                    float extrapolation_value,
-                   bool exclude_outside,
-                   const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
+                   const BicubicParams& p,
+                   const T* XdataBase,
+                   T* YdataBase,
+                   concurrency::ThreadPool* tp) {
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height);
+  const auto row_width = narrow<size_t>(output_width);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      TensorOpCost{static_cast<double>(output_width * CubicModeGridLength * sizeof(T)),
+                   static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(output_width * CubicModeGridLength * 4)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // input rows interpolated in x. row_keys holds the plane * input_height + y of the row in each slot.
+        std::vector<float> rows(CubicModeGridLength * row_width);
+        std::array<int64_t, CubicModeGridLength> row_keys;
+        row_keys.fill(-1);
+
+        auto get_row = [&](int64_t plane, int64_t y) -> const float* {
+          const int64_t key = plane * input_height + y;
+          float* row = rows.data() + narrow<size_t>(y % CubicModeGridLength) * row_width;
+          int64_t& slot_key = row_keys[narrow<size_t>(y % CubicModeGridLength)];
+          if (slot_key != key) {
+            const T* Xrow = XdataBase + key * input_width;
+            const int64_t* index = p.x.index.data();
+            const float* weight = p.x.weight.data();
+            for (size_t x = 0; x < row_width; ++x, index += CubicModeGridLength, weight += CubicModeGridLength) {
+              float result = 0;
+              for (size_t i = 0; i < CubicModeGridLength; ++i) {
+                result += weight[i] * Xrow[index[i]];
+              }
+              row[x] = result;
+            }
+            slot_key = key;
           }
-        }
+          return row;
+        };
 
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
+        for (std::ptrdiff_t output_row = first; output_row < last; ++output_row) {
+          const int64_t plane = output_row / output_height;
+          const int64_t y = output_row % output_height;
+          T* Yrow = YdataBase + output_row * output_width;
 
           // when use_extrapolation is set and original index is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+          if (use_extrapolation && p.y.out_of_bound[narrow<size_t>(y)]) {
+            std::fill_n(Yrow, row_width, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
+          const int64_t* y_index = p.y.index.data() + y * CubicModeGridLength;
+          const float* y_weight = p.y.weight.data() + y * CubicModeGridLength;
+          const float* row0 = get_row(plane, y_index[0]);
+          const float* row1 = get_row(plane, y_index[1]);
+          const float* row2 = get_row(plane, y_index[2]);
+          const float* row3 = get_row(plane, y_index[3]);
+          const float w0 = y_weight[0], w1 = y_weight[1], w2 = y_weight[2], w3 = y_weight[3];
+
+          // clamping at the borders may map two taps to the same input row. the slot is then the same one,
+          // so the rows above stay valid.
+          for (size_t x = 0; x < row_width; ++x) {
+            Yrow[x] = static_cast<T>(row0[x] * w0 + row1[x] * w1 + row2[x] * w2 + row3[x] * w3);
           }
 
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+          if (use_extrapolation) {
+            for (size_t x = 0; x < row_width; ++x) {
+              if (p.x.out_of_bound[x]) {
+                Yrow[x] = static_cast<T>(extrapolation_value);
+              }
+            }
           }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1304,10 +1271,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                  output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
         }
       } else {
+        auto params = GetBicubicParams(input_height, input_width, output_height, output_width,
+                                       height_scale, width_scale, roi);
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                      height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      use_extrapolation_, extrapolation_value_, *params, X->Data<float>(),
+                      Y->MutableData<float>(),
+                      output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
       }
       return Status::OK();
     }
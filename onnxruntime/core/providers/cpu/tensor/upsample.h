@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
 #endif
+#include "core/platform/ort_mutex.h"
 #include "core/providers/cpu/tensor/upsamplebase.h"
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
@@ -58,6 +61,36 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// Taps of one axis for bicubic interpolation. For every output index there are CubicModeGridLength input indices,
+// clamped to the input, and their weights, already normalized when exclude_outside is set.
+struct BicubicAxisParams {
+  std::vector<int64_t> index;
+  std::vector<float> weight;
+  // output indices whose original coordinate is outside of the input, used with extrapolation
+  std::vector<uint8_t> out_of_bound;
+};
+
+struct BicubicParams {
+  // the arguments the taps were computed for
+  int64_t input_height;
+  int64_t input_width;
+  int64_t output_height;
+  int64_t output_width;
+  float height_scale;
+  float width_scale;
+  std::vector<float> roi;
+
+  BicubicAxisParams y;
+  BicubicAxisParams x;
+
+  bool Matches(int64_t in_height, int64_t in_width, int64_t out_height, int64_t out_width,
+               float h_scale, float w_scale, const std::vector<float>& roi_values) const {
+    return input_height == in_height && input_width == in_width &&
+           output_height == out_height && output_width == out_width &&
+           height_scale == h_scale && width_scale == w_scale && roi == roi_values;
+  }
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -68,6 +101,17 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const gsl::span<const int64_t>& output_dims) const;
+
+ private:
+  // Returns the bicubic taps for the arguments, reusing the ones of the previous run if they match.
+  // Models usually resize images of the same size on every run.
+  std::shared_ptr<const BicubicParams> GetBicubicParams(int64_t input_height, int64_t input_width,
+                                                        int64_t output_height, int64_t output_width,
+                                                        float height_scale, float width_scale,
+                                                        const std::vector<float>& roi) const;
+
+  mutable OrtMutex bicubic_params_mutex_;
+  mutable std::shared_ptr<const BicubicParams> bicubic_params_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
@@ -101,38 +145,51 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
-
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+  // split the rows of all images and channels across the threads, so a single image with a few channels
+  // still uses the whole pool
+  const std::ptrdiff_t num_rows = static_cast<std::ptrdiff_t>(batch_size) * num_channels * output_height;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_rows,
+      TensorOpCost{static_cast<double>(output_width * 4 * sizeof(T)), static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(output_width * 8)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const std::ptrdiff_t plane = row / output_height;
+          const auto y = static_cast<int32_t>(row % output_height);
+          const T* const Xdata = XdataBase + plane * (static_cast<std::ptrdiff_t>(input_height) * input_width);
+          T* const Ydata = YdataBase + plane * (static_cast<std::ptrdiff_t>(output_height) * output_width) +
+                           static_cast<std::ptrdiff_t>(y) * output_width;
+
+          // when use_extrapolation is set and original index of x or y is out of the dim range
+          // then use extrapolation_value as the output value.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
 
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
+          const T* const X1 = Xdata + p.input_width_mul_y1[y];
+          const T* const X2 = Xdata + p.input_width_mul_y2[y];
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+          for (int32_t x = 0; x < output_width; ++x) {
+            if (use_extrapolation && (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
+              Ydata[x] = static_cast<T>(extrapolation_value);
+              continue;
             }
+
+            T X11 = X1[p.in_x1[x]];
+            T X21 = X1[p.in_x2[x]];
+            T X12 = X2[p.in_x1[x]];
+            T X22 = X2[p.in_x2[x]];
+
+            Ydata[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                      p.dx1[x] * dy2 * X21 +
+                                      p.dx2[x] * dy1 * X12 +
+                                      p.dx1[x] * dy1 * X22);
           }
-        });
-  }
+        }
+      });
 }
 
 template <typename T, bool UseExtrapolation>
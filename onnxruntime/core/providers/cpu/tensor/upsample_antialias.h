@@ -298,23 +298,25 @@ void ComputeInterpolationAtLevel1(int64_t num_channels, int64_t input_height, in
                                   concurrency::ThreadPool* tp) {
   const uint8_t* clip8_lookups = &p.GetClip8LookupTable()[640];
 
-  concurrency::ThreadPool::TrySimpleParallelFor(
-      tp, narrow<std::ptrdiff_t>(num_channels),
-      [&](std::ptrdiff_t c) {
-        auto x_start = c * (input_height * input_width);
-        auto y_start = c * (output_height * output_width);
-
-        const InputType* Xdata = Xdata_span.data() + x_start;
-        InputType* Ydata = Ydata_span.data() + y_start;
-        // no need to do scale
-        if (output_width == input_width) {
-          std::copy_n(Xdata_span.begin() + narrow<size_t>(x_start), narrow<size_t>(output_height * output_width),
-                      Ydata_span.begin() + narrow<size_t>(y_start));
-          return;
-        }
+  // rows are independent, so split the rows of all the channels across the threads. splitting by channel only
+  // leaves most of the pool idle for images with a few channels.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_channels * output_height),
+      TensorOpCost{static_cast<double>(input_width * sizeof(InputType)),
+                   static_cast<double>(output_width * sizeof(InputType)),
+                   static_cast<double>(output_width * p_dim.window_size * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t c = row / output_height;
+          const int64_t y = row % output_height;
+          const InputType* Xdata = Xdata_span.data() + c * (input_height * input_width) + y * input_width;
+          InputType* Ydata_offset = Ydata_span.data() + c * (output_height * output_width) + y * output_width;
+          // no need to do scale
+          if (output_width == input_width) {
+            std::copy_n(Xdata, narrow<size_t>(output_width), Ydata_offset);
+            continue;
+          }
 
-        for (size_t y = 0; y < narrow<size_t>(output_height); ++y) {
-          auto* Ydata_offset = Ydata + output_width * y;
           auto* bound = p_dim.bound.data();
           for (size_t x = 0; x < narrow<size_t>(output_width); ++x) {
             AccumulateType output = is_8bit_v<InputType> ? ConstValue::mag_factor : 0;
@@ -322,7 +324,7 @@ void ComputeInterpolationAtLevel1(int64_t num_channels, int64_t input_height, in
             const auto* weight_coeff = p_dim.weight_coefficients.get() + p_dim.window_size * x;
             int64_t xmin = *bound++;
             int64_t xmax = *bound++;
-            const auto* Xdata_offset = Xdata + y * input_width + xmin;
+            const auto* Xdata_offset = Xdata + xmin;
             for (; xmin < xmax; ++xmin) {
               output += (*Xdata_offset++) * (*weight_coeff++);
             }
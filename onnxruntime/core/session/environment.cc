@@ -135,6 +135,9 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int initial_chunk_size_bytes = -1;
     int max_dead_bytes_per_chunk = -1;
     int initial_growth_chunk_size_bytes = -1;
+    size_t max_thread_cache_bytes = 0;
+    int huge_pages = 0;
+    int lock_memory = 0;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -151,10 +154,22 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
       initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
+      max_thread_cache_bytes = arena_cfg->max_thread_cache_bytes;
+
+      huge_pages = arena_cfg->huge_pages;
+      if (huge_pages < 0 || huge_pages > 3) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for huge_pages. Valid values are 0, 1, 2 or 3.");
+      }
+
+      lock_memory = arena_cfg->lock_memory;
     }
 
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
                             initial_growth_chunk_size_bytes};
+    l_arena_cfg.max_thread_cache_bytes = max_thread_cache_bytes;
+    l_arena_cfg.huge_pages = huge_pages;
+    l_arena_cfg.lock_memory = lock_memory;
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
@@ -33,6 +33,7 @@
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/shared_weights_registry.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
@@ -272,6 +273,15 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
     });
   }
 
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableMetrics, "0") == "1") {
+    const auto interval_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMetricsOpSamplingInterval, "100");
+    uint32_t op_sampling_interval = 0;
+    ORT_ENFORCE(TryParseStringWithClassicLocale(interval_str, op_sampling_interval),
+                "Invalid value for ", kOrtSessionOptionsConfigMetricsOpSamplingInterval, ": ", interval_str);
+    session_metrics_ = std::make_unique<profiling::SessionMetrics>(op_sampling_interval);
+  }
+
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
 
@@ -1017,12 +1027,33 @@ static Status LoadOrtModelBytes(const PathString& model_uri,
   return Status::OK();
 }
 
+static Status MapOrtModelBytes(const PathString& model_uri,
+                               gsl::span<const uint8_t>& bytes,
+                               Env::MappedMemoryPtr& mapped_memory) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_memory));
+
+  // the initializers are read in random order and only when they are used
+  Env::Default().AdviseRandomAccess(mapped_memory.get(), num_bytes);
+
+  bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
+
+  return Status::OK();
+}
+
 Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
-        ORT_RETURN_IF_ERROR(
-            LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyLoadInitializers,
+                                                               "0") == "1") {
+          ORT_RETURN_IF_ERROR(
+              MapOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_mapped_memory_));
+        } else {
+          ORT_RETURN_IF_ERROR(
+              LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        }
         return Status::OK();
       });
 }
@@ -1130,11 +1161,14 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
   // will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
+  // a model file mapped for lazy loading of the initializers lives as long as the session, so its bytes are always
+  // used directly.
   const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
       load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+          ort_format_model_mapped_memory_ != nullptr ||
+          (ort_format_model_bytes_data_holder_.empty() &&
+           config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1");
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -1393,6 +1427,13 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+    if (prepacked_weights_container_ == nullptr &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareWeightsAcrossSessions,
+                                                           "0") == "1") {
+      shared_prepacked_weights_container_ = SharedWeightsRegistry::Instance().GetPrepackedWeightsContainer();
+      prepacked_weights_container_ = shared_prepacked_weights_container_.get();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1409,6 +1450,7 @@ common::Status InferenceSession::Initialize() {
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
 #endif
+    session_state_->SetSessionMetrics(session_metrics_.get());
 
     // Collect the kernel registries from execution provider instances;
     // There are 2 kinds of kernel registries with priority from high to low as below,
@@ -1963,6 +2005,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
     tp = session_profiler_.Start();
   }
 
+  std::chrono::steady_clock::time_point metrics_run_start;
+  if (session_metrics_) {
+    metrics_run_start = std::chrono::steady_clock::now();
+  }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingActivity<telemetry_provider_handle> ortrun_activity;
   ortrun_activity.SetRelatedActivity(session_activity);
@@ -2093,6 +2140,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
     }
   }
 
+  if (session_metrics_) {
+    session_metrics_->RecordRun(std::chrono::steady_clock::now() - metrics_run_start, retval.IsOK());
+  }
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -2268,6 +2319,69 @@ const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+common::Status InferenceSession::GetMetricsSnapshot(std::string& snapshot) const {
+  if (!session_metrics_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Metrics are not enabled. Set the ",
+                           kOrtSessionOptionsConfigEnableMetrics, " session config entry to 1 to enable them.");
+  }
+
+  std::string labels;
+  if (!session_options_.session_logid.empty()) {
+    labels = "session=\"" + profiling::SessionMetrics::EscapeLabel(session_options_.session_logid) + "\"";
+  }
+
+  std::ostringstream os;
+  session_metrics_->WriteSnapshot(os, labels);
+
+  // gauges read at snapshot time, so they cost nothing while running
+  struct AllocatorSample {
+    std::string labels;
+    AllocatorStats stats;
+  };
+  std::vector<AllocatorSample> allocator_samples;
+  for (const auto& provider : execution_providers_) {
+    for (const auto& allocator : provider->GetAllocators()) {
+      AllocatorSample sample;
+      allocator->GetStats(&sample.stats);
+      const auto& info = allocator->Info();
+      sample.labels = labels.empty() ? labels : labels + ",";
+      sample.labels += "provider=\"" + profiling::SessionMetrics::EscapeLabel(provider->Type()) +
+                       "\",allocator=\"" + profiling::SessionMetrics::EscapeLabel(info.name) +
+                       "\",device_id=\"" + std::to_string(info.id) + "\"";
+      allocator_samples.push_back(std::move(sample));
+    }
+  }
+
+  const std::pair<const char*, int64_t AllocatorStats::*> allocator_gauges[] = {
+      {"onnxruntime_allocator_bytes_in_use", &AllocatorStats::bytes_in_use},
+      {"onnxruntime_allocator_total_allocated_bytes", &AllocatorStats::total_allocated_bytes},
+      {"onnxruntime_allocator_max_bytes_in_use", &AllocatorStats::max_bytes_in_use},
+      {"onnxruntime_allocator_num_allocs", &AllocatorStats::num_allocs},
+  };
+  for (const auto& gauge : allocator_gauges) {
+    if (allocator_samples.empty()) {
+      break;
+    }
+    os << "# TYPE " << gauge.first << " gauge\n";
+    for (const auto& sample : allocator_samples) {
+      profiling::SessionMetrics::WriteSample(os, gauge.first, nullptr, sample.labels,
+                                             static_cast<double>(sample.stats.*gauge.second));
+    }
+  }
+
+  os << "# TYPE onnxruntime_thread_pool_queue_depth gauge\n";
+  const std::string pool_labels = labels.empty() ? labels : labels + ",";
+  profiling::SessionMetrics::WriteSample(
+      os, "onnxruntime_thread_pool_queue_depth", nullptr, pool_labels + "pool=\"intra_op\"",
+      concurrency::ThreadPool::QueueDepth(session_state_ ? session_state_->GetThreadPool() : nullptr));
+  profiling::SessionMetrics::WriteSample(
+      os, "onnxruntime_thread_pool_queue_depth", nullptr, pool_labels + "pool=\"inter_op\"",
+      concurrency::ThreadPool::QueueDepth(session_state_ ? session_state_->GetInterOpThreadPool() : nullptr));
+
+  snapshot = os.str();
+  return Status::OK();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 std::vector<TuningResults> InferenceSession::GetTuningResults() const {
   std::vector<TuningResults> ret;
@@ -11,6 +11,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
+#include "core/common/session_metrics.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
@@ -25,6 +26,7 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
+#include "core/platform/env.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -443,6 +445,14 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Get a snapshot of the runtime metrics of this session in the Prometheus text exposition format.
+    * Requires the session.enable_metrics config entry.
+    @param snapshot receives the metrics
+    @return Status with an error if metrics are not enabled.
+    */
+  common::Status GetMetricsSnapshot(std::string& snapshot) const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   /**
    * Get the TuningResults of TunableOp for every execution providers.
@@ -676,10 +686,25 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Always-on runtime metrics. nullptr unless enabled with kOrtSessionOptionsConfigEnableMetrics.
+  // Declared before session_state_ which refers to it.
+  std::unique_ptr<profiling::SessionMetrics> session_metrics_;
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler memory_profiler_;
 #endif
 
+  // Container for the pre-packed weights shared with other sessions when
+  // "session.share_weights_across_sessions" is enabled and the user didn't provide one.
+  // Declared before session_state_ so the kernels using the buffers are released first.
+  std::shared_ptr<PrepackedWeightsContainer> shared_prepacked_weights_container_;
+
+  // The model file mapped into memory instead of ort_format_model_bytes_data_holder_ when the session is loaded
+  // from a model_uri with "session.lazy_load_initializers" set to "1". The initializers use the mapped bytes
+  // directly, so the mapping is kept until the InferenceSession goes away.
+  // Declared before session_state_ so the initializers are released first.
+  Env::MappedMemoryPtr ort_format_model_mapped_memory_;
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
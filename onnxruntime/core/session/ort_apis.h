@@ -459,4 +459,7 @@ ORT_API_STATUS_IMPL(CastTypeInfoToOptionalTypeInfo, _In_ const OrtTypeInfo* type
 
 ORT_API_STATUS_IMPL(GetOptionalContainedTypeInfo, _In_ const OrtOptionalTypeInfo* optional_type_info,
                     _Outptr_ OrtTypeInfo** out);
+
+ORT_API_STATUS_IMPL(SessionGetMetricsSnapshot, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
 }  // namespace OrtApis
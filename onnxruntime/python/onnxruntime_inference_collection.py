@@ -275,6 +275,14 @@ class Session:
         """
         return self._sess.end_profiling()
 
+    def get_metrics_snapshot(self):
+        """
+        Return the runtime metrics of the session in the Prometheus text exposition format.
+
+        The session must be created with the session config entry ``session.enable_metrics`` set to ``1``.
+        """
+        return self._sess.get_metrics_snapshot()
+
     def get_profiling_start_time_ns(self):
         """
         Return the nanoseconds of profiling's start time
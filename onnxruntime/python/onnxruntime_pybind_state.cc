@@ -1108,6 +1108,12 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->max_dead_bytes_per_chunk = kvp.second.cast<int>();
           } else if (key == "initial_growth_chunk_size_bytes") {
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
+          } else if (key == "max_thread_cache_bytes") {
+            ort_arena_cfg->max_thread_cache_bytes = kvp.second.cast<size_t>();
+          } else if (key == "huge_pages") {
+            ort_arena_cfg->huge_pages = kvp.second.cast<int>();
+          } else if (key == "lock_memory") {
+            ort_arena_cfg->lock_memory = kvp.second.cast<int>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1118,7 +1124,10 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("arena_extend_strategy", &OrtArenaCfg::arena_extend_strategy)
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
-      .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes);
+      .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
+      .def_readwrite("max_thread_cache_bytes", &OrtArenaCfg::max_thread_cache_bytes)
+      .def_readwrite("huge_pages", &OrtArenaCfg::huge_pages)
+      .def_readwrite("lock_memory", &OrtArenaCfg::lock_memory);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -1619,6 +1628,11 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       .def("end_profiling", [](const PyInferenceSession* sess) -> std::string {
         return sess->GetSessionHandle()->EndProfiling();
       })
+      .def("get_metrics_snapshot", [](const PyInferenceSession* sess) -> std::string {
+        std::string snapshot;
+        OrtPybindThrowIfError(sess->GetSessionHandle()->GetMetricsSnapshot(snapshot));
+        return snapshot;
+      })
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
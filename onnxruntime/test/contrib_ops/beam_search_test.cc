@@ -7,6 +7,7 @@
 #include "core/common/gsl.h"
 #include "core/session/onnxruntime_cxx_api.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
 
 extern std::unique_ptr<Ort::Env> ort_env;
 
@@ -349,5 +350,69 @@ TEST(BeamSearchTest, GptBeamSearchFp16_VocabPadded) {
     ASSERT_TRUE(std::equal(expected_output.cbegin(), expected_output.cend(), result_span.begin(), result_span.end()));
   }
 }
+
+TEST(BeamSearchTest, BeamReorderCopies) {
+  using contrib::transformers::BeamCopy;
+  using contrib::transformers::kScratchBeam;
+
+  // Beam 0 keeps its state, beams 1 and 2 exchange states, beam 4 continues beam 3 and beam 5 continues beam 0.
+  std::vector<int32_t> beam_indices = {0, 2, 1, 3, 3, 0};
+  contrib::transformers::BeamReorder reorder;
+  contrib::transformers::GetBeamReorderCopies(beam_indices, reorder);
+
+  std::vector<int32_t> states = {10, 11, 12, 13, 14, 15};
+  int32_t scratch = -1;
+  size_t moved_beams = 0;
+  for (const BeamCopy& copy : reorder.copies) {
+    int32_t value = copy.source == kScratchBeam ? scratch : states[copy.source];
+    if (copy.target == kScratchBeam) {
+      scratch = value;
+    } else {
+      states[copy.target] = value;
+      moved_beams++;
+    }
+  }
+
+  ASSERT_EQ(moved_beams, size_t{4});
+  for (size_t i = 0; i < beam_indices.size(); i++) {
+    ASSERT_EQ(states[i], 10 + beam_indices[i]);
+  }
+}
+
+TEST(BeamSearchTest, SequencesReorderInPlace) {
+  constexpr int batch_beam_size = 4;
+  constexpr int sequence_length = 2;
+  constexpr int max_length = 4;
+
+  // Space for one more sequence that is used as scratch space.
+  std::vector<int32_t> buffer((batch_beam_size + 1) * max_length, 0);
+  for (int i = 0; i < batch_beam_size; i++) {
+    buffer[i * max_length] = i;
+    buffer[i * max_length + 1] = 10 + i;
+  }
+
+  contrib::transformers::Sequences sequences;
+  sequences.Init(buffer, batch_beam_size, sequence_length, max_length);
+
+  std::vector<int32_t> beam_indices = {1, 0, 3, 3};
+  std::vector<int32_t> next_tokens = {20, 21, 22, 23};
+  gsl::span<int32_t> beam_indices_span(beam_indices);
+  gsl::span<int32_t> next_tokens_span(next_tokens);
+  sequences.AppendNextTokenToSequences(beam_indices_span, next_tokens_span);
+
+  beam_indices = {2, 1, 0, 2};
+  next_tokens = {30, 31, 32, 33};
+  sequences.AppendNextTokenToSequences(beam_indices_span, next_tokens_span);
+
+  const std::vector<std::vector<int32_t>> expected = {{3, 13, 22, 30},
+                                                      {0, 10, 21, 31},
+                                                      {1, 11, 20, 32},
+                                                      {3, 13, 22, 33}};
+  ASSERT_EQ(sequences.GetSequenceLength(), max_length);
+  for (int i = 0; i < batch_beam_size; i++) {
+    gsl::span<const int32_t> sequence = sequences.GetSequence(i);
+    ASSERT_TRUE(std::equal(expected[i].cbegin(), expected[i].cend(), sequence.begin(), sequence.end()));
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
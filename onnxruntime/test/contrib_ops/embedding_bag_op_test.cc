@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<float> kTable = {1.0f, 2.0f, 3.0f,
+                                          4.0f, 5.0f, 6.0f,
+                                          7.0f, 8.0f, 9.0f,
+                                          10.0f, 11.0f, 12.0f};
+
+TEST(EmbeddingBagTest, Sum2DIndices) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 2, 1, -1});
+  test.AddOutput<float>("Y", {2, 3}, {8.0f, 10.0f, 12.0f, 14.0f, 16.0f, 18.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MeanOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int32_t>("indices", {5}, {0, 1, 2, 3, 3});
+  test.AddInput<int32_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("Y", {3, 3}, {2.5f, 3.5f, 4.5f, 0.0f, 0.0f, 0.0f, 9.0f, 10.0f, 11.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MaxLengths) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "max");
+  test.AddAttribute<int64_t>("use_lengths", 1);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {3, 0, 1});
+  test.AddInput<int64_t>("offsets", {2}, {1, 2});
+  test.AddOutput<float>("Y", {2, 3}, {10.0f, 11.0f, 12.0f, 4.0f, 5.0f, 6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, PerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {0, 1});
+  test.AddInput<float>("per_sample_weights", {3}, {2.0f, 0.5f, -1.0f});
+  test.AddOutput<float>("Y", {2, 3}, {2.0f, 4.0f, 6.0f, -5.0f, -5.5f, -6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, RowwiseQuantizedTable) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<uint8_t>("table", {3, 2}, {10, 20, 30, 40, 50, 60});
+  test.AddInput<int64_t>("indices", {4}, {0, 1, 2, 1});
+  test.AddInput<int64_t>("offsets", {2}, {0, 2});
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("table_scale", {3}, {0.5f, 0.1f, 2.0f});
+  test.AddInput<uint8_t>("table_zero_point", {3}, {10, 0, 50});
+  test.AddOutput<float>("Y", {2, 2}, {1.5f, 4.5f, 1.5f, 12.0f});
+  test.SetOutputAbsErr("Y", 1e-5f);
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, QuantizedTableScalarScale) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<int8_t>("table", {2, 2}, {-2, 4, 6, -8});
+  test.AddInput<int32_t>("indices", {2, 2}, {0, 1, 1, 1});
+  test.AddOptionalInputEdge<int32_t>();
+  test.AddOptionalInputEdge<float>();
+  test.AddInput<float>("table_scale", {}, {0.25f});
+  test.AddOutput<float>("Y", {2, 2}, {1.0f, -1.0f, 3.0f, -4.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Float16Table) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<MLFloat16>("table", {2, 2}, ToFloat16({1.0f, 2.0f, 0.5f, -1.0f}));
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 1});
+  test.AddOutput<float>("Y", {1, 2}, {1.5f, 1.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 4});
+  test.AddOutput<float>("Y", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+TEST(EmbeddingBagTest, InvalidOffsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {2, 1});
+  test.AddOutput<float>("Y", {2, 3}, std::vector<float>(6, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "offsets must be non-decreasing");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename T>
+void RunQLinearLayerNorm(const std::vector<T>& x, float x_scale, T x_zero_point,
+                         const std::vector<float>& scale, const std::vector<float>& bias,
+                         const std::vector<T>& y, float y_scale, T y_zero_point,
+                         const std::vector<int64_t>& shape) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", -1);
+  test.AddAttribute<float>("epsilon", 1e-5f);
+  const std::vector<int64_t> norm_shape{shape.back()};
+  test.AddInput<T>("X", shape, x);
+  test.AddInput<float>("X_scale", {}, {x_scale}, true);
+  test.AddInput<T>("X_zero_point", {}, {x_zero_point}, true);
+  test.AddInput<float>("Scale", norm_shape, scale, true);
+  if (bias.empty()) {
+    test.AddOptionalInputEdge<float>();
+  } else {
+    test.AddInput<float>("B", norm_shape, bias, true);
+  }
+  test.AddInput<float>("Y_scale", {}, {y_scale}, true);
+  test.AddInput<T>("Y_zero_point", {}, {y_zero_point}, true);
+  test.AddOutput<T>("Y", shape, y);
+  test.Run();
+}
+
+TEST(QLinearLayerNormTest, UInt8) {
+  RunQLinearLayerNorm<uint8_t>({100, 128, 156, 200,
+                                0, 255, 128, 64},
+                               0.1f, 128,
+                               {1.0f, 0.5f, 2.0f, -1.0f},
+                               {0.1f, -0.2f, 0.0f, 0.3f},
+                               {105, 119, 139, 105,
+                                106, 139, 135, 144},
+                               0.05f, 128,
+                               {2, 4});
+}
+
+TEST(QLinearLayerNormTest, Int8) {
+  RunQLinearLayerNorm<int8_t>({-28, 0, 28, 72,
+                               -128, 127, 0, -64},
+                              0.1f, 0,
+                              {1.0f, 0.5f, 2.0f, -1.0f},
+                              {0.1f, -0.2f, 0.0f, 0.3f},
+                              {-23, -9, 11, -23,
+                               -22, 11, 7, 16},
+                              0.05f, 0,
+                              {1, 2, 4});
+}
+
+TEST(QLinearLayerNormTest, NoBias) {
+  RunQLinearLayerNorm<uint8_t>({100, 128, 156, 200,
+                                0, 255, 128, 64},
+                               0.1f, 128,
+                               {1.0f, 0.5f, 2.0f, -1.0f},
+                               {},
+                               {103, 123, 139, 99,
+                                104, 143, 135, 138},
+                               0.05f, 128,
+                               {2, 4});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
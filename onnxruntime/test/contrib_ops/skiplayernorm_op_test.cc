@@ -701,5 +701,48 @@ TEST(SkipLayerNormTest, SkipSimplifiedLayerNormBatch1_Float16) {
 }
 #endif
 
+TEST(SkipLayerNormTest, SkipSimplifiedLayerNormBatch1_Bias) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> skip_data = {
+      0.1f, -0.2f, 0.3f, 1.0f,
+      0.5f, 0.3f, 0.1f, 0.2f};
+
+  std::vector<float> gamma_data = {
+      0.3f, 0.2f, 4.0f, 2.2f};
+
+  std::vector<float> bias_data = {
+      0.1f, 0.2f, -0.1f, 0.0f};
+
+  std::vector<float> output_data = {
+      0.260870f, -0.086957f, 0.695652f, 3.826087f,
+      0.472636f, 0.200512f, 1.718676f, -1.260362f};
+
+  std::vector<float> skip_input_bias_add_output_data = {
+      1.0f, -0.5f, 0.2f, 2.0f,
+      1.1f, 0.7f, 0.3f, -0.4f};
+
+  RunTest(input_data,
+          skip_data,
+          gamma_data,
+          std::vector<float>(),
+          bias_data,
+          output_data,
+          skip_input_bias_add_output_data,
+          epsilon_,
+          batch_size,
+          sequence_length,
+          hidden_size,
+          false,
+          true,
+          true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Every third element of B is non-zero so that columns have a varying number of non-zero elements.
+static std::vector<float> MakeSparseWeight(int64_t K, int64_t N) {
+  std::vector<float> b(static_cast<size_t>(K * N), 0.0f);
+  for (size_t i = 0; i < b.size(); i += 3) {
+    b[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  return b;
+}
+
+static void RunSparseWeightGemm(const std::vector<int64_t>& a_shape, int64_t N, bool trans_b,
+                                float alpha, float beta, bool use_bias, bool is_b_initializer) {
+  const int64_t K = a_shape.back();
+  int64_t M = 1;
+  for (size_t i = 0; i + 1 < a_shape.size(); i++) {
+    M *= a_shape[i];
+  }
+
+  std::vector<float> a(static_cast<size_t>(M * K));
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.125f;
+  }
+  std::vector<float> b = MakeSparseWeight(K, N);
+  std::vector<float> c(static_cast<size_t>(N));
+  for (size_t i = 0; i < c.size(); i++) {
+    c[i] = static_cast<float>(i) * 0.5f;
+  }
+
+  std::vector<float> y(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a[m * K + k] * (trans_b ? b[n * K + k] : b[k * N + n]);
+      }
+      y[m * N + n] = alpha * sum + (use_bias ? beta * c[n] : 0.0f);
+    }
+  }
+
+  std::vector<int64_t> y_shape(a_shape);
+  y_shape.back() = N;
+
+  OpTester test("SparseWeightGemm", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("transB", trans_b ? 1 : 0);
+  test.AddAttribute<float>("alpha", alpha);
+  test.AddAttribute<float>("beta", beta);
+  test.AddInput<float>("A", a_shape, a);
+  test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b, is_b_initializer);
+  if (use_bias) {
+    test.AddInput<float>("C", {N}, c);
+  }
+  test.AddOutput<float>("Y", y_shape, y);
+  test.SetOutputAbsErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(SparseWeightGemmTest, MatMul) {
+  for (bool is_b_initializer : {false, true}) {
+    RunSparseWeightGemm({3, 17}, 9, false, 1.0f, 1.0f, false, is_b_initializer);
+    RunSparseWeightGemm({2, 5, 64}, 33, false, 1.0f, 1.0f, false, is_b_initializer);
+  }
+}
+
+TEST(SparseWeightGemmTest, Gemm) {
+  for (bool is_b_initializer : {false, true}) {
+    RunSparseWeightGemm({19, 48}, 20, true, 0.5f, 2.0f, true, is_b_initializer);
+    RunSparseWeightGemm({4, 31}, 16, false, 1.0f, 0.5f, true, is_b_initializer);
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/huge_page_allocator.h"
+#include "core/mlas/inc/mlas.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -103,5 +105,60 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+TEST(AllocatorTest, HugePageArenaRegions) {
+  // explicit pages usually aren't reserved on test machines, which exercises the fallback to transparent pages
+  for (int huge_pages : {1, 2, 3}) {
+    OrtArenaCfg arena_cfg{0, -1, -1, -1, -1};
+    arena_cfg.huge_pages = huge_pages;
+    AllocatorCreationInfo info{[](int) { return std::make_unique<CPUAllocator>(); }, 0, true, arena_cfg};
+    auto arena = CreateAllocator(info);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena->Info().alloc_type, OrtAllocatorType::OrtArenaAllocator);
+
+    const size_t size = 3 * 1024 * 1024 + 7;
+    void* p = arena->Alloc(size);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % kAllocAlignment, 0u);
+    memset(p, 0x5a, size);
+    EXPECT_EQ(static_cast<uint8_t*>(p)[size - 1], 0x5a);
+    arena->Free(p);
+  }
+}
+
+TEST(AllocatorTest, HugePageAllocatorRegions) {
+  HugePageAllocator allocator(std::make_unique<CPUAllocator>(), 1, /*lock_memory*/ true);
+  EXPECT_STREQ(allocator.Info().name, CPU);
+
+  void* a = allocator.Alloc(1024);
+  void* b = allocator.Alloc(5 * 1024 * 1024);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  if (HugePageAllocator::IsSupported()) {
+    // regions are mapped on huge page boundaries
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % (2 * 1024 * 1024), 0u);
+  }
+
+  memset(a, 1, 1024);
+  memset(b, 2, 5 * 1024 * 1024);
+  allocator.Free(a);
+  allocator.Free(b);
+  EXPECT_EQ(allocator.Alloc(0), nullptr);
+
+  // a power of two region isn't rounded up to another huge page, but GEMM kernels can still read past its end.
+  for (int huge_pages : {1, 3}) {
+    HugePageAllocator region_allocator(std::make_unique<CPUAllocator>(), huge_pages, /*lock_memory*/ false);
+    const size_t size = 2 * 1024 * 1024;
+    auto* c = static_cast<volatile uint8_t*>(region_allocator.Alloc(size));
+    ASSERT_NE(c, nullptr);
+    c[size - 1] = 3;
+    if (HugePageAllocator::IsSupported()) {
+      for (size_t i = 0; i < MLAS_SYMM_QGEMM_BUF_OVERRUN; i++) {
+        (void)c[size + i];
+      }
+    }
+    region_allocator.Free(const_cast<uint8_t*>(c));
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -302,6 +303,64 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestThreadCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 64 * 1024);
+
+  // freed chunk is kept by this thread and handed out again
+  void* p1 = a.Alloc(1000);
+  a.Free(p1);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 1024);
+
+  void* p2 = a.Alloc(900);
+  EXPECT_EQ(p2, p1);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.bytes_in_use, 1024);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  // a chunk freed on another thread goes back to the arena
+  std::thread([&a, p2]() { a.Free(p2); }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  // chunks cached by a thread are returned to the arena when it exits
+  std::thread([&a]() {
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 16; ++i) {
+      ptrs.push_back(a.Alloc(2048));
+    }
+    for (void* p : ptrs) {
+      a.Free(p);
+    }
+    // going over the limit returns half of the cache to the arena
+    AllocatorStats thread_stats;
+    a.GetStats(&thread_stats);
+    EXPECT_EQ(thread_stats.bytes_in_thread_caches, 16 * 2048);
+
+    void* large = a.Alloc(40 * 1024);
+    a.Free(large);
+    a.GetStats(&thread_stats);
+    EXPECT_LE(thread_stats.bytes_in_thread_caches, 32 * 1024);
+  }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+
+  // Shrink returns the cached chunks so the regions can be released
+  void* p3 = a.Alloc(4096);
+  a.Free(p3);
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -109,6 +109,66 @@ TEST_F(CopyTest, Concat2D) {
   }
 }
 
+TEST_F(CopyTest, RepeatWithZeroStride) {
+  // Tile-like copy: every row of dst is a copy of src
+  constexpr int64_t rows = 100;
+  constexpr int64_t cols = 37;
+  std::vector<int32_t> src(cols);
+  for (int64_t i = 0; i < cols; i++) {
+    src[i] = static_cast<int32_t>(i);
+  }
+  std::vector<int32_t> dst(rows * cols, -1);
+
+  StridedCopy<int32_t>(tp.get(), dst.data(), {cols, 1}, {rows, cols}, src.data(), {0, 1});
+
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t c = 0; c < cols; c++) {
+      ASSERT_EQ(src[c], dst[r * cols + c]);
+    }
+  }
+}
+
+TEST_F(CopyTest, NegativeStrides) {
+  // Slice-like copy reading every second element backwards in the inner dim and the rows in reverse
+  constexpr int64_t rows = 6;
+  constexpr int64_t cols = 10;
+  std::vector<int64_t> src(rows * cols);
+  for (int64_t i = 0; i < rows * cols; i++) {
+    src[i] = i;
+  }
+  std::vector<int64_t> dst(rows * cols / 2, -1);
+
+  const int64_t src_offset = (rows - 1) * cols + cols - 1;
+  StridedCopy<int64_t>(tp.get(), dst.data(), {cols / 2, 1}, {rows, cols / 2}, src.data() + src_offset, {-cols, -2});
+
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t c = 0; c < cols / 2; c++) {
+      ASSERT_EQ(src_offset - r * cols - 2 * c, dst[r * (cols / 2) + c]);
+    }
+  }
+}
+
+TEST_F(CopyTest, LargeParallelCopy) {
+  // big enough to be split across the threads and to use non-temporal stores where they are available,
+  // with an odd size and a misaligned destination to cover the unaligned head and tail.
+  const int64_t count = strided_copy_detail::kNonTemporalCopyMinTotalBytes / sizeof(float) + 1001;
+  std::vector<float> src(static_cast<size_t>(count));
+  for (int64_t i = 0; i < count; i++) {
+    src[i] = static_cast<float>(i % 4099);
+  }
+  std::vector<uint8_t> dst_buffer(static_cast<size_t>(count) * sizeof(float) + 1);
+  uint8_t* dst = dst_buffer.data() + 1;
+
+  ParallelCopy(tp.get(), reinterpret_cast<uint8_t*>(dst),
+               reinterpret_cast<const uint8_t*>(src.data()), count * static_cast<std::ptrdiff_t>(sizeof(float)));
+
+  EXPECT_EQ(0, memcmp(dst, src.data(), static_cast<size_t>(count) * sizeof(float)));
+
+  std::vector<float> dst_aligned(static_cast<size_t>(count));
+  ParallelCopy(tp.get(), dst_aligned.data(), src.data(), count);
+  EXPECT_EQ(src, dst_aligned);
+}
+
 TEST_F(CopyTest, CoalesceTensorsTest) {
   {
     TensorShapeVector strides_a{3, 1};
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -330,6 +331,75 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+#if !defined(ENABLE_TRAINING)
+// training builds generate patterns on lookup so the cache contents can't be checked directly.
+TEST_F(ExecutionFrameTest, MemPatternCacheTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float), output_def("Y", &tensor_float);
+  graph.AddNode("node1", "Relu", "relu", ArgMap{&input_def}, ArgMap{&output_def}).SetExecutionProviderType(xp_type);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternCacheSize, "1"));
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoryPatternShapeBuckets,
+                                                              "4,8"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  ASSERT_TRUE(state.GetMemoryPatternUsesShapeBuckets());
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->GetAllocator(OrtMemTypeDefault);
+  auto make_feeds = [&cpu_allocator](int64_t rows) {
+    std::vector<OrtValue> feeds(1);
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{rows, 2},
+                         std::vector<float>(static_cast<size_t>(rows * 2), 1.0f), &feeds[0]);
+    return feeds;
+  };
+
+  std::shared_ptr<const InlinedHashMap<int, TensorShape>> inferred_shapes;
+  auto feeds_1 = make_feeds(1);
+  ASSERT_EQ(state.GetMemoryPatternGroup(feeds_1, {}, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds_1, MemoryPatternGroup{}));
+  auto cached = state.GetMemoryPatternGroup(feeds_1, {}, inferred_shapes);
+  ASSERT_NE(cached, nullptr);
+
+  // 3 rows falls in the same bucket as 1 row so the pattern is shared.
+  auto feeds_3 = make_feeds(3);
+  ASSERT_EQ(state.GetMemoryPatternGroup(feeds_3, {}, inferred_shapes), cached);
+  // shapes inferred for another shape in the bucket don't apply to this one.
+  ASSERT_EQ(inferred_shapes, nullptr);
+
+  // 5 rows is in the next bucket. caching its pattern evicts the least recently used one.
+  auto feeds_5 = make_feeds(5);
+  ASSERT_EQ(state.GetMemoryPatternGroup(feeds_5, {}, inferred_shapes), nullptr);
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(feeds_5, MemoryPatternGroup{}));
+  ASSERT_NE(state.GetMemoryPatternGroup(feeds_5, {}, inferred_shapes), nullptr);
+  ASSERT_EQ(state.GetMemoryPatternGroup(feeds_1, {}, inferred_shapes), nullptr);
+
+  // the evicted pattern is still owned by its user.
+  ASSERT_EQ(cached.use_count(), 1);
+}
+#endif
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
@@ -16,12 +16,14 @@
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/profiler.h"
+#include "core/common/session_metrics.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_weights_registry.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/bfc_arena.h"
 #include "core/graph/graph_viewer.h"
@@ -397,6 +399,149 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, MetricsSnapshot) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MetricsSnapshot";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableMetrics, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMetricsOpSamplingInterval, "2"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  std::string snapshot;
+  ASSERT_STATUS_OK(session_object.GetMetricsSnapshot(snapshot));
+  const std::string session_label = "session=\"InferenceSessionTests.MetricsSnapshot\"";
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_runs_total{" + session_label + "} 4\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_failed_runs_total{" + session_label + "} 0\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_sampled_graph_executions_total{" + session_label + "} 2\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_run_latency_us_count{" + session_label + "} 4\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_op_latency_us_count{" + session_label +
+                                           ",op_type=\"Mul\",provider=\"CPUExecutionProvider\"} 2\n"));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_allocator_bytes_in_use{" + session_label +
+                                           ",provider=\"CPUExecutionProvider\""));
+  EXPECT_THAT(snapshot, testing::HasSubstr("onnxruntime_thread_pool_queue_depth{" + session_label +
+                                           ",pool=\"intra_op\"}"));
+
+  // metrics are off by default
+  SessionOptions so_no_metrics;
+  InferenceSession session_no_metrics{so_no_metrics, GetEnvironment()};
+  ASSERT_STATUS_OK(session_no_metrics.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_no_metrics.Initialize());
+  auto status = session_no_metrics.GetMetricsSnapshot(snapshot);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr(kOrtSessionOptionsConfigEnableMetrics));
+}
+
+TEST(InferenceSessionTests, CompiledExecution) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CompiledExecution";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableCompiledExecution, "1"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_NE(session_object.GetSessionState().GetCompiledExecutionPlan(), nullptr);
+
+  // the first Run uses the regular executor, the second compiles and the rest reuse the compiled state.
+  // the preallocated outputs of some Runs need to be rebound.
+  RunOptions run_options;
+  for (int i = 0; i < 6; ++i) {
+    RunModel(session_object, run_options, /*is_preallocate_output_vec*/ i % 2 == 1);
+  }
+
+  // a terminated Run fails and the Runs after it still succeed
+  run_options.terminate = true;
+  std::vector<int64_t> dims_x = {3, 2};
+  std::vector<float> values_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), dims_x, values_x, &ml_value);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value));
+  std::vector<std::string> output_names = {"Y"};
+  std::vector<OrtValue> fetches;
+  EXPECT_FALSE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+
+  run_options.terminate = false;
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, CpuRunCapture) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CpuRunCapture";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableCpuRunCapture, "1"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_NE(session_object.GetSessionState().GetCompiledExecutionPlan(), nullptr);
+
+  std::vector<int64_t> dims = {3, 2};
+  std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), dims, values, &input);
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", input));
+  std::vector<std::string> output_names = {"Y"};
+  std::vector<OrtValue> fetches(1);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), dims, values, &fetches[0]);
+  const float* output_buffer = fetches[0].Get<Tensor>().Data<float>();
+
+  // the first Runs generate the memory pattern, compile and capture, the rest replay.
+  // the input is updated in place like a buffer bound with IOBinding.
+  RunOptions run_options;
+  for (int i = 0; i < 5; ++i) {
+    auto input_span = input.GetMutable<Tensor>()->MutableDataAsSpan<float>();
+    std::vector<float> expected_values;
+    for (size_t j = 0; j < input_span.size(); ++j) {
+      input_span[j] = static_cast<float>(i + 1);
+      // W is 1..6
+      expected_values.push_back(input_span[j] * static_cast<float>(j + 1));
+    }
+
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    ASSERT_EQ(fetches[0].Get<Tensor>().Data<float>(), output_buffer);
+    VerifyOutputs(fetches, dims, expected_values);
+  }
+
+  // other buffers end the capture
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options, /*is_preallocate_output_vec*/ true);
+}
+
+TEST(InferenceSessionTests, LatencyHistogramBuckets) {
+  using profiling::LatencyHistogram;
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::nanoseconds(0)), 0u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::microseconds(1)), 0u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::nanoseconds(1001)), 1u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::microseconds(2)), 1u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::microseconds(1024)), 10u);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(std::chrono::hours(24 * 365)), LatencyHistogram::kNumBuckets - 1);
+
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < 1000; ++i) {
+        histogram.Record(std::chrono::microseconds(3));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto snapshot = histogram.GetSnapshot();
+  EXPECT_EQ(snapshot.count, 4000u);
+  EXPECT_EQ(snapshot.buckets[2], 4000u);
+  EXPECT_EQ(snapshot.sum_ns, 4000u * 3000u);
+}
+
 TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   SessionOptions so;
 
@@ -2792,6 +2937,56 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, ShareWeightsAcrossSessions) {
+  const char* init_name = "W";
+  const size_t num_weights_before = SharedWeightsRegistry::Instance().NumWeights();
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShareWeightsAcrossSessions";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShareWeightsAcrossSessions, "1"));
+
+  auto sess1 = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess1->Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess1->Initialize());
+
+  auto sess2 = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+  ASSERT_STATUS_OK(sess2->Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess2->Initialize());
+
+  SessionOptions so3;
+  InferenceSessionWrapper sess3{so3, GetEnvironment()};
+  ASSERT_STATUS_OK(sess3.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess3.Initialize());
+
+  int so1_idx;
+  ASSERT_STATUS_OK(sess1->GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so1_idx));
+  const auto* so1_init_buffer = sess1->GetSessionState().GetInitializedTensors().at(so1_idx).Get<Tensor>().Data<float>();
+
+  int so2_idx;
+  ASSERT_STATUS_OK(sess2->GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so2_idx));
+  const auto* so2_init_buffer = sess2->GetSessionState().GetInitializedTensors().at(so2_idx).Get<Tensor>().Data<float>();
+
+  int so3_idx;
+  ASSERT_STATUS_OK(sess3.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, so3_idx));
+  const auto* so3_init_buffer = sess3.GetSessionState().GetInitializedTensors().at(so3_idx).Get<Tensor>().Data<float>();
+
+  // both sessions that enable the option use the same weight, the other session has its own copy
+  ASSERT_EQ(so1_init_buffer, so2_init_buffer);
+  ASSERT_NE(so1_init_buffer, so3_init_buffer);
+  ASSERT_EQ(SharedWeightsRegistry::Instance().NumWeights(), num_weights_before + 1);
+
+  RunOptions run_options;
+  RunModel(*sess1, run_options);
+  RunModel(*sess2, run_options);
+
+  // the weight stays registered until the last session using it is released
+  sess1.reset();
+  RunModel(*sess2, run_options);
+  ASSERT_EQ(SharedWeightsRegistry::Instance().NumWeights(), num_weights_before + 1);
+  sess2.reset();
+  ASSERT_EQ(SharedWeightsRegistry::Instance().NumWeights(), num_weights_before);
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
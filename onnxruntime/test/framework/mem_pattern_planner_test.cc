@@ -30,10 +30,36 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
 
   pattern = planner.GenerateMemPattern();
 
-  EXPECT_EQ(pattern.PeakSize(), 1024u + 256u + 512u + 1024u + 512u);
-  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 256u + 512u + 1024u);
-  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
-  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
+  // placing the allocations in trace order needs 1024 + 256 + 512 + 1024 + 512 bytes.
+  // placing them largest first based on their lifetimes needs less.
+  EXPECT_EQ(pattern.PeakSize(), 1024u + 1024u + 512u + 512u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(3)->offset_, 1024u);
+  // 5 is allocated after 3 is freed
+  EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 1024u + 1024u);
+  EXPECT_EQ(pattern.GetBlock(4)->offset_, 1024u + 1024u + 512u);
+  // 1 is freed before 4 is allocated
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 1024u + 1024u + 512u);
+  // best fit in the gap between 5 and 2
+  EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u + 600u);
+}
+
+TEST(MemPatternPlannerTest, GreedyBySizeTest) {
+  MemPatternPlanner planner{false};
+  planner.TraceAllocation(0, 100);
+  planner.TraceAllocation(1, 200);
+  planner.TraceFree(0);
+  // the gap left by 0 is too small, so in trace order 2 would be placed after 1.
+  planner.TraceAllocation(2, 300);
+
+  auto pattern = planner.GenerateMemPattern();
+
+  EXPECT_EQ(pattern.PeakSize(), 300u + 200u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 300u);
+  // 0 is freed before 2 is allocated so it can share memory with 2
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
 }
 }  // namespace test
 }  // namespace onnxruntime
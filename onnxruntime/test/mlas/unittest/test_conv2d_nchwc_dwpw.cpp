@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasNchwcConvDepthwisePointwiseTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferDepthwiseFilter;
+  MatrixGuardBuffer<float> BufferDepthwiseBias;
+  MatrixGuardBuffer<float> BufferPointwiseFilter;
+  MatrixGuardBuffer<float> BufferPointwiseBias;
+  MatrixGuardBuffer<float> BufferIntermediate;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  const size_t BlockSize = MlasNchwcGetBlockSize();
+
+  void Test(size_t BatchCount,
+            size_t Channels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t KernelSize,
+            size_t Padding,
+            size_t Stride,
+            bool UseBias,
+            bool UseSum,
+            MLAS_ACTIVATION_KIND DepthwiseActivationKind,
+            MLAS_ACTIVATION_KIND PointwiseActivationKind) {
+    const size_t OutputHeight = (InputHeight + 2 * Padding - KernelSize) / Stride + 1;
+    const size_t OutputWidth = (InputWidth + 2 * Padding - KernelSize) / Stride + 1;
+
+    const size_t InputElements = BatchCount * Channels * InputHeight * InputWidth;
+    const size_t IntermediateElements = BatchCount * Channels * OutputHeight * OutputWidth;
+    const size_t OutputElements = BatchCount * FilterCount * OutputHeight * OutputWidth;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* DepthwiseFilter = BufferDepthwiseFilter.GetBuffer(Channels * KernelSize * KernelSize);
+    const float* DepthwiseBias = UseBias ? BufferDepthwiseBias.GetBuffer(Channels) : nullptr;
+    const float* PointwiseFilter = BufferPointwiseFilter.GetBuffer(FilterCount * Channels);
+    const float* PointwiseBias = UseBias ? BufferPointwiseBias.GetBuffer(FilterCount) : nullptr;
+    float* Intermediate = BufferIntermediate.GetBuffer(IntermediateElements);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputElements + OutputElements));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = distribution(generator);
+      OutputReference[i] = Output[i];
+    }
+
+    int64_t InputShape[] = {int64_t(BatchCount), int64_t(Channels), int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t IntermediateShape[] = {int64_t(BatchCount), int64_t(Channels), int64_t(OutputHeight), int64_t(OutputWidth)};
+    int64_t OutputShape[] = {int64_t(BatchCount), int64_t(FilterCount), int64_t(OutputHeight), int64_t(OutputWidth)};
+    int64_t KernelShape[] = {int64_t(KernelSize), int64_t(KernelSize)};
+    int64_t DilationShape[] = {1, 1};
+    int64_t PaddingShape[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {int64_t(Stride), int64_t(Stride)};
+    int64_t PointwiseKernelShape[] = {1, 1};
+    int64_t PointwisePadding[] = {0, 0, 0, 0};
+
+    MLAS_ACTIVATION DepthwiseActivation;
+    DepthwiseActivation.ActivationKind = DepthwiseActivationKind;
+    DepthwiseActivation.Parameters.LeakyRelu.alpha = 0.2f;
+
+    MLAS_ACTIVATION PointwiseActivation;
+    PointwiseActivation.ActivationKind = PointwiseActivationKind;
+    PointwiseActivation.Parameters.LeakyRelu.alpha = 0.1f;
+
+    //
+    // Compute the reference output with separate depthwise and pointwise
+    // convolutions.
+    //
+
+    MlasNchwcConv(InputShape, KernelShape, DilationShape, PaddingShape, StrideShape, IntermediateShape,
+                  Channels, Input, DepthwiseFilter, DepthwiseBias, Intermediate, &DepthwiseActivation,
+                  true, threadpool_);
+
+    MlasNchwcConv(IntermediateShape, PointwiseKernelShape, DilationShape, PointwisePadding, DilationShape,
+                  OutputShape, 1, Intermediate, PointwiseFilter, PointwiseBias, OutputReference,
+                  &PointwiseActivation, !UseSum, threadpool_);
+
+    MlasNchwcConvDepthwisePointwise(InputShape, KernelShape, DilationShape, PaddingShape, StrideShape,
+                                    OutputShape, Input, DepthwiseFilter, DepthwiseBias, &DepthwiseActivation,
+                                    PointwiseFilter, PointwiseBias, Output, &PointwiseActivation, !UseSum,
+                                    threadpool_);
+
+    ASSERT_EQ(memcmp(Output, OutputReference, OutputElements * sizeof(float)), 0)
+        << "B" << BatchCount << "/"
+        << "C" << Channels << "/"
+        << "H" << InputHeight << "/"
+        << "W" << InputWidth << "/"
+        << "F" << FilterCount << "/"
+        << "K" << KernelSize << "/"
+        << "P" << Padding << "/"
+        << "S" << Stride << "/"
+        << "Bias" << UseBias << "/"
+        << "Sum" << UseSum;
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dNchwcDepthwisePointwise_Threaded"
+                                                 : "Conv2dNchwcDepthwisePointwise_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasNchwcConvDepthwisePointwiseTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    const size_t B = BlockSize;
+
+    Test(1, B, 7, 7, B, 3, 1, 1, false, false, MlasIdentityActivation, MlasIdentityActivation);
+    Test(2, 2 * B, 13, 11, 3 * B, 3, 1, 1, true, false, MlasReluActivation, MlasIdentityActivation);
+    Test(1, 6 * B, 28, 28, 5 * B, 3, 1, 2, true, false, MlasReluActivation, MlasReluActivation);
+    Test(1, 4 * B, 15, 17, 2 * B, 5, 2, 1, true, true, MlasLeakyReluActivation, MlasIdentityActivation);
+    Test(3, 12 * B, 14, 14, 9 * B, 3, 1, 1, false, true, MlasReluActivation, MlasLeakyReluActivation);
+    Test(1, 20 * B, 56, 56, 4 * B, 3, 1, 1, true, false, MlasReluActivation, MlasIdentityActivation);
+  }
+};
+
+template <>
+MlasNchwcConvDepthwisePointwiseTest<false>* MlasTestFixture<MlasNchwcConvDepthwisePointwiseTest<false>>::mlas_tester(nullptr);
+template <>
+MlasNchwcConvDepthwisePointwiseTest<true>* MlasTestFixture<MlasNchwcConvDepthwisePointwiseTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute && MlasNchwcGetBlockSize() > 1) {
+    count += MlasDirectShortExecuteTests<MlasNchwcConvDepthwisePointwiseTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasNchwcConvDepthwisePointwiseTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferWorking;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t OutputTileSize,
+            size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t PaddingTop,
+            size_t PaddingLeft,
+            size_t PaddingBottom,
+            size_t PaddingRight,
+            float Beta,
+            MLAS_ACTIVATION_KIND ActivationKind) {
+    const size_t OutputHeight = InputHeight + PaddingTop + PaddingBottom - 2;
+    const size_t OutputWidth = InputWidth + PaddingLeft + PaddingRight - 2;
+
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t BiasElements = GroupCount * FilterCount;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(BiasElements);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputElements);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputElements + FilterElements));
+    std::uniform_real_distribution<float> distribution(-2.f, 2.f);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = distribution(generator);
+      OutputReference[i] = Output[i];
+    }
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Padding[] = {int64_t(PaddingTop), int64_t(PaddingLeft), int64_t(PaddingBottom), int64_t(PaddingRight)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.LeakyRelu.alpha = 0.1f;
+
+    //
+    // Compute the reference output with the existing algorithms.
+    //
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, Padding, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_);
+
+    MlasConv(&Parameters, Input, Filter, Bias, BufferWorking.GetBuffer(WorkingBufferSize),
+             OutputReference, threadpool_);
+
+    //
+    // Compute the output with the Winograd algorithm.
+    //
+
+    void* PackedFilter = BufferPackedFilter.GetBuffer(
+        MlasConvWinogradPackWSize(OutputTileSize, GroupCount, FilterCount, InputChannels), true);
+
+    MlasConvWinogradPackW(OutputTileSize, GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, Padding, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_);
+    MlasConvWinogradPrepare(&Parameters, OutputTileSize, &WorkingBufferSize, threadpool_);
+
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters, Input, reinterpret_cast<const float*>(PackedFilter), Bias,
+             BufferWorking.GetBuffer(WorkingBufferSize), Output, threadpool_);
+
+    //
+    // The transforms reorder the accumulation, so allow for rounding error
+    // that grows with the tile size and the reduction length.
+    //
+
+    const float Tolerance = (OutputTileSize == 4 ? 1e-5f : 4e-6f) * float(InputChannels * 9);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], Tolerance * (1.f + std::fabs(OutputReference[i])))
+          << "F(" << OutputTileSize << ") index " << i << ", "
+          << "B" << BatchCount << "/"
+          << "G" << GroupCount << "/"
+          << "Cpg" << InputChannels << "/"
+          << "Fpg" << FilterCount << "/"
+          << "H" << InputHeight << "/"
+          << "W" << InputWidth << "/"
+          << "Pad" << PaddingTop << "," << PaddingLeft << "," << PaddingBottom << "," << PaddingRight << "/"
+          << "Beta" << Beta;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t OutputTileSize : {size_t(2), size_t(4)}) {
+      Test(OutputTileSize, 1, 1, 16, 8, 8, 16, 1, 1, 1, 1, 0.0f, MlasIdentityActivation);
+      Test(OutputTileSize, 2, 1, 17, 13, 11, 33, 1, 1, 1, 1, 0.0f, MlasReluActivation);
+      Test(OutputTileSize, 1, 2, 24, 7, 19, 20, 0, 0, 0, 0, 0.0f, MlasLeakyReluActivation);
+      Test(OutputTileSize, 1, 1, 32, 5, 6, 16, 2, 0, 1, 2, 1.0f, MlasIdentityActivation);
+      Test(OutputTileSize, 3, 1, 64, 28, 28, 64, 1, 1, 1, 1, 0.0f, MlasReluActivation);
+      Test(OutputTileSize, 1, 1, 128, 14, 14, 96, 1, 1, 1, 1, 1.0f, MlasReluActivation);
+    }
+  }
+};
+
+template <>
+MlasConv2DWinogradTest<false>* MlasTestFixture<MlasConv2DWinogradTest<false>>::mlas_tester(nullptr);
+template <>
+MlasConv2DWinogradTest<true>* MlasTestFixture<MlasConv2DWinogradTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_fp16.h"
+
+template <typename T>
+class MlasEmbeddingBagTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferTable;
+  MatrixGuardBuffer<float> BufferRowScales;
+  MatrixGuardBuffer<float> BufferRowBiases;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  // The library routine is instantiated for MLAS_FP16, which has the same layout as MLFp16.
+  using MlasT = std::conditional_t<std::is_same_v<T, MLFp16>, MLAS_FP16, T>;
+
+  static T ToTableType(float Value) {
+    if constexpr (std::is_same_v<T, float>) {
+      return Value;
+    } else if constexpr (std::is_same_v<T, MLFp16>) {
+      return MLFp16(Value);
+    } else {
+      return static_cast<T>(Value * 100.0f);
+    }
+  }
+
+  static float ToFloat(T Value) {
+    if constexpr (std::is_same_v<T, MLFp16>) {
+      return Value.ToFloat();
+    } else {
+      return static_cast<float>(Value);
+    }
+  }
+
+  void Test(size_t TableRows, size_t RowCount, size_t EmbeddingDim, MLAS_EMBEDDING_BAG_MODE Mode,
+            bool UseScales, bool UseBiases) {
+    T* Table = BufferTable.GetBuffer(TableRows * EmbeddingDim);
+    float* RowScales = BufferRowScales.GetBuffer(RowCount + 1);
+    float* RowBiases = BufferRowBiases.GetBuffer(RowCount + 1);
+    float* Output = BufferOutput.GetBuffer(EmbeddingDim);
+    float* OutputReference = BufferOutputReference.GetBuffer(EmbeddingDim);
+
+    std::default_random_engine generator(static_cast<unsigned>(TableRows * RowCount * EmbeddingDim));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::uniform_int_distribution<size_t> row_distribution(0, TableRows - 1);
+
+    for (size_t i = 0; i < TableRows * EmbeddingDim; i++) {
+      Table[i] = ToTableType(distribution(generator));
+    }
+
+    std::vector<const T*> Rows(RowCount);
+    for (size_t i = 0; i < RowCount; i++) {
+      Rows[i] = Table + row_distribution(generator) * EmbeddingDim;
+      RowScales[i] = distribution(generator);
+      RowBiases[i] = distribution(generator);
+    }
+
+    for (size_t d = 0; d < EmbeddingDim; d++) {
+      float Value = 0.0f;
+      for (size_t i = 0; i < RowCount; i++) {
+        float RowValue = ToFloat(Rows[i][d]);
+        if (UseScales) {
+          RowValue *= RowScales[i];
+        }
+        if (UseBiases) {
+          RowValue += RowBiases[i];
+        }
+        if (i == 0) {
+          Value = RowValue;
+        } else {
+          Value = (Mode == MlasEmbeddingBagMax) ? std::max(Value, RowValue) : Value + RowValue;
+        }
+      }
+      OutputReference[d] = Value;
+    }
+
+    std::fill_n(Output, EmbeddingDim, -1.0f);
+
+    MlasEmbeddingBag(Mode, reinterpret_cast<const MlasT* const*>(Rows.data()),
+                     UseScales ? RowScales : nullptr, UseBiases ? RowBiases : nullptr,
+                     RowCount, EmbeddingDim, Output);
+
+    for (size_t d = 0; d < EmbeddingDim; d++) {
+      ASSERT_NEAR(Output[d], OutputReference[d], 1e-4f * (1.f + std::fabs(OutputReference[d])))
+          << "index " << d << ", "
+          << "TableRows" << TableRows << "/"
+          << "RowCount" << RowCount << "/"
+          << "EmbeddingDim" << EmbeddingDim << "/"
+          << "Mode" << int(Mode) << "/"
+          << "Scales" << UseScales << "/"
+          << "Biases" << UseBiases;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_same_v<T, float>       ? "EmbeddingBag_Float"
+                                        : std::is_same_v<T, MLFp16>    ? "EmbeddingBag_Fp16"
+                                        : std::is_same_v<T, int8_t>    ? "EmbeddingBag_S8"
+                                                                       : "EmbeddingBag_U8");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_EMBEDDING_BAG_MODE Mode : {MlasEmbeddingBagSum, MlasEmbeddingBagMax}) {
+      for (bool UseScales : {false, true}) {
+        for (bool UseBiases : {false, true}) {
+          Test(1, 0, 16, Mode, UseScales, UseBiases);
+          Test(1, 1, 1, Mode, UseScales, UseBiases);
+          Test(7, 3, 3, Mode, UseScales, UseBiases);
+          Test(100, 5, 17, Mode, UseScales, UseBiases);
+          Test(1000, 33, 64, Mode, UseScales, UseBiases);
+          Test(50, 8, 300, Mode, UseScales, UseBiases);
+          Test(20, 2, 600, Mode, UseScales, UseBiases);
+        }
+      }
+    }
+  }
+};
+
+template <>
+MlasEmbeddingBagTest<float>* MlasTestFixture<MlasEmbeddingBagTest<float>>::mlas_tester(nullptr);
+template <>
+MlasEmbeddingBagTest<MLFp16>* MlasTestFixture<MlasEmbeddingBagTest<MLFp16>>::mlas_tester(nullptr);
+template <>
+MlasEmbeddingBagTest<int8_t>* MlasTestFixture<MlasEmbeddingBagTest<int8_t>>::mlas_tester(nullptr);
+template <>
+MlasEmbeddingBagTest<uint8_t>* MlasTestFixture<MlasEmbeddingBagTest<uint8_t>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasEmbeddingBagTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEmbeddingBagTest<MLFp16>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEmbeddingBagTest<int8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEmbeddingBagTest<uint8_t>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -194,7 +194,7 @@ static size_t HalfGemmRegistShortExecute() {
 }
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
-  if (!MlasFp16AccelerationSupported()) {
+  if (!MlasHalfGemmAccelerationSupported()) {
     return false;
   }
   if (is_short_execute) {
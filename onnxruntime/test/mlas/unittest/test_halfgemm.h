@@ -134,6 +134,10 @@ class MlasHalfGemmTest : public MlasTestBase {
     //
     constexpr size_t KStride = 512;
 
+    // Kernels on CPUs without fp16 arithmetic widen the operands and
+    // accumulate in fp32, rounding to fp16 only when C is stored.
+    const bool AccumulateInHalf = MlasFp16AccelerationSupported();
+
     for (size_t batch = 0; batch < BatchSize; batch++) {
       for (size_t m = 0; m < M; m++) {
         for (size_t n = 0; n < N; n++) {
@@ -147,8 +151,12 @@ class MlasHalfGemmTest : public MlasTestBase {
               sum = float(Bias[n]);
             }
             for (size_t kk = 0; kk < std::min(KStride, K - k); kk++) {
-              MLFp16 down(float(*b) * float(*a) + sum);
-              sum = float(down);
+              if (AccumulateInHalf) {
+                MLFp16 down(float(*b) * float(*a) + sum);
+                sum = float(down);
+              } else {
+                sum += float(*b) * float(*a);
+              }
               b += N;
               a += 1;
             }
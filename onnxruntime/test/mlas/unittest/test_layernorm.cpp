@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferSum;
+  MatrixGuardBuffer<float> BufferSumReference;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+  MatrixGuardBuffer<int8_t> BufferQLinearInput;
+  MatrixGuardBuffer<int8_t> BufferQLinearOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t N, size_t D, bool UseSkip, bool UseBias, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Skip = UseSkip ? BufferSkip.GetBuffer(N * D) : nullptr;
+    float* Bias = UseBias ? BufferBias.GetBuffer(D) : nullptr;
+    float* Gamma = BufferGamma.GetBuffer(D);
+    float* Beta = BufferBeta.GetBuffer(D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* Sum = (UseSkip || UseBias) ? BufferSum.GetBuffer(N * D) : nullptr;
+    float* SumReference = BufferSumReference.GetBuffer(N * D);
+    float* Mean = BufferMean.GetBuffer(N);
+    float* InvStdDev = BufferInvStdDev.GetBuffer(N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_real_distribution<float> distribution(-5.f, 5.f);
+    std::uniform_real_distribution<float> scale_distribution(-2.f, 2.f);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = distribution(generator);
+      if (Skip != nullptr) {
+        Skip[nd] = distribution(generator);
+      }
+    }
+
+    for (size_t d = 0; d < D; d++) {
+      if (Bias != nullptr) {
+        Bias[d] = scale_distribution(generator);
+      }
+      Gamma[d] = scale_distribution(generator);
+      Beta[d] = scale_distribution(generator);
+    }
+
+    MLAS_LAYERNORM_PARAMS Params;
+    Params.Skip = Skip;
+    Params.Bias = Bias;
+    Params.Gamma = Gamma;
+    Params.Beta = Beta;
+    Params.SkipInputBiasSum = Sum;
+    Params.Mean = Mean;
+    Params.InvStdDev = InvStdDev;
+    Params.Epsilon = 1e-5f;
+    Params.Simplified = Simplified;
+
+    MlasLayerNormalization(Input, Output, N, D, Params, threadpool_);
+    ReferenceLayerNorm(Input, OutputReference, SumReference, N, D, Params);
+
+    constexpr float AbsoluteTolerance = 1e-4f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      float diff = std::fabs(Output[nd] - OutputReference[nd]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[nd]) * RelativeTolerance)
+          << "Simplified:" << (int)Simplified << " difference " << N << "/" << D
+          << ", got: " << Output[nd] << ", expecting: " << OutputReference[nd];
+      if (Sum != nullptr) {
+        ASSERT_EQ(Sum[nd], SumReference[nd]) << " sum mismatch " << N << "/" << D;
+      }
+    }
+  }
+
+  void TestQLinear(size_t N, size_t D) {
+    int8_t* Input = BufferQLinearInput.GetBuffer(N * D);
+    int8_t* Output = BufferQLinearOutput.GetBuffer(N * D);
+    float* Dequantized = BufferInput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* SumReference = BufferSumReference.GetBuffer(N * D);
+    float* Gamma = BufferGamma.GetBuffer(D);
+    float* Beta = BufferBeta.GetBuffer(D);
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D));
+    std::uniform_int_distribution<int32_t> distribution(-128, 127);
+    std::uniform_real_distribution<float> scale_distribution(-2.f, 2.f);
+
+    const float InputScale = 0.05f;
+    const int8_t InputZeroPoint = -3;
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = static_cast<int8_t>(distribution(generator));
+      Dequantized[nd] = (int32_t(Input[nd]) - InputZeroPoint) * InputScale;
+    }
+
+    for (size_t d = 0; d < D; d++) {
+      Gamma[d] = scale_distribution(generator);
+      Beta[d] = scale_distribution(generator);
+    }
+
+    MLAS_LAYERNORM_PARAMS Params;
+    Params.Gamma = Gamma;
+    Params.Beta = Beta;
+
+    const float OutputScale = 8.f / 255.f;
+    const int8_t OutputZeroPoint = 5;
+
+    MlasQLinearLayerNormalization(Input, InputScale, InputZeroPoint, Output, N, D, Params,
+                                  OutputScale, OutputZeroPoint, threadpool_);
+    ReferenceLayerNorm(Dequantized, OutputReference, SumReference, N, D, Params);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      float q = std::nearbyint(OutputReference[nd] / OutputScale) + OutputZeroPoint;
+      q = (std::min)((std::max)(q, -128.f), 127.f);
+      ASSERT_LE(std::fabs(float(Output[nd]) - q), 1.f)
+          << " qlinear mismatch " << N << "/" << D
+          << ", got: " << int(Output[nd]) << ", expecting: " << q;
+    }
+  }
+
+  void ReferenceLayerNorm(const float* Input, float* Output, float* Sum, size_t N, size_t D,
+                          const MLAS_LAYERNORM_PARAMS& Params) {
+    for (size_t n = 0; n < N; n++) {
+      for (size_t d = 0; d < D; d++) {
+        float Value = Input[n * D + d];
+        if (Params.Skip != nullptr) {
+          Value += Params.Skip[n * D + d];
+        }
+        if (Params.Bias != nullptr) {
+          Value += Params.Bias[d];
+        }
+        Sum[n * D + d] = Value;
+      }
+
+      const float* Row = Sum + n * D;
+      double Mean = 0.0;
+      double Variance = 0.0;
+
+      if (!Params.Simplified) {
+        for (size_t d = 0; d < D; d++) {
+          Mean += Row[d];
+        }
+        Mean /= D;
+      }
+
+      for (size_t d = 0; d < D; d++) {
+        double Centered = double(Row[d]) - Mean;
+        Variance += Centered * Centered;
+      }
+      Variance /= D;
+
+      double InvStdDev = 1.0 / std::sqrt(Variance + Params.Epsilon);
+
+      if (Params.Mean != nullptr) {
+        ASSERT_NEAR(Params.Mean[n], float(Mean), 1e-4f) << " mean mismatch " << N << "/" << D;
+      }
+      if (Params.InvStdDev != nullptr) {
+        ASSERT_NEAR(Params.InvStdDev[n], float(InvStdDev), 1e-4f * float(InvStdDev))
+            << " inv std dev mismatch " << N << "/" << D;
+      }
+
+      for (size_t d = 0; d < D; d++) {
+        double Value = (double(Row[d]) - Mean) * InvStdDev * Params.Gamma[d];
+        if (!Params.Simplified) {
+          Value += Params.Beta[d];
+        }
+        Output[n * D + d] = float(Value);
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t d = 1; d < 80; d++) {
+      Test(1, d, false, false, false);
+      Test(2, d, true, true, false);
+      Test(2, d, true, false, true);
+    }
+
+    Test(3, 768, true, true, false);
+    Test(37, 1024, true, false, false);
+    Test(64, 384, false, false, true);
+    Test(16, 4099, true, true, true);
+
+    TestQLinear(1, 7);
+    TestQLinear(5, 768);
+  }
+};
+
+template <>
+MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <>
+MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
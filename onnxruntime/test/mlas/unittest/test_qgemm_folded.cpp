@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasQgemmFoldedTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferA;
+  MatrixGuardBuffer<uint8_t> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferZeroPointB;
+  MatrixGuardBuffer<int32_t> BufferBias;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<int32_t> BufferC;
+  MatrixGuardBuffer<int32_t> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M,
+            size_t N,
+            size_t K,
+            bool AIsSigned,
+            bool BIsSigned,
+            bool PerColumnZeroPoints,
+            bool UseBias,
+            uint8_t offa,
+            uint8_t offa_packed) {
+    const size_t PackedBSize = MlasGemmPackBFoldedSize(N, K, AIsSigned, BIsSigned);
+
+    if (PackedBSize == 0) {
+      return;
+    }
+
+    const uint8_t* A = BufferA.GetBuffer(M * K);
+    const uint8_t* B = BufferB.GetBuffer(K * N);
+    uint8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+    int32_t* Bias = BufferBias.GetBuffer(N);
+    int32_t* C = BufferC.GetBuffer(M * N);
+    int32_t* CReference = BufferCReference.GetBuffer(M * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::uniform_int_distribution<int32_t> bias_distribution(-1 << 20, 1 << 20);
+
+    for (size_t n = 0; n < N; n++) {
+      ZeroPointB[n] = static_cast<uint8_t>(distribution(generator));
+      Bias[n] = bias_distribution(generator);
+    }
+
+    //
+    // Compute the reference output with the unpacked matrix and the bias
+    // applied afterwards.
+    //
+
+    MLAS_GEMM_QUANT_SHAPE_PARAMS GemmShape;
+    GemmShape.M = M;
+    GemmShape.N = N;
+    GemmShape.K = K;
+    GemmShape.AIsSigned = AIsSigned;
+    GemmShape.BIsSigned = BIsSigned;
+
+    MLAS_GEMM_QUANT_DATA_PARAMS GemmParameters;
+    GemmParameters.A = A;
+    GemmParameters.lda = K;
+    GemmParameters.ZeroPointA = offa;
+    GemmParameters.B = B;
+    GemmParameters.ldb = N;
+    GemmParameters.ZeroPointB = ZeroPointB;
+    GemmParameters.PerColumnZeroPoints = PerColumnZeroPoints;
+    GemmParameters.C = CReference;
+    GemmParameters.ldc = N;
+
+    MlasGemmBatch(GemmShape, &GemmParameters, 1, threadpool_);
+
+    if (UseBias) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          CReference[m * N + n] += Bias[n];
+        }
+      }
+    }
+
+    //
+    // Compute the output with the folded matrix.
+    //
+
+    void* PackedB = BufferBPacked.GetBuffer(PackedBSize);
+
+    MlasGemmPackBFolded(N, K, B, N, AIsSigned, BIsSigned, ZeroPointB, PerColumnZeroPoints,
+                        &offa_packed, UseBias ? Bias : nullptr, PackedB);
+
+    std::fill_n(C, M * N, -1);
+
+    GemmParameters.B = PackedB;
+    GemmParameters.ldb = 0;
+    GemmParameters.BIsPacked = true;
+    GemmParameters.BIsFolded = true;
+    GemmParameters.ZeroPointB = nullptr;
+    GemmParameters.PerColumnZeroPoints = false;
+    GemmParameters.C = C;
+
+    MlasGemmBatch(GemmShape, &GemmParameters, 1, threadpool_);
+
+    ASSERT_EQ(memcmp(C, CReference, M * N * sizeof(int32_t)), 0)
+        << "M" << M << "/"
+        << "N" << N << "/"
+        << "K" << K << "/"
+        << "AIsSigned" << AIsSigned << "/"
+        << "BIsSigned" << BIsSigned << "/"
+        << "PerColumn" << PerColumnZeroPoints << "/"
+        << "Bias" << UseBias << "/"
+        << "offa" << int(offa) << "/"
+        << "offa_packed" << int(offa_packed);
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "QGemmFolded_Threaded" : "QGemmFolded_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasQgemmFoldedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (bool AIsSigned : {false, true}) {
+      for (bool BIsSigned : {false, true}) {
+        if (AIsSigned && !BIsSigned) {
+          continue;
+        }
+        for (bool PerColumnZeroPoints : {false, true}) {
+          Test(1, 1, 1, AIsSigned, BIsSigned, PerColumnZeroPoints, true, 7, 7);
+          Test(1, 33, 77, AIsSigned, BIsSigned, PerColumnZeroPoints, false, 128, 128);
+          Test(5, 19, 300, AIsSigned, BIsSigned, PerColumnZeroPoints, true, 3, 3);
+          Test(16, 160, 96, AIsSigned, BIsSigned, PerColumnZeroPoints, true, 211, 90);
+          Test(31, 257, 515, AIsSigned, BIsSigned, PerColumnZeroPoints, true, 0, 0);
+          Test(64, 384, 1024, AIsSigned, BIsSigned, PerColumnZeroPoints, true, 131, 17);
+        }
+      }
+    }
+  }
+};
+
+template <>
+MlasQgemmFoldedTest<false>* MlasTestFixture<MlasQgemmFoldedTest<false>>::mlas_tester(nullptr);
+template <>
+MlasQgemmFoldedTest<true>* MlasTestFixture<MlasQgemmFoldedTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQgemmFoldedTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasQgemmFoldedTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M,
+            size_t N,
+            size_t K,
+            float Density,
+            bool TransA,
+            bool TransB,
+            float alpha,
+            float beta) {
+    const float* A = BufferA.GetBuffer(M * K);
+    float* B = BufferB.GetBuffer(K * N);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * N * K));
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    std::uniform_real_distribution<float> sparsity(0.f, 1.f);
+
+    for (size_t i = 0; i < K * N; i++) {
+      B[i] = sparsity(generator) < Density ? distribution(generator) : 0.0f;
+    }
+
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = distribution(generator);
+      CReference[i] = C[i];
+    }
+
+    const CBLAS_TRANSPOSE TransposeA = TransA ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE TransposeB = TransB ? CblasTrans : CblasNoTrans;
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    MlasGemm(TransposeA, TransposeB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, N, threadpool_);
+
+    const size_t PackedBSize = MlasSparseGemmPackBSize(TransposeB, N, K, B, ldb);
+    ASSERT_GT(PackedBSize, size_t(0));
+
+    void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(TransposeB, N, K, B, ldb, PackedB);
+
+    MlasSparseGemm(TransposeA, M, N, K, alpha, A, lda, PackedB, beta, C, N, threadpool_);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_NEAR(C[i], CReference[i], 1e-5f * float(K) * (1.f + std::fabs(CReference[i])))
+          << "index " << i << ", "
+          << "M" << M << "/"
+          << "N" << N << "/"
+          << "K" << K << "/"
+          << "Density" << Density << "/"
+          << "TransA" << TransA << "/"
+          << "TransB" << TransB << "/"
+          << "Alpha" << alpha << "/"
+          << "Beta" << beta;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SparseGemm_Threaded" : "SparseGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (bool TransA : {false, true}) {
+      for (bool TransB : {false, true}) {
+        Test(1, 1, 1, 1.0f, TransA, TransB, 1.0f, 0.0f);
+        Test(1, 64, 256, 0.1f, TransA, TransB, 1.0f, 0.0f);
+        Test(7, 33, 45, 0.0f, TransA, TransB, 1.0f, 1.0f);
+        Test(16, 48, 96, 0.25f, TransA, TransB, 0.5f, 0.0f);
+        Test(19, 129, 64, 0.5f, TransA, TransB, 1.0f, 1.0f);
+        Test(37, 256, 512, 0.05f, TransA, TransB, 2.0f, 0.5f);
+        Test(128, 96, 300, 0.2f, TransA, TransB, 1.0f, 0.0f);
+      }
+    }
+  }
+};
+
+template <>
+MlasSparseGemmTest<false>* MlasTestFixture<MlasSparseGemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasSparseGemmTest<true>* MlasTestFixture<MlasSparseGemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
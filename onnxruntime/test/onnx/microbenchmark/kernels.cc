@@ -0,0 +1,634 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Per kernel benchmarks of the CPU execution provider. Every case creates the kernel through the standalone op
+// invoker (Ort::Op::Create / Ort::Op::Invoke), so the time measured is Compute() of the kernel that a session would
+// run for the same node, without the graph executor around it.
+//
+// Besides the time, every case reports:
+//   GFLOP/s   estimated floating point (or integer multiply-add) operations per second
+//   GB/s      bytes of the inputs and outputs per second, i.e. the traffic a kernel can't avoid
+//   roofline  achieved fraction of the roofline bound, reported when ORT_KERNEL_BENCH_PEAK_GFLOPS and
+//             ORT_KERNEL_BENCH_PEAK_GBPS give the peak compute and memory bandwidth of the machine.
+//
+// Run with --list_uncovered_kernels to print the registered CPU kernels that have no case here.
+
+#include "common.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "core/common/logging/logging.h"
+#include "core/framework/data_transfer_manager.h"
+#include "core/framework/kernel_def_builder.h"
+#include "core/framework/kernel_registry.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/op_kernel_context.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph.h"
+#include "core/platform/env_var_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/session/onnxruntime_cxx_api.h"
+#include "core/util/thread_utils.h"
+
+using namespace onnxruntime;
+
+namespace {
+
+struct TensorDesc {
+  ONNXTensorElementDataType type;
+  std::vector<int64_t> shape;
+  // repeated to fill the tensor when set, otherwise the tensor gets random data
+  std::vector<double> values;
+};
+
+struct AttrDesc {
+  std::string name;
+  OrtOpAttrType type;
+  std::vector<int64_t> ints;
+  std::vector<float> floats;
+  std::string str;
+};
+
+struct KernelCase {
+  std::string op_type;
+  std::string domain;
+  int version;
+  std::vector<std::pair<std::string, ONNXTensorElementDataType>> type_constraints;
+  std::vector<AttrDesc> attrs;
+  std::vector<TensorDesc> inputs;
+  std::vector<TensorDesc> outputs;
+  std::string label;  // shape configuration shown in the benchmark name
+  double flops;
+};
+
+constexpr auto kFloat = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+constexpr auto kInt64 = ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64;
+constexpr auto kInt32 = ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32;
+constexpr auto kUInt8 = ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8;
+constexpr auto kBool = ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL;
+
+AttrDesc IntAttr(const char* name, int64_t value) { return {name, ORT_OP_ATTR_INT, {value}, {}, {}}; }
+AttrDesc IntsAttr(const char* name, std::vector<int64_t> values) {
+  return {name, ORT_OP_ATTR_INTS, std::move(values), {}, {}};
+}
+AttrDesc StringAttr(const char* name, std::string value) {
+  return {name, ORT_OP_ATTR_STRING, {}, {}, std::move(value)};
+}
+
+TensorDesc Float(std::vector<int64_t> shape) { return {kFloat, std::move(shape), {}}; }
+TensorDesc FloatValues(std::vector<int64_t> shape, std::vector<double> values) {
+  return {kFloat, std::move(shape), std::move(values)};
+}
+TensorDesc Int64Values(std::vector<int64_t> values) {
+  return {kInt64, {static_cast<int64_t>(values.size())}, std::vector<double>(values.begin(), values.end())};
+}
+
+int64_t NumElements(const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>());
+}
+
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    default:
+      ORT_THROW("unsupported element type ", type);
+  }
+}
+
+double Bytes(const std::vector<TensorDesc>& tensors) {
+  double bytes = 0;
+  for (const auto& tensor : tensors) {
+    bytes += static_cast<double>(NumElements(tensor.shape)) * static_cast<double>(ElementSize(tensor.type));
+  }
+  return bytes;
+}
+
+std::string ShapeLabel(const std::vector<int64_t>& shape) {
+  std::ostringstream label;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    label << (i == 0 ? "" : "x") << shape[i];
+  }
+  return label.str();
+}
+
+template <typename T>
+void Fill(T* data, int64_t size, const std::vector<double>& values, std::mt19937& rng, double low, double high) {
+  if (!values.empty()) {
+    for (int64_t i = 0; i < size; ++i) {
+      data[i] = static_cast<T>(values[static_cast<size_t>(i) % values.size()]);
+    }
+    return;
+  }
+
+  std::uniform_real_distribution<double> dist(low, high);
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<T>(dist(rng));
+  }
+}
+
+Ort::Value CreateTensor(const TensorDesc& desc, bool fill, std::mt19937& rng) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto value = Ort::Value::CreateTensor(allocator, desc.shape.data(), desc.shape.size(), desc.type);
+  if (!fill) {
+    return value;
+  }
+
+  const int64_t size = NumElements(desc.shape);
+  void* data = value.GetTensorMutableRawData();
+  switch (desc.type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      Fill(static_cast<float*>(data), size, desc.values, rng, -1.0, 1.0);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      Fill(static_cast<int32_t*>(data), size, desc.values, rng, 0.0, 100.0);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      Fill(static_cast<int64_t*>(data), size, desc.values, rng, 0.0, 100.0);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      Fill(static_cast<uint8_t*>(data), size, desc.values, rng, 0.0, 255.0);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      Fill(static_cast<int8_t*>(data), size, desc.values, rng, -128.0, 127.0);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      // through uint8_t so random values truncate to 0 or 1 rather than all becoming true
+      Fill(static_cast<uint8_t*>(data), size, desc.values, rng, 0.0, 2.0);
+      break;
+    default:
+      ORT_THROW("unsupported element type ", desc.type);
+  }
+  return value;
+}
+
+// What Ort::Op::Create needs from the kernel info: the CPU EP the kernel is looked up and created for.
+struct KernelBenchEnvironment {
+  KernelBenchEnvironment()
+      : provider(CPUExecutionProviderInfo{false}),
+        kernel_def(KernelDefBuilder().SetName("KernelBenchmark").Provider(kCpuExecutionProvider).Build()),
+        info(node, *kernel_def, provider, constant_initializers, name_idx_map, data_transfer_manager) {
+  }
+
+  static KernelBenchEnvironment& Get() {
+    static KernelBenchEnvironment environment;
+    return environment;
+  }
+
+  CPUExecutionProvider provider;
+  Node node;
+  std::unique_ptr<KernelDef> kernel_def;
+  std::unordered_map<int, OrtValue> constant_initializers;
+  OrtValueNameIdxMap name_idx_map;
+  DataTransferManager data_transfer_manager;
+  OpKernelInfo info;
+};
+
+// The kernel context Ort::Op::Invoke runs the kernel from. It only supplies the thread pool and temp allocator.
+class KernelBenchContext : public OpKernelContext {
+ public:
+  KernelBenchContext(concurrency::ThreadPool* thread_pool, AllocatorPtr allocator)
+      : OpKernelContext(thread_pool, logging::LoggingManager::DefaultLogger(), nullptr),
+        allocator_(std::move(allocator)) {
+  }
+
+  Status GetTempSpaceAllocator(AllocatorPtr* output) const override {
+    *output = allocator_;
+    return Status::OK();
+  }
+
+ private:
+  AllocatorPtr allocator_;
+};
+
+concurrency::ThreadPool* GetIntraOpThreadPool() {
+  static std::unique_ptr<concurrency::ThreadPool> thread_pool = []() {
+    OrtThreadPoolParams params;
+    params.auto_set_affinity = true;
+    return concurrency::CreateThreadPool(&onnxruntime::Env::Default(), params,
+                                         concurrency::ThreadPoolType::INTRA_OP);
+  }();
+  return thread_pool.get();
+}
+
+void RunKernelCase(benchmark::State& state, const KernelCase& kernel_case, bool use_thread_pool) {
+  try {
+    auto& environment = KernelBenchEnvironment::Get();
+
+    std::vector<const char*> constraint_names;
+    std::vector<ONNXTensorElementDataType> constraint_types;
+    for (const auto& constraint : kernel_case.type_constraints) {
+      constraint_names.push_back(constraint.first.c_str());
+      constraint_types.push_back(constraint.second);
+    }
+
+    std::vector<Ort::OpAttr> attrs;
+    for (const auto& attr : kernel_case.attrs) {
+      switch (attr.type) {
+        case ORT_OP_ATTR_INT:
+        case ORT_OP_ATTR_INTS:
+          attrs.emplace_back(attr.name.c_str(), attr.ints.data(), static_cast<int>(attr.ints.size()), attr.type);
+          break;
+        case ORT_OP_ATTR_FLOAT:
+        case ORT_OP_ATTR_FLOATS:
+          attrs.emplace_back(attr.name.c_str(), attr.floats.data(), static_cast<int>(attr.floats.size()), attr.type);
+          break;
+        default:
+          attrs.emplace_back(attr.name.c_str(), attr.str.c_str(), static_cast<int>(attr.str.size()), attr.type);
+          break;
+      }
+    }
+
+    auto op = Ort::Op::Create(reinterpret_cast<const OrtKernelInfo*>(&environment.info),
+                              kernel_case.op_type.c_str(), kernel_case.domain.c_str(), kernel_case.version,
+                              constraint_names.data(), constraint_types.data(), constraint_names.size(),
+                              attrs.data(), attrs.size(), kernel_case.inputs.size(), kernel_case.outputs.size());
+
+    std::mt19937 rng(42);
+    std::vector<Ort::Value> inputs;
+    for (const auto& input : kernel_case.inputs) {
+      inputs.push_back(CreateTensor(input, true, rng));
+    }
+    // outputs are allocated up front so the loop measures the kernel and not the allocator
+    std::vector<Ort::Value> outputs;
+    for (const auto& output : kernel_case.outputs) {
+      outputs.push_back(CreateTensor(output, false, rng));
+    }
+
+    KernelBenchContext context(use_thread_pool ? GetIntraOpThreadPool() : nullptr,
+                               environment.provider.GetAllocator(OrtMemTypeDefault));
+    const auto* ort_context = reinterpret_cast<const OrtKernelContext*>(static_cast<const OpKernelContext*>(&context));
+
+    for (auto _ : state) {
+      op.Invoke(ort_context, inputs.data(), inputs.size(), outputs.data(), outputs.size());
+    }
+  } catch (const std::exception& ex) {
+    state.SkipWithError(ex.what());
+    return;
+  }
+
+  const double flops = kernel_case.flops;
+  const double bytes = Bytes(kernel_case.inputs) + Bytes(kernel_case.outputs);
+  state.counters["GFLOP/s"] = benchmark::Counter(flops * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["GB/s"] = benchmark::Counter(bytes * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+
+  static const double peak_gflops = ParseEnvironmentVariableWithDefault<double>("ORT_KERNEL_BENCH_PEAK_GFLOPS", 0.0);
+  static const double peak_gbps = ParseEnvironmentVariableWithDefault<double>("ORT_KERNEL_BENCH_PEAK_GBPS", 0.0);
+  if (peak_gflops > 0 && peak_gbps > 0) {
+    // the fastest an iteration can be is set by compute or by memory traffic, whichever takes longer.
+    // as a rate this becomes bound time / measured time, i.e. the fraction of the roofline reached.
+    const double bound_seconds = std::max(flops / (peak_gflops * 1e9), bytes / (peak_gbps * 1e9));
+    state.counters["roofline"] = benchmark::Counter(bound_seconds, benchmark::Counter::kIsIterationInvariantRate);
+  }
+}
+
+//
+// Cases. The shapes are the ones that show up in the vision and transformer models we run.
+//
+
+void AddUnaryCases(std::vector<KernelCase>& cases, const char* op_type, const char* domain, int version,
+                   double flops_per_element) {
+  for (int64_t size : {int64_t{4096}, int64_t{1} << 16, int64_t{1} << 20, int64_t{1} << 23}) {
+    cases.push_back({op_type, domain, version, {{"T", kFloat}}, {}, {Float({size})}, {Float({size})},
+                     ShapeLabel({size}), flops_per_element * static_cast<double>(size)});
+  }
+}
+
+void AddBinaryCases(std::vector<KernelCase>& cases, const char* op_type) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> shapes{
+      {{1 << 16}, {1 << 16}},
+      {{1 << 22}, {1 << 22}},
+      {{1, 128, 768}, {768}},                 // bias add
+      {{1, 64, 56, 56}, {64, 1, 1}},          // per channel scale
+      {{12, 128, 128}, {1, 128, 128}},        // attention mask
+  };
+  for (const auto& [a, b] : shapes) {
+    cases.push_back({op_type, kOnnxDomain, 14, {{"T", kFloat}}, {}, {Float(a), Float(b)}, {Float(a)},
+                     ShapeLabel(a) + "_" + ShapeLabel(b), static_cast<double>(NumElements(a))});
+  }
+}
+
+void AddMatMulCases(std::vector<KernelCase>& cases) {
+  const std::vector<std::vector<int64_t>> mkn{
+      {1, 768, 768}, {128, 768, 768}, {128, 768, 3072}, {128, 3072, 768}, {512, 1024, 1024}, {64, 64, 64}};
+  for (const auto& dims : mkn) {
+    const int64_t m = dims[0], k = dims[1], n = dims[2];
+    const double flops = 2.0 * static_cast<double>(m * k * n);
+    cases.push_back({"MatMul", kOnnxDomain, 13, {{"T", kFloat}}, {}, {Float({m, k}), Float({k, n})},
+                     {Float({m, n})}, ShapeLabel(dims), flops});
+    cases.push_back({"Gemm", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("transB", 1)},
+                     {Float({m, k}), Float({n, k}), Float({n})}, {Float({m, n})}, ShapeLabel(dims), flops});
+    cases.push_back({"MatMulInteger", kOnnxDomain, 10, {{"T1", kUInt8}, {"T2", kUInt8}, {"T3", kInt32}}, {},
+                     {{kUInt8, {m, k}, {}}, {kUInt8, {k, n}, {}}}, {{kInt32, {m, n}, {}}}, ShapeLabel(dims), flops});
+  }
+
+  // batched attention scores
+  for (int64_t seq : {int64_t{128}, int64_t{512}}) {
+    const std::vector<int64_t> a{12, seq, 64}, b{12, 64, seq};
+    cases.push_back({"MatMul", kOnnxDomain, 13, {{"T", kFloat}}, {}, {Float(a), Float(b)}, {Float({12, seq, seq})},
+                     ShapeLabel(a) + "_" + ShapeLabel(b), 2.0 * 12 * static_cast<double>(seq * 64 * seq)});
+  }
+}
+
+struct ConvShape {
+  int64_t batch, channels, height, width, filters, kernel, stride, group;
+};
+
+void AddConvCases(std::vector<KernelCase>& cases) {
+  const std::vector<ConvShape> shapes{
+      {1, 3, 224, 224, 64, 7, 2, 1},      // resnet stem
+      {1, 64, 56, 56, 64, 3, 1, 1},       // resnet 3x3
+      {1, 256, 56, 56, 64, 1, 1, 1},      // resnet bottleneck 1x1
+      {1, 512, 7, 7, 512, 3, 1, 1},       // late stage, small spatial
+      {1, 32, 112, 112, 32, 3, 1, 32},    // mobilenet depthwise
+      {1, 144, 56, 56, 144, 3, 2, 144},   // strided depthwise
+      {1, 32, 112, 112, 64, 1, 1, 1},     // mobilenet pointwise
+      {8, 64, 56, 56, 64, 3, 1, 1},       // batched
+  };
+  for (const auto& s : shapes) {
+    const int64_t pad = s.kernel / 2;
+    const int64_t out_h = (s.height + 2 * pad - s.kernel) / s.stride + 1;
+    const int64_t out_w = (s.width + 2 * pad - s.kernel) / s.stride + 1;
+    const std::vector<int64_t> x{s.batch, s.channels, s.height, s.width};
+    const std::vector<int64_t> w{s.filters, s.channels / s.group, s.kernel, s.kernel};
+    const double flops = 2.0 * static_cast<double>(s.batch * s.filters * out_h * out_w) *
+                         static_cast<double>(s.channels / s.group * s.kernel * s.kernel);
+    cases.push_back({"Conv", kOnnxDomain, 11, {{"T", kFloat}},
+                     {IntsAttr("kernel_shape", {s.kernel, s.kernel}), IntsAttr("strides", {s.stride, s.stride}),
+                      IntsAttr("pads", {pad, pad, pad, pad}), IntAttr("group", s.group)},
+                     {Float(x), Float(w), Float({s.filters})}, {Float({s.batch, s.filters, out_h, out_w})},
+                     ShapeLabel(x) + "_" + ShapeLabel(w) + "_s" + std::to_string(s.stride), flops});
+  }
+
+  // upsampling in decoders
+  for (int64_t size : {int64_t{28}, int64_t{56}}) {
+    const std::vector<int64_t> x{1, 64, size, size};
+    cases.push_back({"ConvTranspose", kOnnxDomain, 11, {{"T", kFloat}},
+                     {IntsAttr("kernel_shape", {2, 2}), IntsAttr("strides", {2, 2})},
+                     {Float(x), Float({64, 32, 2, 2})}, {Float({1, 32, 2 * size, 2 * size})}, ShapeLabel(x),
+                     2.0 * 64 * 32 * 4 * static_cast<double>(size * size)});
+  }
+}
+
+void AddPoolCases(std::vector<KernelCase>& cases) {
+  for (const std::vector<int64_t>& x : {std::vector<int64_t>{1, 64, 112, 112}, std::vector<int64_t>{8, 256, 56, 56}}) {
+    const std::vector<int64_t> y{x[0], x[1], x[2] / 2, x[3] / 2};
+    const std::vector<AttrDesc> attrs{IntsAttr("kernel_shape", {3, 3}), IntsAttr("strides", {2, 2}),
+                                      IntsAttr("pads", {1, 1, 1, 1})};
+    cases.push_back({"MaxPool", kOnnxDomain, 12, {{"T", kFloat}}, attrs, {Float(x)}, {Float(y)}, ShapeLabel(x),
+                     9.0 * static_cast<double>(NumElements(y))});
+    cases.push_back({"AveragePool", kOnnxDomain, 11, {{"T", kFloat}}, attrs, {Float(x)}, {Float(y)}, ShapeLabel(x),
+                     9.0 * static_cast<double>(NumElements(y))});
+  }
+
+  for (const std::vector<int64_t>& x : {std::vector<int64_t>{1, 2048, 7, 7}, std::vector<int64_t>{8, 256, 56, 56}}) {
+    cases.push_back({"GlobalAveragePool", kOnnxDomain, 1, {{"T", kFloat}}, {}, {Float(x)},
+                     {Float({x[0], x[1], 1, 1})}, ShapeLabel(x), static_cast<double>(NumElements(x))});
+  }
+}
+
+void AddNormalizationCases(std::vector<KernelCase>& cases) {
+  for (const std::vector<int64_t>& x : {std::vector<int64_t>{1, 64, 112, 112}, std::vector<int64_t>{8, 256, 56, 56}}) {
+    const int64_t c = x[1];
+    cases.push_back({"BatchNormalization", kOnnxDomain, 15, {{"T", kFloat}}, {},
+                     {Float(x), Float({c}), Float({c}), Float({c}), FloatValues({c}, {1.0})}, {Float(x)},
+                     ShapeLabel(x), 2.0 * static_cast<double>(NumElements(x))});
+  }
+
+  for (const std::vector<int64_t>& x : {std::vector<int64_t>{1, 128, 768}, std::vector<int64_t>{4, 512, 1024},
+                                        std::vector<int64_t>{1, 1, 4096}}) {
+    const int64_t hidden = x.back();
+    const double flops = 8.0 * static_cast<double>(NumElements(x));
+    cases.push_back({"LayerNormalization", kOnnxDomain, 17, {{"T", kFloat}, {"U", kFloat}}, {IntAttr("axis", -1)},
+                     {Float(x), Float({hidden}), Float({hidden})}, {Float(x)}, ShapeLabel(x), flops});
+    cases.push_back({"SkipLayerNormalization", kMSDomain, 1, {{"T", kFloat}}, {},
+                     {Float(x), Float(x), Float({hidden}), Float({hidden})}, {Float(x)}, ShapeLabel(x),
+                     flops + static_cast<double>(NumElements(x))});
+  }
+
+  for (const std::vector<int64_t>& x : {std::vector<int64_t>{12, 128, 128}, std::vector<int64_t>{16, 512, 512},
+                                        std::vector<int64_t>{64, 1000}}) {
+    cases.push_back({"Softmax", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("axis", -1)}, {Float(x)}, {Float(x)},
+                     ShapeLabel(x), 5.0 * static_cast<double>(NumElements(x))});
+  }
+}
+
+void AddTransformerCases(std::vector<KernelCase>& cases) {
+  for (const auto& [batch, seq, hidden, heads] : std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>>{
+           {1, 128, 768, 12}, {4, 256, 768, 12}, {1, 512, 1024, 16}}) {
+    const std::vector<int64_t> x{batch, seq, hidden};
+    const double projection = 2.0 * static_cast<double>(batch * seq * hidden * 3 * hidden);
+    const double attention = 4.0 * static_cast<double>(batch * seq * seq * hidden);
+    cases.push_back({"Attention", kMSDomain, 1, {{"T", kFloat}}, {IntAttr("num_heads", heads)},
+                     {Float(x), Float({hidden, 3 * hidden}), Float({3 * hidden})}, {Float(x)}, ShapeLabel(x),
+                     projection + attention});
+  }
+
+  // embedding lookup
+  for (int64_t tokens : {int64_t{128}, int64_t{2048}}) {
+    std::vector<double> indices(static_cast<size_t>(tokens));
+    for (size_t i = 0; i < indices.size(); ++i) {
+      indices[i] = static_cast<double>((i * 7919) % 30522);
+    }
+    cases.push_back({"Gather", kOnnxDomain, 13, {{"T", kFloat}, {"Tind", kInt64}}, {IntAttr("axis", 0)},
+                     {Float({30522, 768}), {kInt64, {1, tokens}, indices}}, {Float({1, tokens, 768})},
+                     "30522x768_" + std::to_string(tokens), 0});
+  }
+}
+
+void AddRecurrentCases(std::vector<KernelCase>& cases) {
+  for (const auto& [seq, batch, input_size, hidden] : std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>>{
+           {50, 1, 256, 256}, {50, 16, 256, 512}}) {
+    const std::string label = ShapeLabel({seq, batch, input_size}) + "_h" + std::to_string(hidden);
+    const double lstm_flops = 2.0 * static_cast<double>(seq * batch * 4 * hidden * (input_size + hidden));
+    cases.push_back({"LSTM", kOnnxDomain, 14, {{"T", kFloat}}, {IntAttr("hidden_size", hidden)},
+                     {Float({seq, batch, input_size}), Float({1, 4 * hidden, input_size}),
+                      Float({1, 4 * hidden, hidden}), Float({1, 8 * hidden})},
+                     {Float({seq, 1, batch, hidden})}, label, lstm_flops});
+    cases.push_back({"GRU", kOnnxDomain, 14, {{"T", kFloat}}, {IntAttr("hidden_size", hidden)},
+                     {Float({seq, batch, input_size}), Float({1, 3 * hidden, input_size}),
+                      Float({1, 3 * hidden, hidden}), Float({1, 6 * hidden})},
+                     {Float({seq, 1, batch, hidden})}, label, lstm_flops * 3.0 / 4.0});
+  }
+}
+
+void AddQuantizationCases(std::vector<KernelCase>& cases) {
+  for (int64_t size : {int64_t{1} << 16, int64_t{1} << 22}) {
+    const std::vector<int64_t> x{size};
+    cases.push_back({"QuantizeLinear", kOnnxDomain, 13, {{"T1", kFloat}, {"T2", kUInt8}}, {},
+                     {Float(x), FloatValues({}, {0.01}), {kUInt8, {}, {128}}}, {{kUInt8, x, {}}}, ShapeLabel(x),
+                     2.0 * static_cast<double>(size)});
+    cases.push_back({"DequantizeLinear", kOnnxDomain, 13, {{"T", kUInt8}}, {},
+                     {{kUInt8, x, {}}, FloatValues({}, {0.01}), {kUInt8, {}, {128}}}, {Float(x)}, ShapeLabel(x),
+                     2.0 * static_cast<double>(size)});
+    cases.push_back({"DynamicQuantizeLinear", kOnnxDomain, 11, {{"T2", kUInt8}}, {}, {Float(x)},
+                     {{kUInt8, x, {}}, Float({}), {kUInt8, {}, {}}}, ShapeLabel(x), 4.0 * static_cast<double>(size)});
+  }
+}
+
+void AddDataMovementCases(std::vector<KernelCase>& cases) {
+  cases.push_back({"Transpose", kOnnxDomain, 13, {{"T", kFloat}}, {IntsAttr("perm", {0, 2, 1, 3})},
+                   {Float({1, 128, 12, 64})}, {Float({1, 12, 128, 64})}, "1x128x12x64_0213", 0});
+  cases.push_back({"Transpose", kOnnxDomain, 13, {{"T", kFloat}}, {IntsAttr("perm", {0, 3, 1, 2})},
+                   {Float({1, 56, 56, 256})}, {Float({1, 256, 56, 56})}, "1x56x56x256_0312", 0});
+  cases.push_back({"Transpose", kOnnxDomain, 13, {{"T", kFloat}}, {IntsAttr("perm", {1, 0})},
+                   {Float({1024, 1024})}, {Float({1024, 1024})}, "1024x1024_10", 0});
+
+  cases.push_back({"Concat", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("axis", 1)},
+                   {Float({1, 64, 56, 56}), Float({1, 64, 56, 56})}, {Float({1, 128, 56, 56})}, "2x1x64x56x56", 0});
+  cases.push_back({"Concat", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("axis", -1)},
+                   {Float({12, 128, 64}), Float({12, 1, 64})}, {Float({12, 129, 64})}, "kv_cache_append", 0});
+  cases.push_back({"Split", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("axis", -1)},
+                   {Float({128, 2304}), Int64Values({768, 768, 768})},
+                   {Float({128, 768}), Float({128, 768}), Float({128, 768})}, "128x2304_3", 0});
+
+  cases.push_back({"Slice", kOnnxDomain, 13, {{"T", kFloat}, {"Tind", kInt64}}, {},
+                   {Float({1, 64, 112, 112}), Int64Values({1, 1}), Int64Values({111, 111}), Int64Values({2, 3})},
+                   {Float({1, 64, 110, 110})}, "1x64x112x112_crop", 0});
+  cases.push_back({"Pad", kOnnxDomain, 18, {{"T", kFloat}}, {},
+                   {Float({1, 64, 112, 112}), Int64Values({0, 0, 1, 1, 0, 0, 1, 1})}, {Float({1, 64, 114, 114})},
+                   "1x64x112x112_1", 0});
+  cases.push_back({"Expand", kOnnxDomain, 13, {{"T", kFloat}}, {}, {Float({1, 768}), Int64Values({512, 768})},
+                   {Float({512, 768})}, "1x768_512x768", 0});
+  cases.push_back({"Tile", kOnnxDomain, 13, {{"T", kFloat}}, {}, {Float({1, 128, 768}), Int64Values({8, 1, 1})},
+                   {Float({8, 128, 768})}, "1x128x768_8", 0});
+  cases.push_back({"Where", kOnnxDomain, 16, {{"T", kFloat}}, {},
+                   {{kBool, {12, 128, 128}, {}}, Float({12, 128, 128}), FloatValues({}, {-10000.0})},
+                   {Float({12, 128, 128})}, "12x128x128", 0});
+  cases.push_back({"Cast", kOnnxDomain, 13, {{"T1", kFloat}, {"T2", kInt32}},
+                   {IntAttr("to", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32)}, {Float({1 << 20})}, {{kInt32, {1 << 20}, {}}},
+                   "1048576_float_int32", 0});
+
+  for (const char* mode : {"nearest", "linear", "cubic"}) {
+    const std::vector<int64_t> x{1, 64, 56, 56};
+    cases.push_back({"Resize", kOnnxDomain, 13, {{"T1", kFloat}}, {StringAttr("mode", mode)},
+                     {Float(x), Float({0}), FloatValues({4}, {1.0, 1.0, 2.0, 2.0})}, {Float({1, 64, 112, 112})},
+                     ShapeLabel(x) + "_x2_" + mode, 0});
+  }
+}
+
+void AddReductionCases(std::vector<KernelCase>& cases) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> shapes{
+      {{128, 768}, {-1}}, {{8, 256, 56, 56}, {2, 3}}, {{1 << 20}, {0}}};
+  for (const auto& [x, axes] : shapes) {
+    std::vector<int64_t> y = x;
+    for (int64_t axis : axes) {
+      y[static_cast<size_t>(axis < 0 ? axis + static_cast<int64_t>(x.size()) : axis)] = 1;
+    }
+    const std::string label = ShapeLabel(x) + "_" + ShapeLabel(axes);
+    const double flops = static_cast<double>(NumElements(x));
+    cases.push_back({"ReduceMean", kOnnxDomain, 13, {{"T", kFloat}}, {IntsAttr("axes", axes)}, {Float(x)},
+                     {Float(y)}, label, flops});
+    cases.push_back({"ReduceSum", kOnnxDomain, 13, {{"T", kFloat}}, {}, {Float(x), Int64Values(axes)}, {Float(y)},
+                     label, flops});
+  }
+
+  for (const auto& [rows, cols, k] : std::vector<std::tuple<int64_t, int64_t, int64_t>>{
+           {1, 30522, 50}, {64, 1000, 5}, {16, 32000, 40}}) {
+    const std::string label = ShapeLabel({rows, cols}) + "_k" + std::to_string(k);
+    cases.push_back({"TopK", kOnnxDomain, 11, {{"T", kFloat}, {"I", kInt64}}, {},
+                     {Float({rows, cols}), Int64Values({k})}, {Float({rows, k}), {kInt64, {rows, k}, {}}}, label,
+                     static_cast<double>(rows * cols)});
+  }
+
+  cases.push_back({"ArgMax", kOnnxDomain, 13, {{"T", kFloat}}, {IntAttr("axis", -1), IntAttr("keepdims", 0)},
+                   {Float({64, 30522})}, {{kInt64, {64}, {}}}, "64x30522", 64.0 * 30522});
+}
+
+std::vector<KernelCase> CreateKernelCases() {
+  std::vector<KernelCase> cases;
+
+  AddUnaryCases(cases, "Relu", kOnnxDomain, 14, 1);
+  AddUnaryCases(cases, "Sigmoid", kOnnxDomain, 13, 4);
+  AddUnaryCases(cases, "Tanh", kOnnxDomain, 13, 4);
+  AddUnaryCases(cases, "Exp", kOnnxDomain, 13, 4);
+  AddUnaryCases(cases, "Erf", kOnnxDomain, 13, 4);
+  AddUnaryCases(cases, "Abs", kOnnxDomain, 13, 1);
+  AddUnaryCases(cases, "Sqrt", kOnnxDomain, 13, 1);
+  AddUnaryCases(cases, "LeakyRelu", kOnnxDomain, 16, 2);
+  AddUnaryCases(cases, "Gelu", kMSDomain, 1, 8);
+  AddUnaryCases(cases, "FastGelu", kMSDomain, 1, 8);
+  AddUnaryCases(cases, "QuickGelu", kMSDomain, 1, 5);
+  for (const char* op_type : {"Add", "Sub", "Mul", "Div"}) {
+    AddBinaryCases(cases, op_type);
+  }
+
+  AddMatMulCases(cases);
+  AddConvCases(cases);
+  AddPoolCases(cases);
+  AddNormalizationCases(cases);
+  AddTransformerCases(cases);
+  AddRecurrentCases(cases);
+  AddQuantizationCases(cases);
+  AddDataMovementCases(cases);
+  AddReductionCases(cases);
+
+  return cases;
+}
+
+const std::vector<KernelCase>& GetKernelCases() {
+  static const std::vector<KernelCase> cases = CreateKernelCases();
+  return cases;
+}
+
+// every case runs single threaded and on the intra op thread pool
+const bool kernel_benchmarks_registered = []() {
+  for (const auto& kernel_case : GetKernelCases()) {
+    const std::string name = "BM_Kernel/" + (kernel_case.domain.empty() ? "" : kernel_case.domain + ".") +
+                             kernel_case.op_type + "/" + kernel_case.label;
+    for (bool use_thread_pool : {false, true}) {
+      benchmark::RegisterBenchmark((name + (use_thread_pool ? "/intra_op:pool" : "/intra_op:1")).c_str(),
+                                   [&kernel_case, use_thread_pool](benchmark::State& state) {
+                                     RunKernelCase(state, kernel_case, use_thread_pool);
+                                   })
+          ->UseRealTime()
+          ->Unit(benchmark::TimeUnit::kMicrosecond);
+    }
+  }
+  return true;
+}();
+
+}  // namespace
+
+// Prints the kernels registered by the CPU EP that have no case in this file.
+void PrintUncoveredKernels(std::ostream& os) {
+  std::set<std::pair<std::string, std::string>> covered;
+  for (const auto& kernel_case : GetKernelCases()) {
+    covered.emplace(kernel_case.domain, kernel_case.op_type);
+  }
+
+  std::set<std::pair<std::string, std::string>> uncovered;
+  auto registry = KernelBenchEnvironment::Get().provider.GetKernelRegistry();
+  for (const auto& entry : registry->GetKernelCreateMap()) {
+    const KernelDef& kernel_def = *entry.second.kernel_def;
+    std::pair<std::string, std::string> op{kernel_def.Domain(), kernel_def.OpName()};
+    if (covered.count(op) == 0) {
+      uncovered.insert(std::move(op));
+    }
+  }
+
+  os << covered.size() << " ops have benchmarks, " << uncovered.size() << " registered CPU ops have none:\n";
+  for (const auto& [domain, op_type] : uncovered) {
+    os << "  " << (domain.empty() ? std::string(kOnnxDomainAlias) : domain) << "." << op_type << "\n";
+  }
+}
@@ -18,7 +18,9 @@
 #include <core/session/ort_env.h>
 #include <core/util/thread_utils.h>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 #include <unordered_map>
 
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
@@ -74,11 +76,30 @@ BENCHMARK(BM_ResolveGraph);
     }                                                        \
   } while (0);
 
+// kernels.cc
+void PrintUncoveredKernels(std::ostream& os);
+
 int main(int argc, char** argv) {
+  // our own flag, removed before google benchmark sees the arguments
+  bool list_uncovered_kernels = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--list_uncovered_kernels") {
+      list_uncovered_kernels = true;
+      std::copy(argv + i + 1, argv + argc, argv + i);
+      --argc;
+      break;
+    }
+  }
+
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
+  if (list_uncovered_kernels) {
+    PrintUncoveredKernels(std::cout);
+    g_ort->ReleaseEnv(env);
+    return 0;
+  }
   ::benchmark::RunSpecifiedBenchmarks();
   g_ort->ReleaseEnv(env);
   return 0;
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void TestEmbeddingBagFusion(const std::string& reduce_op, int opset_version, int64_t axis, int64_t keepdims,
+                                   int expected_fused_count) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({50, 24}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({6, 5}, -50, 50);
+    auto* gather_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+
+    // ReduceSum takes the axes as an input from opset 13, the other reductions from opset 18.
+    const bool axes_as_input = opset_version >= 18 || (reduce_op == "ReduceSum" && opset_version >= 13);
+    Node* reduce_node;
+    if (axes_as_input) {
+      auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {axis});
+      reduce_node = &builder.AddNode(reduce_op, {gather_out, axes_arg}, {output_arg});
+    } else {
+      reduce_node = &builder.AddNode(reduce_op, {gather_out}, {output_arg});
+      reduce_node->AddAttribute("axes", std::vector<int64_t>{axis});
+    }
+    reduce_node->AddAttribute("keepdims", keepdims);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], expected_fused_count);
+    EXPECT_EQ(op_to_count["Gather"], 1 - expected_fused_count);
+    EXPECT_EQ(op_to_count[reduce_op], 1 - expected_fused_count);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level2, opset_version, 1e-5, 1e-5);
+}
+
+TEST(EmbeddingBagFusionTests, ReduceSum) {
+  TestEmbeddingBagFusion("ReduceSum", 12, 1, 0, 1);
+  TestEmbeddingBagFusion("ReduceSum", 13, -2, 0, 1);
+}
+
+TEST(EmbeddingBagFusionTests, ReduceMean) {
+  TestEmbeddingBagFusion("ReduceMean", 13, 1, 0, 1);
+}
+
+TEST(EmbeddingBagFusionTests, ReduceMax) {
+  TestEmbeddingBagFusion("ReduceMax", 13, 1, 0, 1);
+}
+
+TEST(EmbeddingBagFusionTests, NotFused) {
+  // The bag dimension is kept in the output.
+  TestEmbeddingBagFusion("ReduceSum", 13, 1, 1, 0);
+  // The reduction is over the embedding dimension.
+  TestEmbeddingBagFusion("ReduceMean", 13, 2, 0, 0);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
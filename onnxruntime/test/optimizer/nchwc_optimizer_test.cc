@@ -407,6 +407,60 @@ TEST(NchwcOptimizerTests, ConvPointwise) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvDepthwisePointwise) {
+  auto test_case = [&](const std::string& activation_op_type, bool do_residual) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+      auto* conv1_output_arg = helper.MakeIntermediate();
+      auto* conv2_output_arg = helper.MakeIntermediate();
+      auto* conv3_output_arg = helper.MakeIntermediate();
+      auto* conv4_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv1_output_arg, {32, 32, 3, 3});
+      helper.AddConvNode(conv1_output_arg, conv2_output_arg, {96, 32, 1, 1});
+
+      auto* dw_output_arg = conv3_output_arg;
+      if (!activation_op_type.empty()) {
+        dw_output_arg = helper.MakeIntermediate();
+        helper.AddNode(activation_op_type, {dw_output_arg}, {conv3_output_arg});
+      }
+
+      auto& conv3_node = helper.AddConvNode(conv2_output_arg, dw_output_arg, {96, 1, 3, 3});
+      conv3_node.AddAttribute("group", static_cast<int64_t>(96));
+      conv3_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+
+      helper.AddConvNode(conv3_output_arg, do_residual ? conv4_output_arg : output_arg, {32, 96, 1, 1});
+
+      if (do_residual) {
+        helper.AddNode("Add", {conv4_output_arg, conv1_output_arg}, {output_arg});
+      }
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.SeparableConv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+      EXPECT_EQ(op_to_count["Add"], 0);
+      if (!activation_op_type.empty()) {
+        EXPECT_EQ(op_to_count[activation_op_type], 0);
+      }
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that a depthwise convolution followed by a pointwise convolution is
+  // fused, including the activation between them and the inverted residual Add.
+  std::vector<std::string> activation_op_types{"", "Relu", "LeakyRelu"};
+  for (auto& activation_op_type : activation_op_types) {
+    test_case(activation_op_type, false);
+    test_case(activation_op_type, true);
+  }
+}
+
 TEST(NchwcOptimizerTests, ConvMaxPool) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput<float>({1, 48, 34, 34});
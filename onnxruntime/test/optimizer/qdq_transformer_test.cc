@@ -986,6 +986,54 @@ TEST(QDQTransformerTests, Where) {
   test_case({1}, {1}, {1});
 }
 
+TEST(QDQTransformerTests, LayerNormalization) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, bool use_bias) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<uint8_t>(input_shape, 0, 255);
+      auto* output_arg = builder.MakeOutput();
+
+      // add DQ
+      auto* dq_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<uint8_t>(input_arg, .02f, 128, dq_output);
+
+      // add LayerNormalization with float Scale and B
+      const std::vector<int64_t> norm_shape{input_shape.back()};
+      std::vector<NodeArg*> inputs{dq_output, builder.MakeInitializer<float>(norm_shape, -2.f, 2.f)};
+      if (use_bias) {
+        inputs.push_back(builder.MakeInitializer<float>(norm_shape, -1.f, 1.f));
+      }
+      auto* layer_norm_output = builder.MakeIntermediate();
+      Node& layer_norm_node = builder.AddNode("LayerNormalization", inputs, {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+      layer_norm_node.AddAttribute("epsilon", 1e-5f);
+
+      // add Q
+      builder.AddQuantizeLinearNode<uint8_t>(layer_norm_output, .03f, 128, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/);
+  };
+
+  test_case({2, 8, 64}, true);
+  test_case({3, 37}, true);
+  test_case({2, 8, 64}, false);
+  test_case({3, 37}, false);
+}
+
 TEST(QDQTransformerTests, Transpose) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perms) {
     auto check_graph = [&](InferenceSessionWrapper& session) {
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Build a K x N weight where roughly one element out of 'stride' is non-zero.
+static std::vector<float> MakePrunedWeight(int64_t K, int64_t N, size_t stride) {
+  std::vector<float> weight(static_cast<size_t>(K * N), 0.0f);
+  for (size_t i = 0; i < weight.size(); i += stride) {
+    weight[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.125f;
+  }
+  return weight;
+}
+
+static void TestSparseWeightGemm(const std::string& op_type, const std::vector<int64_t>& input_shape,
+                                 int64_t N, size_t stride, const std::string& density_threshold,
+                                 int expected_sparse_count) {
+  const int64_t K = input_shape.back();
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+    auto* weight_arg = builder.MakeInitializer<float>({K, N}, MakePrunedWeight(K, N, stride));
+    auto* output_arg = builder.MakeOutput();
+
+    if (op_type == "Gemm") {
+      auto* bias_arg = builder.MakeInitializer<float>({N}, -1.f, 1.f);
+      auto& gemm_node = builder.AddNode("Gemm", {input_arg, weight_arg, bias_arg}, {output_arg});
+      gemm_node.AddAttribute("alpha", 0.5f);
+    } else {
+      builder.AddNode("MatMul", {input_arg, weight_arg}, {output_arg});
+    }
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.SparseWeightGemm"], expected_sparse_count);
+    EXPECT_EQ(op_to_count[op_type], 1 - expected_sparse_count);
+  };
+
+  // an empty threshold keeps the default
+  auto add_session_options = [&](SessionOptions& session_options) {
+    if (!density_threshold.empty()) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+          kOrtSessionOptionsSparseWeightDensityThreshold, density_threshold.c_str()));
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level2, 13, 1e-5, 1e-5,
+                    nullptr, add_session_options);
+}
+
+TEST(SparseWeightGemmTests, MatMul) {
+  TestSparseWeightGemm("MatMul", {2, 7, 128}, 96, 16, "0.1", 1);
+  TestSparseWeightGemm("MatMul", {33, 256}, 64, 5, "0.25", 1);
+}
+
+TEST(SparseWeightGemmTests, Gemm) {
+  TestSparseWeightGemm("Gemm", {21, 128}, 80, 12, "0.1", 1);
+}
+
+TEST(SparseWeightGemmTests, DenseWeightNotConverted) {
+  // Weight density is above the threshold.
+  TestSparseWeightGemm("MatMul", {4, 128}, 64, 2, "0.1", 0);
+  // Optimization disabled, explicitly and by default.
+  TestSparseWeightGemm("MatMul", {4, 128}, 64, 16, "0", 0);
+  TestSparseWeightGemm("MatMul", {4, 128}, 64, 16, "", 0);
+  // Weight is too small to benefit.
+  TestSparseWeightGemm("MatMul", {4, 32}, 16, 16, "0.1", 0);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -26,6 +26,7 @@ namespace perftest {
 /*static*/ void CommandLineParser::ShowUsage() {
   printf(
       "perf_test [options...] model_path [result_file]\n"
+      "perf_test [options...] -W scenario_file [result_file]\n"
       "Options:\n"
       "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
@@ -104,6 +105,9 @@ namespace perftest {
       "\t\t The number of affinities must be equal to intra_op_num_threads - 1\n\n"
       "\t-D [Disable thread spinning]: disable spinning entirely for thread owned by onnxruntime intra-op thread pool.\n"
       "\t-Z [Force thread to stop spinning between runs]: disallow thread from spinning during runs to reduce cpu usage.\n"
+      "\t-W [scenario_file]: Run a mixed workload of several models described in the file instead of a single model.\n"
+      "\t\t Each model gets requests at its own rate and arrival distribution, and throughput and latency are reported\n"
+      "\t\t per model. See test/perftest/README.md for the file format.\n"
       "\t-h: help\n");
 }
 #ifdef _WIN32
@@ -133,7 +137,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:AMPIDZvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:W:AMPIDZvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -308,6 +312,9 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'Z':
         test_config.run_config.disable_spinning_between_run = true;
         break;
+      case 'W':
+        test_config.run_config.scenario_file = optarg;
+        break;
       case '?':
       case 'h':
       default:
@@ -319,6 +326,22 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   argc -= optind;
   argv += optind;
 
+  // the models come from the scenario file, only the result file can follow
+  if (!test_config.run_config.scenario_file.empty()) {
+    switch (argc) {
+      case 1:
+        test_config.model_info.result_file_path = argv[0];
+        break;
+      case 0:
+        test_config.run_config.f_dump_statistics = true;
+        break;
+      default:
+        return false;
+    }
+
+    return true;
+  }
+
   switch (argc) {
     case 2:
       test_config.model_info.result_file_path = argv[1];
@@ -6,6 +6,7 @@
 #include <random>
 #include "command_args_parser.h"
 #include "performance_runner.h"
+#include "scenario_runner.h"
 #include <google/protobuf/stubs/common.h>
 
 using namespace onnxruntime;
@@ -22,6 +23,18 @@ int real_main(int argc, char* argv[]) {
     perftest::CommandLineParser::ShowUsage();
     return -1;
   }
+
+  const bool run_scenario = !test_config.run_config.scenario_file.empty();
+  perftest::Scenario scenario;
+  if (run_scenario) {
+    auto status = perftest::LoadScenario(test_config.run_config.scenario_file, scenario);
+    if (!status.IsOK()) {
+      fprintf(stderr, "Error loading scenario: %s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+    test_config.run_config.use_global_thread_pools = scenario.shared_thread_pool;
+  }
+
   Ort::Env env{nullptr};
   {
     bool failed = false;
@@ -29,7 +42,16 @@ int real_main(int argc, char* argv[]) {
       OrtLoggingLevel logging_level = test_config.run_config.f_verbose
                                           ? ORT_LOGGING_LEVEL_VERBOSE
                                           : ORT_LOGGING_LEVEL_WARNING;
-      env = Ort::Env(logging_level, "Default");
+      if (test_config.run_config.use_global_thread_pools) {
+        Ort::ThreadingOptions threading_options;
+        threading_options.SetGlobalIntraOpNumThreads(scenario.shared_intra_op_num_threads);
+        if (test_config.run_config.disable_spinning) {
+          threading_options.SetGlobalSpinControl(0);
+        }
+        env = Ort::Env(threading_options, logging_level, "Default");
+      } else {
+        env = Ort::Env(logging_level, "Default");
+      }
     }
     ORT_CATCH(const Ort::Exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -42,6 +64,18 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
+  if (run_scenario) {
+    perftest::ScenarioRunner scenario_runner(env, test_config, scenario, rd);
+    auto status = scenario_runner.Run();
+    if (!status.IsOK()) {
+      printf("Run failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+
+    scenario_runner.SerializeResult();
+    return 0;
+  }
+
   perftest::PerformanceRunner perf_runner(env, test_config, rd);
   auto status = perf_runner.Run();
   if (!status.IsOK()) {
@@ -160,6 +160,27 @@ Status PerformanceRunner::Run() {
   return Status::OK();
 }
 
+Status PerformanceRunner::Prepare() {
+  if (!Initialize()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
+  }
+
+  return RunOneIteration<true>();
+}
+
+Status PerformanceRunner::RunRequest(std::chrono::duration<double>& duration) {
+  auto status = Status::OK();
+  ORT_TRY {
+    duration = session_->Run();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunRequest caught exception: ", ex.what());
+    });
+  }
+  return status;
+}
+
 Status PerformanceRunner::FixDurationTest() {
   if (performance_test_config_.run_config.concurrent_session_runs <= 1) {
     return RunFixDuration();
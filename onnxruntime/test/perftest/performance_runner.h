@@ -48,6 +48,12 @@ class PerformanceRunner {
 
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
+  // Loads the inputs and runs the warm up request, for callers that issue the requests themselves.
+  Status Prepare();
+
+  // Runs one request and returns how long Run took. Nothing is recorded. Safe to call from several threads.
+  Status RunRequest(std::chrono::duration<double>& duration);
+
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
@@ -60,17 +66,7 @@ class PerformanceRunner {
   template <bool isWarmup>
   Status RunOneIteration() {
     std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
-
-    auto status = Status::OK();
-    ORT_TRY {
-      duration_seconds = session_->Run();
-    }
-    ORT_CATCH(const std::exception& ex) {
-      ORT_HANDLE_EXCEPTION([&]() {
-        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
-      });
-    }
-    ORT_RETURN_IF_ERROR(status);
+    ORT_RETURN_IF_ERROR(RunRequest(duration_seconds));
 
     if (!isWarmup) {
       std::lock_guard<OrtMutex> guard(results_mutex_);
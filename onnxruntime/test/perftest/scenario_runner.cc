@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "scenario_runner.h"
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "core/common/path_string.h"
+#include "performance_runner.h"
+#include "utils.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+template <typename T>
+bool ParseValue(const std::string& str, T& value) {
+  std::istringstream stream(str);
+  stream >> value;
+  return !stream.fail() && stream.eof();
+}
+
+Status ParseModel(std::istringstream& tokens, size_t line_number, ScenarioModel& model) {
+  std::string entry;
+  std::string path;
+  while (tokens >> entry) {
+    const auto separator = entry.find('=');
+    ORT_RETURN_IF(separator == std::string::npos, "line ", line_number, ": expected key=value, got '", entry, "'");
+    const std::string key = entry.substr(0, separator);
+    const std::string value = entry.substr(separator + 1);
+
+    bool parsed = true;
+    if (key == "name") {
+      model.name = value;
+    } else if (key == "path") {
+      path = value;
+    } else if (key == "rate") {
+      parsed = ParseValue(value, model.rate) && model.rate > 0;
+    } else if (key == "arrival") {
+      if (value == "constant") {
+        model.arrival = ArrivalDistribution::kConstant;
+      } else if (value == "poisson") {
+        model.arrival = ArrivalDistribution::kPoisson;
+      } else if (value == "bursty") {
+        model.arrival = ArrivalDistribution::kBursty;
+      } else {
+        parsed = false;
+      }
+    } else if (key == "burst") {
+      parsed = ParseValue(value, model.burst_size) && model.burst_size > 0;
+    } else if (key == "concurrency") {
+      parsed = ParseValue(value, model.concurrency) && model.concurrency > 0;
+    } else if (key == "intra_op_threads") {
+      parsed = ParseValue(value, model.intra_op_num_threads) && model.intra_op_num_threads >= 0;
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "line ", line_number, ": unknown model setting '", key, "'");
+    }
+
+    ORT_RETURN_IF_NOT(parsed, "line ", line_number, ": invalid value for ", key, ": '", value, "'");
+  }
+
+  ORT_RETURN_IF(path.empty(), "line ", line_number, ": model needs a path");
+  model.model_path = ToPathString(path);
+  if (model.name.empty()) {
+    model.name = path;
+  }
+
+  return Status::OK();
+}
+
+double Percentile(const std::vector<double>& sorted_values, double percentile) {
+  if (sorted_values.empty()) {
+    return 0;
+  }
+  // same rounding as PerformanceResult::DumpToFile
+  const auto idx = static_cast<size_t>(static_cast<double>(sorted_values.size()) * percentile);
+  return sorted_values[std::min(idx, sorted_values.size() - 1)];
+}
+}  // namespace
+
+Status LoadScenario(const std::basic_string<ORTCHAR_T>& path, Scenario& scenario) {
+  std::ifstream file(path);
+  ORT_RETURN_IF_NOT(file.good(), "failed to open scenario file ", PathToUTF8String(path));
+
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    const auto comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.resize(comment);
+    }
+
+    std::istringstream tokens(line);
+    std::string keyword;
+    if (!(tokens >> keyword)) {
+      continue;
+    }
+
+    if (keyword == "duration") {
+      ORT_RETURN_IF_NOT((tokens >> scenario.duration_in_seconds) && scenario.duration_in_seconds > 0,
+                        "line ", line_number, ": duration must be a number of seconds > 0");
+    } else if (keyword == "shared_thread_pool") {
+      scenario.shared_thread_pool = true;
+      if (!(tokens >> scenario.shared_intra_op_num_threads)) {
+        scenario.shared_intra_op_num_threads = 0;
+      }
+      ORT_RETURN_IF(scenario.shared_intra_op_num_threads < 0, "line ", line_number,
+                    ": shared_thread_pool size must be >= 0");
+    } else if (keyword == "model") {
+      ScenarioModel model;
+      ORT_RETURN_IF_ERROR(ParseModel(tokens, line_number, model));
+      scenario.models.push_back(std::move(model));
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "line ", line_number, ": unknown entry '", keyword, "'");
+    }
+  }
+
+  ORT_RETURN_IF(scenario.models.empty(), "scenario file ", PathToUTF8String(path), " has no models");
+
+  // the sessions don't have their own intra op pool when it is shared, so the setting would be ignored
+  if (scenario.shared_thread_pool) {
+    for (const auto& model : scenario.models) {
+      ORT_RETURN_IF(model.intra_op_num_threads >= 0, "model ", model.name,
+                    ": intra_op_threads can't be set with shared_thread_pool. Set the size of the shared pool instead");
+    }
+  }
+
+  return Status::OK();
+}
+
+ScenarioRunner::ScenarioRunner(Ort::Env& env, const PerformanceTestConfig& test_config, const Scenario& scenario,
+                               std::random_device& rd)
+    : test_config_(test_config), scenario_(scenario), rd_(rd) {
+  for (const auto& model : scenario_.models) {
+    PerformanceTestConfig model_config = test_config_;
+    model_config.model_info.model_file_path = model.model_path;
+    if (model.intra_op_num_threads >= 0) {
+      model_config.run_config.intra_op_num_threads = model.intra_op_num_threads;
+    }
+
+    runners_.push_back(std::make_unique<PerformanceRunner>(env, model_config, rd_));
+  }
+}
+
+ScenarioRunner::~ScenarioRunner() = default;
+
+Status ScenarioRunner::Run() {
+  for (auto& runner : runners_) {
+    ORT_RETURN_IF_ERROR(runner->Prepare());
+  }
+
+  const size_t num_models = scenario_.models.size();
+  results_.clear();
+  results_.resize(num_models);
+
+  // std::random_device isn't safe to use from several threads
+  std::vector<uint32_t> seeds(num_models);
+  for (auto& seed : seeds) {
+    seed = rd_();
+  }
+
+  std::unique_ptr<utils::ICPUUsage> cpu_usage = utils::CreateICPUUsage();
+  const auto start = std::chrono::steady_clock::now();
+  const auto end_time =
+      start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(scenario_.duration_in_seconds));
+
+  std::vector<std::thread> model_threads;
+  model_threads.reserve(num_models);
+  for (size_t i = 0; i < num_models; ++i) {
+    model_threads.emplace_back([this, i, &seeds, end_time]() { RunModel(i, seeds[i], end_time); });
+  }
+  for (auto& thread : model_threads) {
+    thread.join();
+  }
+
+  wall_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  average_CPU_usage_ = cpu_usage->GetUsage();
+  peak_workingset_size_ = utils::GetPeakWorkingSetSize();
+
+  return Status::OK();
+}
+
+void ScenarioRunner::RunModel(size_t model_idx, uint32_t seed, std::chrono::steady_clock::time_point end_time) {
+  const ScenarioModel& model = scenario_.models[model_idx];
+  PerformanceRunner& runner = *runners_[model_idx];
+  ScenarioModelResult& result = results_[model_idx];
+  result.name = model.name;
+
+  // arrival times of the requests waiting for a worker
+  std::deque<std::chrono::steady_clock::time_point> pending;
+  bool arrivals_done = false;
+  OrtMutex mutex;
+  OrtCondVar cv;
+
+  auto worker = [&]() {
+    for (;;) {
+      std::chrono::steady_clock::time_point arrival;
+      {
+        std::unique_lock<OrtMutex> lock(mutex);
+        cv.wait(lock, [&]() { return arrivals_done || !pending.empty(); });
+        if (pending.empty()) {
+          return;
+        }
+        arrival = pending.front();
+        pending.pop_front();
+      }
+
+      std::chrono::duration<double> service_time(0);
+      auto status = runner.RunRequest(service_time);
+      const double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - arrival).count();
+
+      std::lock_guard<OrtMutex> lock(mutex);
+      ++result.requests;
+      if (status.IsOK()) {
+        result.latencies.push_back(latency);
+        result.total_service_time += service_time.count();
+      } else if (result.errors++ == 0) {
+        std::cerr << model.name << ": " << status.ErrorMessage() << std::endl;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(model.concurrency);
+  for (size_t i = 0; i < model.concurrency; ++i) {
+    workers.emplace_back(worker);
+  }
+
+  std::mt19937 rng(seed);
+  const bool bursty = model.arrival == ArrivalDistribution::kBursty;
+  const size_t requests_per_arrival = bursty ? model.burst_size : 1;
+  std::exponential_distribution<double> gap_distribution(model.rate / static_cast<double>(requests_per_arrival));
+
+  auto next_arrival = std::chrono::steady_clock::now();
+  for (;;) {
+    const double gap = model.arrival == ArrivalDistribution::kConstant ? 1.0 / model.rate : gap_distribution(rng);
+    next_arrival += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(gap));
+    if (next_arrival >= end_time) {
+      break;
+    }
+
+    std::this_thread::sleep_until(next_arrival);
+    {
+      std::lock_guard<OrtMutex> lock(mutex);
+      pending.insert(pending.end(), requests_per_arrival, next_arrival);
+    }
+    cv.notify_all();
+  }
+
+  // requests that already arrived still run, so the latency of a backlog shows up in the results
+  {
+    std::lock_guard<OrtMutex> lock(mutex);
+    arrivals_done = true;
+  }
+  cv.notify_all();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+}
+
+void ScenarioRunner::SerializeResult() const {
+  const auto& result_file_path = test_config_.model_info.result_file_path;
+  std::ofstream outfile;
+  if (!result_file_path.empty()) {
+    outfile.open(result_file_path, std::ofstream::out | std::ofstream::app);
+    if (!outfile.good()) {
+      std::cerr << "failed to open result file '" << PathToUTF8String(result_file_path) << "'.\n";
+    }
+  }
+
+  std::cout << "Scenario run time: " << wall_time_ << " s\n"
+            << "Avg CPU usage: " << average_CPU_usage_ << " %\n"
+            << "Peak working set size: " << peak_workingset_size_ << " bytes\n";
+
+  for (const auto& result : results_) {
+    std::vector<double> sorted_latencies = result.latencies;
+    std::sort(sorted_latencies.begin(), sorted_latencies.end());
+
+    const double throughput = wall_time_ > 0 ? static_cast<double>(sorted_latencies.size()) / wall_time_ : 0;
+    const double p50 = Percentile(sorted_latencies, 0.5) * 1000;
+    const double p99 = Percentile(sorted_latencies, 0.99) * 1000;
+    const double p999 = Percentile(sorted_latencies, 0.999) * 1000;
+    const double average_service_time =
+        sorted_latencies.empty() ? 0 : result.total_service_time / static_cast<double>(sorted_latencies.size()) * 1000;
+    // average number of requests of the model inside Run at any time
+    const double busy = wall_time_ > 0 ? result.total_service_time / wall_time_ : 0;
+
+    std::cout << "\nModel: " << result.name << "\n"
+              << "Requests: " << result.requests << " (" << result.errors << " failed)\n"
+              << "Throughput: " << throughput << " requests/s\n"
+              << "P50 Latency: " << p50 << " ms\n"
+              << "P99 Latency: " << p99 << " ms\n"
+              << "P999 Latency: " << p999 << " ms\n"
+              << "Average Run time: " << average_service_time << " ms\n"
+              << "Average requests in Run: " << busy << "\n";
+
+    if (outfile.good() && outfile.is_open()) {
+      outfile << result.name << "," << result.requests << "," << result.errors << "," << throughput << ","
+              << p50 << "," << p99 << "," << p999 << "," << average_service_time << "," << busy << ","
+              << average_CPU_usage_ << "," << peak_workingset_size_ << std::endl;
+    }
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
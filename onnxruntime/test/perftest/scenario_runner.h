@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <core/common/common.h>
+#include <core/common/status.h>
+#include <core/platform/ort_mutex.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include "test_configuration.h"
+
+namespace onnxruntime {
+namespace perftest {
+
+class PerformanceRunner;
+
+enum class ArrivalDistribution : std::uint8_t {
+  kConstant = 0,  // requests every 1/rate seconds
+  kPoisson,       // exponentially distributed gaps with a mean of 1/rate seconds
+  kBursty         // bursts of burst_size requests at once, the bursts arriving as a Poisson process
+};
+
+struct ScenarioModel {
+  std::string name;
+  std::basic_string<ORTCHAR_T> model_path;
+  double rate{1.0};  // requests per second
+  ArrivalDistribution arrival{ArrivalDistribution::kPoisson};
+  size_t burst_size{1};
+  // requests of the model that run at the same time. later arrivals wait and their queueing time counts in the latency.
+  size_t concurrency{1};
+  int intra_op_num_threads{-1};  // -1 uses the value of the command line. not allowed with a shared pool
+};
+
+// A mixed workload read from a scenario file. Format, one entry per line, # starts a comment:
+//   duration <seconds>
+//   shared_thread_pool <intra op threads>    all the sessions share one intra op pool. 0 picks the default size.
+//   model name=<name> path=<model> rate=<requests/s> [arrival=poisson|bursty|constant] [burst=<n>]
+//         [concurrency=<n>] [intra_op_threads=<n>]
+struct Scenario {
+  double duration_in_seconds{60.0};
+  bool shared_thread_pool{false};
+  int shared_intra_op_num_threads{0};
+  std::vector<ScenarioModel> models;
+};
+
+Status LoadScenario(const std::basic_string<ORTCHAR_T>& path, Scenario& scenario);
+
+struct ScenarioModelResult {
+  std::string name;
+  size_t requests{0};
+  size_t errors{0};
+  // from the arrival of each request to its completion, so queueing is included
+  std::vector<double> latencies;
+  // time spent in Run for all the requests
+  double total_service_time{0};
+};
+
+// Replays the requests of several models at the same time and reports throughput and latency per model.
+class ScenarioRunner {
+ public:
+  ScenarioRunner(Ort::Env& env, const PerformanceTestConfig& test_config, const Scenario& scenario,
+                 std::random_device& rd);
+  ~ScenarioRunner();
+
+  Status Run();
+
+  // Prints the results, and appends one line per model to the result file if one was given.
+  void SerializeResult() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ScenarioRunner);
+
+ private:
+  // Issues the requests of one model until end_time and waits for the ones that arrived to complete.
+  void RunModel(size_t model_idx, uint32_t seed, std::chrono::steady_clock::time_point end_time);
+
+  PerformanceTestConfig test_config_;
+  Scenario scenario_;
+  std::random_device& rd_;
+  std::vector<std::unique_ptr<PerformanceRunner>> runners_;
+  std::vector<ScenarioModelResult> results_;
+
+  double wall_time_{0};
+  short average_CPU_usage_{0};
+  size_t peak_workingset_size_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
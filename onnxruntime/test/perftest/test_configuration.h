@@ -61,6 +61,10 @@ struct RunConfig {
   std::string intra_op_thread_affinities;
   bool disable_spinning = false;
   bool disable_spinning_between_run = false;
+  // multi model scenario to run instead of a single model. see scenario_runner.h for the format.
+  std::basic_string<ORTCHAR_T> scenario_file;
+  // sessions use the thread pools of the environment instead of their own
+  bool use_global_thread_pools{false};
 };
 
 struct PerformanceTestConfig {
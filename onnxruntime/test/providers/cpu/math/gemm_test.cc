@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "core/framework/run_options.h"
+#include "core/mlas/inc/mlas.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -147,6 +148,33 @@ TEST(GemmOpTest, GemmNoTrans_bfloat16) {
 }
 #endif  // USE_CUDA USE_RCOM USE_DNNL
 
+TEST(GemmOpTest, GemmTransB_f16_Cpu) {
+  if (!MlasHalfGemmAccelerationSupported()) {
+    GTEST_SKIP() << "Skipping because MLAS has no optimized half precision GEMM on this CPU.";
+  }
+
+  OpTester test("Gemm", 13);
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 2.0f);
+  test.AddAttribute("beta", 0.5f);
+
+  // B is an initializer so the transposed copy is made in PrePack
+  test.AddInput<MLFloat16>("A", {2, 4}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f}));
+  test.AddInput<MLFloat16>("B", {3, 4}, FloatsToMLFloat16s({1.0f, 1.0f, 1.0f, 1.0f,
+                                                       1.0f, 0.0f, 1.0f, 0.0f,
+                                                       0.0f, 1.0f, 0.0f, 1.0f}),
+                           true);
+  test.AddInput<MLFloat16>("C", {3}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 3}, FloatsToMLFloat16s({20.5f, 9.0f, 13.5f, -19.5f, -7.0f, -10.5f}));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 template <typename T>
 void TestGemmBroadcast() {
   auto run_test = [](bool b_is_initializer, bool c_is_initializer) {
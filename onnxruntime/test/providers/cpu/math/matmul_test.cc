@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/mlas/inc/mlas.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
@@ -253,6 +254,33 @@ TEST(MathOpTest, MatMul_Float16) {
 }
 #endif
 
+TEST(MathOpTest, MatMul_Float16_Cpu) {
+  if (!MlasHalfGemmAccelerationSupported()) {
+    GTEST_SKIP() << "Skipping because MLAS has no optimized half precision GEMM on this CPU.";
+  }
+
+  OpTester test("MatMul", 13);
+
+  // batched A with a broadcast B
+  test.AddInput<MLFloat16>("A", {2, 2, 4}, FloatsToMLFloat16s({1.0f, 2.0f, 3.0f, 4.0f,
+                                                          -1.0f, -2.0f, -3.0f, -4.0f,
+                                                          0.5f, 0.5f, 0.5f, 0.5f,
+                                                          1.0f, 0.0f, 0.0f, 1.0f}));
+  test.AddInput<MLFloat16>("B", {4, 3}, FloatsToMLFloat16s({1.0f, 0.0f, 1.0f,
+                                                       0.0f, 1.0f, 1.0f,
+                                                       1.0f, 0.0f, 1.0f,
+                                                       0.0f, 1.0f, 1.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 2, 3}, FloatsToMLFloat16s({4.0f, 6.0f, 10.0f,
+                                                           -4.0f, -6.0f, -10.0f,
+                                                           1.0f, 1.0f, 2.0f,
+                                                           1.0f, 1.0f, 2.0f}));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(MathOpTest, MatMul_bfloat16) {
 #ifdef USE_CUDA
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -861,5 +863,69 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+template <typename T>
+static void TestLargeRows(int64_t k, int64_t rows, int64_t cols, int64_t largest) {
+  // use a small range of values so there are many ties, which select the lower index first
+  std::vector<T> input_vals(rows * cols);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>(static_cast<int64_t>((i * 7919) % 1013) - 506) / 8;
+  }
+
+  std::vector<int64_t> input_dimensions = {rows, cols};
+  std::vector<T> expected_vals;
+  std::vector<int64_t> expected_indices;
+  std::vector<int64_t> expected_dimensions = {rows, k};
+
+  for (int64_t i = 0; i < rows; ++i) {
+    const T* row = input_vals.data() + i * cols;
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(row[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, -1,
+          largest);
+}
+
+// a few long rows, e.g. the logits of one sequence over a large vocabulary, are split across the threads.
+// this covers the scan for k = 1, the heap, nth_element and the radix select for float.
+TEST(TopKOperator, LargeRowsSplitAcrossThreads) {
+  for (int64_t largest : {1, 0}) {
+    for (int64_t k : {1, 10, 1000, 30000}) {
+      TestLargeRows<float>(k, 1, 100000, largest);
+      TestLargeRows<double>(k, 1, 100000, largest);
+    }
+    TestLargeRows<float>(500, 2, 70000, largest);
+  }
+}
+
+// the radix select used for float treats -0.0 and 0.0 as equal like the comparisons do
+TEST(TopKOperator, RadixSelectSignedZeros) {
+  std::vector<float> input_vals(40);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = i % 4 == 0 ? 1.0f : (i % 2 == 0 ? 0.0f : -0.0f);
+  }
+  std::vector<int64_t> input_dimensions = {40};
+  std::vector<float> expected_vals(30, 0.0f);
+  std::vector<int64_t> expected_indices;
+  for (int64_t i = 0; i < 40; i += 4) {
+    expected_indices.push_back(i);
+  }
+  std::fill_n(expected_vals.begin(), 10, 1.0f);
+  for (int64_t i = 0; i < 40 && expected_indices.size() < 30; ++i) {
+    if (i % 4 != 0) {
+      expected_indices.push_back(i);
+    }
+  }
+  std::vector<int64_t> expected_dimensions = {30};
+  RunTest(11, 30, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
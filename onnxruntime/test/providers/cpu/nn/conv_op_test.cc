@@ -729,5 +729,67 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// 3x3 convolutions with enough channels and a constant filter take the
+// Winograd path in the CPU provider. Compare against a direct computation.
+static void TestConvWinograd(int64_t input_channels, int64_t filter_count, int64_t height, int64_t width) {
+  const vector<int64_t> X_shape = {1, input_channels, height, width};
+  const vector<int64_t> W_shape = {filter_count, input_channels, 3, 3};
+  const vector<int64_t> B_shape = {filter_count};
+  const vector<int64_t> Y_shape = {1, filter_count, height, width};
+
+  vector<float> X(static_cast<size_t>(input_channels * height * width));
+  vector<float> W(static_cast<size_t>(filter_count * input_channels * 9));
+  vector<float> B(static_cast<size_t>(filter_count));
+
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i % 17) - 8) / 8.0f;
+  }
+  for (size_t i = 0; i < W.size(); i++) {
+    W[i] = static_cast<float>(static_cast<int>(i % 13) - 6) / 16.0f;
+  }
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i % 5) / 4.0f;
+  }
+
+  vector<float> Y(static_cast<size_t>(filter_count * height * width));
+  for (int64_t f = 0; f < filter_count; f++) {
+    for (int64_t oh = 0; oh < height; oh++) {
+      for (int64_t ow = 0; ow < width; ow++) {
+        double sum = B[f];
+        for (int64_t c = 0; c < input_channels; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < height && iw >= 0 && iw < width) {
+                sum += double(X[(c * height + ih) * width + iw]) * W[((f * input_channels + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y[(f * height + oh) * width + ow] = static_cast<float>(sum);
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", X_shape, X);
+  test.AddInput<float>("W", W_shape, W, true);
+  test.AddInput<float>("B", B_shape, B, true);
+  test.AddOutput<float>("Y", Y_shape, Y);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(ConvTest, Conv2D_Winograd) {
+  // F(2x2,3x3) for small images.
+  TestConvWinograd(32, 32, 7, 9);
+  // F(4x4,3x3) with partial edge tiles.
+  TestConvWinograd(40, 36, 14, 13);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <cmath>
 #include <type_traits>
@@ -5192,5 +5194,114 @@ TEST(ReductionOpTest, ReduceSum_RKRK_keepdims) {
   test.Run();
 }
 
+// Runs op on a {d0, d1, d2} input for every layout with a fast reduction (KR, RK, KRK, RKR) and compares with
+// post(sum(pre(x))) over the reduced values computed in double.
+template <typename FPRE, typename FPOST>
+static void TestFastReduceLayouts(const char* op, bool positive_input, FPRE pre, FPOST post) {
+  struct Case {
+    std::vector<int64_t> shape;
+    std::vector<int64_t> axes;
+  };
+  // the RK case is large enough to go through the parallel fast path
+  const std::vector<Case> cases{{{8, 4, 300}, {2}}, {{2048, 4, 8}, {0}}, {{8, 16, 4}, {1}}, {{3, 16, 5}, {0, 2}}};
+  for (const auto& c : cases) {
+    const int64_t d0 = c.shape[0], d1 = c.shape[1], d2 = c.shape[2];
+    std::vector<float> in_data(static_cast<size_t>(d0 * d1 * d2));
+    for (size_t i = 0; i < in_data.size(); ++i) {
+      in_data[i] = 0.1f + static_cast<float>(i % 13) / 13.f;
+      if (!positive_input && i % 3 == 0) {
+        in_data[i] = -in_data[i];
+      }
+    }
+
+    const bool r0 = std::find(c.axes.begin(), c.axes.end(), 0) != c.axes.end();
+    const bool r1 = std::find(c.axes.begin(), c.axes.end(), 1) != c.axes.end();
+    const bool r2 = std::find(c.axes.begin(), c.axes.end(), 2) != c.axes.end();
+    std::vector<int64_t> out_shape;
+    std::vector<float> expected;
+    for (int64_t a = 0; a < (r0 ? 1 : d0); ++a) {
+      for (int64_t b = 0; b < (r1 ? 1 : d1); ++b) {
+        for (int64_t k = 0; k < (r2 ? 1 : d2); ++k) {
+          double sum = 0;
+          for (int64_t i = r0 ? 0 : a; i < (r0 ? d0 : a + 1); ++i) {
+            for (int64_t j = r1 ? 0 : b; j < (r1 ? d1 : b + 1); ++j) {
+              for (int64_t l = r2 ? 0 : k; l < (r2 ? d2 : k + 1); ++l) {
+                sum += pre(static_cast<double>(in_data[static_cast<size_t>((i * d1 + j) * d2 + l)]));
+              }
+            }
+          }
+          expected.push_back(static_cast<float>(post(sum)));
+        }
+      }
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      if (std::find(c.axes.begin(), c.axes.end(), static_cast<int64_t>(i)) == c.axes.end()) {
+        out_shape.push_back(c.shape[i]);
+      }
+    }
+
+    OpTester test(op);
+    test.AddAttribute("axes", c.axes);
+    test.AddAttribute("keepdims", (int64_t)0);
+    test.AddInput<float>("data", c.shape, in_data);
+    test.AddOutput<float>("reduced", out_shape, expected);
+    test.SetOutputRelErr("reduced", 1e-4f);
+    test.Run();
+  }
+}
+
+TEST(ReductionOpTest, ReduceL1_FastLayouts) {
+  TestFastReduceLayouts(
+      "ReduceL1", false, [](double v) { return std::abs(v); }, [](double s) { return s; });
+}
+
+TEST(ReductionOpTest, ReduceL2_FastLayouts) {
+  TestFastReduceLayouts(
+      "ReduceL2", false, [](double v) { return v * v; }, [](double s) { return std::sqrt(s); });
+}
+
+TEST(ReductionOpTest, ReduceSumSquare_FastLayouts) {
+  TestFastReduceLayouts(
+      "ReduceSumSquare", false, [](double v) { return v * v; }, [](double s) { return s; });
+}
+
+TEST(ReductionOpTest, ReduceLogSum_FastLayouts) {
+  TestFastReduceLayouts(
+      "ReduceLogSum", true, [](double v) { return v; }, [](double s) { return std::log(s); });
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_FastLayouts) {
+  TestFastReduceLayouts(
+      "ReduceLogSumExp", false, [](double v) { return std::exp(v); }, [](double s) { return std::log(s); });
+}
+
+TEST(ReductionOpTest, ReduceLogSumExp_KR_infinite) {
+  // infinite values are skipped when looking for the maximum, as in the generic implementation
+  OpTester test("ReduceLogSumExp");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {2, 3},
+                       {-std::numeric_limits<float>::infinity(), 1.0f, 2.0f,
+                        1.0f, 1.0f, -std::numeric_limits<float>::infinity()});
+  test.AddOutput<float>("reduced", {2}, {2.31326169f, 1.69314718f});
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceSum_KR_long_rows) {
+  // few long rows, the reduced dimension is split across threads
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  std::vector<float> in_data(2 * 100000);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = static_cast<float>(i % 7);
+  test.AddInput<float>("data", {2, 100000}, in_data);
+  std::vector<float> expected(2, 0.f);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    expected[i / 100000] += in_data[i];
+  test.AddOutput<float>("reduced", {2}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
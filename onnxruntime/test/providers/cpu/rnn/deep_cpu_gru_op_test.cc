@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include <array>
+#include <cmath>
 #include <iterator>
 #include <vector>
 
@@ -1231,5 +1233,92 @@ TEST(GRUTest, ONNXRuntime_TestGRUPositiveActivationAlphaBeta) {
   ctx.RunTest(X, batch_size, seq_length, sequence_length, &initial_h, expected_Y, expected_Y_h);
 }
 
+
+// Runs a float GRU on the CPU EP with an intra-op thread pool of 4 threads and returns Y and Y_h.
+static std::vector<std::vector<float>> RunCpuGru(const std::string& direction, int64_t seq_length,
+                                                 int64_t batch_size, int64_t input_size, int64_t hidden_size,
+                                                 const std::vector<float>& X_data,
+                                                 const std::vector<float>& W_data,
+                                                 const std::vector<float>& R_data,
+                                                 const std::vector<float>& B_data,
+                                                 const std::vector<int>& sequence_lengths) {
+  OpTester test("GRU", 7, kOnnxDomain, false /*verify_output*/);
+  const int64_t num_directions = direction == "bidirectional" ? 2 : 1;
+
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+  test.AddInput<float>("W", {num_directions, 3 * hidden_size, input_size}, W_data);
+  test.AddInput<float>("R", {num_directions, 3 * hidden_size, hidden_size}, R_data);
+  test.AddInput<float>("B", {num_directions, 6 * hidden_size}, B_data);
+  test.AddInput<int>("sequence_lens", {batch_size}, sequence_lengths);
+  test.AddOptionalInputEdge<float>();
+
+  const int64_t state_size = num_directions * batch_size * hidden_size;
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size},
+                        std::vector<float>(seq_length * state_size));
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, std::vector<float>(state_size));
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+  std::vector<std::vector<float>> outputs;
+  for (const OrtValue& fetch : test.GetFetches()) {
+    auto data = fetch.Get<Tensor>().DataAsSpan<float>();
+    outputs.emplace_back(data.begin(), data.end());
+  }
+  return outputs;
+}
+
+// A bidirectional GRU must match separate forward and reverse runs, both when the directions run at the same
+// time (small steps) and one after the other (large steps).
+TEST(GRUTest, BidirectionalMatchesSeparateDirections) {
+  for (const auto& dims : std::vector<std::array<int64_t, 4>>{{3, 2, 4, 8}, {2, 8, 16, 256}}) {
+    const int64_t seq_length = dims[0], batch_size = dims[1], input_size = dims[2], hidden_size = dims[3];
+    auto make_data = [](size_t size, float seed) {
+      std::vector<float> data(size);
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = 0.5f * std::sin(seed + 0.37f * static_cast<float>(i));
+      }
+      return data;
+    };
+    const auto X = make_data(seq_length * batch_size * input_size, 0.9f);
+    const auto W = make_data(2 * 3 * hidden_size * input_size, 1.0f);
+    const auto R = make_data(2 * 3 * hidden_size * hidden_size, 1.1f);
+    const auto B = make_data(2 * 6 * hidden_size, 1.2f);
+    const std::vector<int> sequence_lengths(batch_size, static_cast<int>(seq_length));
+
+    auto bidirectional = RunCpuGru("bidirectional", seq_length, batch_size, input_size, hidden_size, X, W, R, B,
+                                   sequence_lengths);
+
+    const int64_t state_size = batch_size * hidden_size;
+    auto expect_near = [](const std::vector<float>& expected, const std::vector<float>& actual) {
+      ASSERT_EQ(expected.size(), actual.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(expected[i], actual[i], 1e-5f) << "index " << i;
+      }
+    };
+    for (size_t d = 0; d < 2; ++d) {
+      auto half = [d](const std::vector<float>& v) {
+        return std::vector<float>(v.begin() + d * v.size() / 2, v.begin() + (d + 1) * v.size() / 2);
+      };
+      auto single = RunCpuGru(d == 0 ? "forward" : "reverse", seq_length, batch_size, input_size, hidden_size, X,
+                              half(W), half(R), half(B), sequence_lengths);
+
+      std::vector<float> Y_direction;
+      for (int64_t t = 0; t < seq_length; ++t) {
+        auto step = bidirectional[0].begin() + (t * 2 + static_cast<int64_t>(d)) * state_size;
+        Y_direction.insert(Y_direction.end(), step, step + state_size);
+      }
+      expect_near(single[0], Y_direction);
+      expect_near(single[1], half(bidirectional[1]));
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
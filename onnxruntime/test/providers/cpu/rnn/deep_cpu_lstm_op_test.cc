@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 
+#include <array>
+#include <cmath>
 #include <iterator>
 #include <vector>
 
@@ -1347,6 +1349,160 @@ TEST(LSTMTest, ONNXRuntime_TestLSTMZeroSeqInMiddle) {
                   &sequence_length, use_bias, use_peepholes, 0.0f, false, false);
 }
 
+// Deterministic values in [-0.5, 0.5] for the inputs of the tests comparing two ways of computing an LSTM.
+static std::vector<float> MakeLstmTestData(size_t size, float seed) {
+  std::vector<float> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = 0.5f * std::sin(seed + 0.37f * static_cast<float>(i));
+  }
+  return data;
+}
+
+// Runs a float LSTM on the CPU EP with an intra-op thread pool of 4 threads and returns Y, Y_h and Y_c.
+static std::vector<std::vector<float>> RunCpuLstm(const std::string& direction, int64_t seq_length,
+                                                  int64_t batch_size, int64_t input_size, int64_t hidden_size,
+                                                  const std::vector<float>& X_data,
+                                                  const std::vector<float>& W_data,
+                                                  const std::vector<float>& R_data,
+                                                  const std::vector<float>& B_data,
+                                                  const std::vector<int>* sequence_lengths = nullptr,
+                                                  const std::vector<float>* P_data = nullptr) {
+  OpTester test("LSTM", 7, kOnnxDomain, false /*verify_output*/);
+  const int64_t num_directions = direction == "bidirectional" ? 2 : 1;
+
+  test.AddAttribute("direction", direction);
+  test.AddAttribute("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+  test.AddInput<float>("W", {num_directions, 4 * hidden_size, input_size}, W_data);
+  test.AddInput<float>("R", {num_directions, 4 * hidden_size, hidden_size}, R_data);
+  test.AddInput<float>("B", {num_directions, 8 * hidden_size}, B_data);
+  if (sequence_lengths) {
+    test.AddInput<int>("sequence_lens", {batch_size}, *sequence_lengths);
+  } else {
+    test.AddOptionalInputEdge<int>();
+  }
+  test.AddOptionalInputEdge<float>();
+  test.AddOptionalInputEdge<float>();
+  if (P_data) {
+    test.AddInput<float>("P", {num_directions, 3 * hidden_size}, *P_data);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+
+  const int64_t state_size = num_directions * batch_size * hidden_size;
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size},
+                        std::vector<float>(seq_length * state_size));
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, std::vector<float>(state_size));
+  test.AddOutput<float>("Y_c", {num_directions, batch_size, hidden_size}, std::vector<float>(state_size));
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+
+  std::vector<std::vector<float>> outputs;
+  for (const OrtValue& fetch : test.GetFetches()) {
+    auto data = fetch.Get<Tensor>().DataAsSpan<float>();
+    outputs.emplace_back(data.begin(), data.end());
+  }
+  return outputs;
+}
+
+static void ExpectLstmOutputsNear(const std::vector<float>& expected, const std::vector<float>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-5f) << "index " << i;
+  }
+}
+
+// The default activations without peepholes use the fused gate computation. Zero peepholes give the same result
+// through the per-gate path.
+TEST(LSTMTest, FusedGatesMatchPerGatePath) {
+  constexpr int64_t seq_length = 4, batch_size = 3, input_size = 5, hidden_size = 8;
+  const auto X = MakeLstmTestData(seq_length * batch_size * input_size, 0.1f);
+  const auto W = MakeLstmTestData(4 * hidden_size * input_size, 0.2f);
+  const auto R = MakeLstmTestData(4 * hidden_size * hidden_size, 0.3f);
+  const auto B = MakeLstmTestData(8 * hidden_size, 0.4f);
+  const std::vector<float> P(3 * hidden_size, 0.0f);
+
+  auto fused = RunCpuLstm("forward", seq_length, batch_size, input_size, hidden_size, X, W, R, B);
+  auto per_gate = RunCpuLstm("forward", seq_length, batch_size, input_size, hidden_size, X, W, R, B, nullptr, &P);
+  for (size_t i = 0; i < fused.size(); ++i) {
+    ExpectLstmOutputsNear(per_gate[i], fused[i]);
+  }
+}
+
+// With enough rows the batch is split into groups that each stop at their own longest sequence. Every row must
+// match an LSTM run on that row alone.
+TEST(LSTMTest, BatchGroupsStopAtTheirLongestSequence) {
+  constexpr int64_t seq_length = 5, batch_size = 8, input_size = 3, hidden_size = 6;
+  const std::vector<int> sequence_lengths{5, 1, 3, 0, 2, 2, 4, 1};
+  const auto X = MakeLstmTestData(seq_length * batch_size * input_size, 0.5f);
+  const auto W = MakeLstmTestData(4 * hidden_size * input_size, 0.6f);
+  const auto R = MakeLstmTestData(4 * hidden_size * hidden_size, 0.7f);
+  const auto B = MakeLstmTestData(8 * hidden_size, 0.8f);
+
+  auto batched = RunCpuLstm("forward", seq_length, batch_size, input_size, hidden_size, X, W, R, B,
+                            &sequence_lengths);
+
+  for (int64_t b = 0; b < batch_size; ++b) {
+    std::vector<float> X_row;
+    for (int64_t t = 0; t < seq_length; ++t) {
+      auto row = X.begin() + (t * batch_size + b) * input_size;
+      X_row.insert(X_row.end(), row, row + input_size);
+    }
+    const std::vector<int> row_length{sequence_lengths[b]};
+    auto single = RunCpuLstm("forward", seq_length, 1, input_size, hidden_size, X_row, W, R, B, &row_length);
+
+    std::vector<float> Y_row;
+    for (int64_t t = 0; t < seq_length; ++t) {
+      auto row = batched[0].begin() + (t * batch_size + b) * hidden_size;
+      Y_row.insert(Y_row.end(), row, row + hidden_size);
+    }
+    ExpectLstmOutputsNear(single[0], Y_row);
+    for (size_t i = 1; i < 3; ++i) {
+      auto row = batched[i].begin() + b * hidden_size;
+      ExpectLstmOutputsNear(single[i], std::vector<float>(row, row + hidden_size));
+    }
+  }
+}
+
+// A bidirectional LSTM must match separate forward and reverse runs, both when the directions run at the same
+// time (small steps) and one after the other (large steps).
+TEST(LSTMTest, BidirectionalMatchesSeparateDirections) {
+  for (const auto& dims : std::vector<std::array<int64_t, 4>>{{3, 2, 4, 8}, {2, 8, 16, 256}}) {
+    const int64_t seq_length = dims[0], batch_size = dims[1], input_size = dims[2], hidden_size = dims[3];
+    const auto X = MakeLstmTestData(seq_length * batch_size * input_size, 0.9f);
+    const auto W = MakeLstmTestData(2 * 4 * hidden_size * input_size, 1.0f);
+    const auto R = MakeLstmTestData(2 * 4 * hidden_size * hidden_size, 1.1f);
+    const auto B = MakeLstmTestData(2 * 8 * hidden_size, 1.2f);
+    const std::vector<int> sequence_lengths(batch_size, static_cast<int>(seq_length));
+
+    auto bidirectional = RunCpuLstm("bidirectional", seq_length, batch_size, input_size, hidden_size, X, W, R, B,
+                                    &sequence_lengths);
+
+    const int64_t state_size = batch_size * hidden_size;
+    for (size_t d = 0; d < 2; ++d) {
+      auto half = [d](const std::vector<float>& v) {
+        return std::vector<float>(v.begin() + d * v.size() / 2, v.begin() + (d + 1) * v.size() / 2);
+      };
+      auto single = RunCpuLstm(d == 0 ? "forward" : "reverse", seq_length, batch_size, input_size, hidden_size, X,
+                               half(W), half(R), half(B), &sequence_lengths);
+
+      std::vector<float> Y_direction;
+      for (int64_t t = 0; t < seq_length; ++t) {
+        auto step = bidirectional[0].begin() + (t * 2 + static_cast<int64_t>(d)) * state_size;
+        Y_direction.insert(Y_direction.end(), step, step + state_size);
+      }
+      ExpectLstmOutputsNear(single[0], Y_direction);
+      ExpectLstmOutputsNear(single[1], half(bidirectional[1]));
+      ExpectLstmOutputsNear(single[2], half(bidirectional[2]));
+    }
+  }
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(LSTMTest, SharedPrepackedWeights) {
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
@@ -1441,6 +1443,85 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   test.AddOutput<float>("Y", {N, C, sizes[2], sizes[3]}, Y);
   test.Run();
 }
+
+// Large enough for the rows of all the images and channels to be split across the threads.
+// The expected output is computed tap by tap for every output pixel, like the serial implementation did, from input
+// that differs per image and channel, so wrong tap weights or rows mixed across planes change the result.
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannelRowsSplit) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{};
+  std::vector<int64_t> sizes{2, 3, 37, 29};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("exclude_outside", static_cast<int64_t>(1));
+
+  constexpr int64_t N = 2, C = 3, H = 16, W = 12;
+  const int64_t output_height = sizes[2], output_width = sizes[3];
+  std::vector<float> X(N * C * H * W);
+  for (int64_t plane = 0; plane < N * C; ++plane) {
+    for (int64_t i = 0; i < H * W; ++i) {
+      X[plane * H * W + i] = static_cast<float>(((plane + 1) * (i / W * 5 + i % W * 3)) % 17) - 8.0f;
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("", {0}, scales);
+  test.AddInput<int64_t>("sizes", {4}, sizes);
+
+  // taps and weights of one axis for half_pixel coordinates, cubic_coeff_a = -0.75 and exclude_outside = 1.
+  auto get_taps = [](int64_t input_size, int64_t output_size, std::vector<int64_t>& index, std::vector<float>& weight) {
+    constexpr float a = -0.75f;
+    const float scale = static_cast<float>(output_size) / static_cast<float>(input_size);
+    for (int64_t o = 0; o < output_size; ++o) {
+      const float in = (static_cast<float>(o) + 0.5f) / scale - 0.5f;
+      const int64_t in_int = static_cast<int64_t>(std::floor(in));
+      const float s = std::abs(in - static_cast<float>(in_int));
+      float coeffs[4] = {((a * (s + 1) - 5 * a) * (s + 1) + 8 * a) * (s + 1) - 4 * a,
+                         ((a + 2) * s - (a + 3)) * s * s + 1,
+                         ((a + 2) * (1 - s) - (a + 3)) * (1 - s) * (1 - s) + 1,
+                         ((a * (2 - s) - 5 * a) * (2 - s) + 8 * a) * (2 - s) - 4 * a};
+      float coeff_sum = 0;
+      for (int64_t i = 0; i < 4; ++i) {
+        const int64_t val = in_int - 1 + i;
+        if (val < 0 || val >= input_size) {
+          coeffs[i] = 0;
+        }
+        coeff_sum += coeffs[i];
+      }
+      for (int64_t i = 0; i < 4; ++i) {
+        index.push_back(std::max<int64_t>(0, std::min(in_int - 1 + i, input_size - 1)));
+        weight.push_back(coeffs[i] / coeff_sum);
+      }
+    }
+  };
+
+  std::vector<int64_t> y_index, x_index;
+  std::vector<float> y_weight, x_weight;
+  get_taps(H, output_height, y_index, y_weight);
+  get_taps(W, output_width, x_index, x_weight);
+
+  std::vector<float> Y(N * C * output_height * output_width);
+  for (int64_t plane = 0; plane < N * C; ++plane) {
+    for (int64_t y = 0; y < output_height; ++y) {
+      for (int64_t x = 0; x < output_width; ++x) {
+        float result = 0;
+        for (int64_t i = 0; i < 4; ++i) {
+          for (int64_t j = 0; j < 4; ++j) {
+            result += y_weight[y * 4 + i] * x_weight[x * 4 + j] *
+                      X[(plane * H + y_index[y * 4 + i]) * W + x_index[x * 4 + j]];
+          }
+        }
+        Y[(plane * output_height + y) * output_width + x] = result;
+      }
+    }
+  }
+
+  test.AddOutput<float>("Y", {N, C, output_height, output_width}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_tf_half_pixel_for_nn) {
   // tf_half_pixel_for_nn has been deprecated since opset 13
   OpTester test("Resize", 12);
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -180,5 +182,65 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+// duplicate indices with a reduction must accumulate every update, also when the updates are large enough to be
+// split across threads.
+TEST(ScatterNDOpTest, ScatterND_reduction_add_duplicate_indices_large_slices) {
+  constexpr int64_t rows = 3;
+  constexpr int64_t cols = 20000;
+  const std::vector<int64_t> indices{0, 2, 0, 0, 2};
+  const int64_t num_updates = static_cast<int64_t>(indices.size());
+
+  std::vector<float> data(rows * cols, 1.0f);
+  std::vector<float> updates(num_updates * cols);
+  std::vector<float> output(data);
+  for (int64_t u = 0; u < num_updates; ++u) {
+    for (int64_t c = 0; c < cols; ++c) {
+      updates[u * cols + c] = static_cast<float>((u + 1) * (c % 7));
+      output[indices[u] * cols + c] += updates[u * cols + c];
+    }
+  }
+
+  OpTester test("ScatterND", 16);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<float>("updates", {num_updates, cols}, updates);
+  test.AddOutput<float>("output", {rows, cols}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// scalar updates with a reduction are split across threads by output element. duplicates must still see every update.
+TEST(ScatterNDOpTest, ScatterND_reduction_duplicate_indices_scalar_updates) {
+  constexpr int64_t size = 1000;
+  constexpr int64_t num_updates = 40000;
+
+  std::vector<float> data(size);
+  std::vector<int64_t> indices(num_updates);
+  std::vector<float> updates(num_updates);
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>(i % 13);
+  }
+  for (int64_t u = 0; u < num_updates; ++u) {
+    indices[u] = (u * 7919) % size;
+    updates[u] = static_cast<float>(u % 29);
+  }
+
+  for (const std::string reduction : {"add", "max"}) {
+    std::vector<float> output(data);
+    for (int64_t u = 0; u < num_updates; ++u) {
+      float& value = output[indices[u]];
+      value = reduction == "add" ? value + updates[u] : std::max(value, updates[u]);
+    }
+
+    OpTester test("ScatterND", 18);
+    test.AddAttribute<std::string>("reduction", reduction);
+    test.AddInput<float>("data", {size}, data);
+    test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+    test.AddInput<float>("updates", {num_updates}, updates);
+    test.AddOutput<float>("output", {size}, output);
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime